@@ -0,0 +1,149 @@
+/*
+ * This file is part of the Chiller project.
+ * Copyright 2019 Edward V. Emelianov <edward.emelianoff@gmail.com>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Flow sensor (PB1 - TIM3_CH4) measurement.
+ * TIM3 runs at 1MHz, its overflows extend timestamps to 32 bits.
+ * Low rates: each falling edge is captured and its period measured.
+ * High rates: input capture prescaler counts 8 pulses per capture event,
+ * so we get a gated count of 8 pulses and 8 times less interrupts.
+ * Per-pulse periods are averaged in moving window of FLOW_WINDOW values.
+ */
+
+#include "flow.h"
+
+static volatile uint16_t ovrflows = 0;          // high half of timestamp
+static volatile uint32_t periods[FLOW_WINDOW];  // per-pulse periods, us
+static volatile uint32_t persum = 0;            // sum of `periods`
+static volatile uint8_t pernum = 0;             // amount of valid `periods`
+static uint8_t peridx = 0;                      // current index in `periods`
+static volatile uint32_t lastcapt = 0;          // last capture timestamp
+static volatile uint8_t havelast = 0;           // `lastcapt` may be used as period start
+static volatile uint8_t pscshift = 0;           // log2(pulses per capture)
+
+// clear all measurements
+static void flow_reset(){
+    for(int i = 0; i < FLOW_WINDOW; ++i) periods[i] = 0;
+    persum = 0;
+    pernum = 0;
+    peridx = 0;
+    havelast = 0;
+}
+
+// change capture prescaler: 0 - each pulse, 3 - each 8th pulse
+static void setpsc(uint8_t shift){
+    pscshift = shift;
+    if(shift) TIM3->CCMR2 |= TIM_CCMR2_IC4PSC;
+    else TIM3->CCMR2 &= ~TIM_CCMR2_IC4PSC;
+    havelast = 0; // internal prescaler counter isn't cleared, so skip next capture
+}
+
+// 32-bit timestamp; should be called with interrupts disabled
+static uint32_t timestamp(){
+    uint16_t cnt = TIM3->CNT, hi = ovrflows;
+    if((TIM3->SR & TIM_SR_UIF) && cnt < 0x8000) ++hi; // overflow isn't processed yet
+    return ((uint32_t)hi << 16) | cnt;
+}
+
+/**
+ * @brief flow_setup - setup TIM3 for flow sensor input capture
+ * PB1 should be configured as AF1
+ */
+void flow_setup(){
+    RCC->APB1ENR |= RCC_APB1ENR_TIM3EN;
+    TIM3->PSC = FLOW_TIM_PSC;
+    TIM3->ARR = 0xffff;
+    // CC4 is input mapped on TI4, filter: fCK_INT, N=8
+    TIM3->CCMR2 = TIM_CCMR2_CC4S_0 | TIM_CCMR2_IC4F_0 | TIM_CCMR2_IC4F_1;
+    // falling edge
+    TIM3->CCER = TIM_CCER_CC4P | TIM_CCER_CC4E;
+    TIM3->DIER = TIM_DIER_CC4IE | TIM_DIER_UIE;
+    flow_reset();
+    TIM3->CR1 |= TIM_CR1_CEN;
+    NVIC_EnableIRQ(TIM3_IRQn);
+    NVIC_SetPriority(TIM3_IRQn, 3);
+}
+
+/**
+ * @brief flow_period - mean period of pulses
+ * @return period (us) or 0 if there's no data
+ */
+uint32_t flow_period(){
+    uint32_t sum, n;
+    __disable_irq();
+    sum = persum;
+    n = pernum;
+    __enable_irq();
+    if(!n) return 0;
+    return sum / n;
+}
+
+/**
+ * @brief flow_getrate - calculate current flow rate
+ * Until next pulse comes, its period can't be less than time passed since
+ * previous capture, so rate falls down in one pulse period when flow stops.
+ * @return flow rate in ml/min
+ */
+uint32_t flow_getrate(){
+    uint32_t sum, n, last, now;
+    uint8_t shift;
+    __disable_irq();
+    sum = persum;
+    n = pernum;
+    last = lastcapt;
+    shift = pscshift;
+    now = timestamp();
+    __enable_irq();
+    if(!n || !sum) return 0;
+    uint32_t elapsed = (now - last) >> shift;
+    if(elapsed > sum / n) return FLOW_K / elapsed;
+    return FLOW_K * n / sum;
+}
+
+// process new capture event
+static void capture(uint32_t ts){
+    if(havelast){
+        uint32_t T = (ts - lastcapt) >> pscshift;
+        persum += T - periods[peridx];
+        periods[peridx] = T;
+        peridx = (peridx + 1) & (FLOW_WINDOW - 1);
+        if(pernum < FLOW_WINDOW) ++pernum;
+        if(pscshift == 0 && T < FLOW_FAST_PERIOD) setpsc(3);
+        else if(pscshift && T > FLOW_SLOW_PERIOD) setpsc(0);
+    }else havelast = 1;
+    lastcapt = ts;
+}
+
+void tim3_isr(){
+    uint32_t sr = TIM3->SR;
+    uint16_t hi = ovrflows;
+    if(sr & TIM_SR_CC4IF){
+        uint16_t ccr = TIM3->CCR4; // reading clears CC4IF
+        // overflow occured before capture and isn't processed yet
+        if((sr & TIM_SR_UIF) && ccr < 0x8000) ++hi;
+        capture(((uint32_t)hi << 16) | ccr);
+    }
+    if(sr & TIM_SR_UIF){
+        TIM3->SR = ~TIM_SR_UIF;
+        ++ovrflows;
+        if(pernum && (timestamp() - lastcapt) > FLOW_TIMEOUT){ // flow stopped
+            flow_reset();
+            if(pscshift) setpsc(0);
+        }
+    }
+}
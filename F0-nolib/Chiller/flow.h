@@ -0,0 +1,42 @@
+/*
+ * This file is part of the Chiller project.
+ * Copyright 2019 Edward V. Emelianov <edward.emelianoff@gmail.com>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef FLOW_H__
+#define FLOW_H__
+#include "stm32f0.h"
+
+// flow sensor pulses per liter
+#define FLOW_PULSES_PER_L   (5880)
+// TIM3 tick: 1us
+#define FLOW_TIM_PSC        (47)
+// moving average window length (pulse periods), should be power of 2
+#define FLOW_WINDOW         (8)
+// capture each 8th pulse if pulse period less than this (us)
+#define FLOW_FAST_PERIOD    (2000)
+// capture each pulse if pulse period greater than this (us)
+#define FLOW_SLOW_PERIOD    (4000)
+// forget all measurements if there was no pulses for this time (us)
+#define FLOW_TIMEOUT        (2000000)
+// (ml/min)*us: rate = FLOW_K / period
+#define FLOW_K              ((uint32_t)(60000000000ULL / FLOW_PULSES_PER_L))
+
+void flow_setup();
+uint32_t flow_getrate();
+uint32_t flow_period();
+
+#endif // FLOW_H__
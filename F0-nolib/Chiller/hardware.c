@@ -18,6 +18,7 @@
 #include "hardware.h"
 #include "usart.h"
 #include "adc.h"
+#include "flow.h"
 
 static inline void iwdg_setup(){
     /* Enable the peripheral clock RTC */
@@ -104,6 +105,7 @@ static inline void adc_setup(){
  *      PA14 - open drain       - IN2 of TLE5205
  *      PF0  - floating input   - water level alert
  *      PF1  - push-pull        - external alarm
+ *      PB1  - TIM3_CH4         - flow sensor
  *      PA0..PA3 - ADC_IN0..3
  *      PA4, PA6, PA7 - PWM outputs
  * Registers
@@ -126,34 +128,24 @@ static inline void gpio_setup(){
             GPIO_MODER_MODER7_AF |
             GPIO_MODER_MODER0_AI | GPIO_MODER_MODER1_AI |
             GPIO_MODER_MODER2_AI | GPIO_MODER_MODER3_AI;
-    RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN; // enable syscfg clock for EXTI
     GPIOA->OTYPER = 3 << 13; // 13/14 opendrain
     GPIOF->MODER = GPIO_MODER_MODER1_O;
-    // PB1 - interrupt input
-    /* (2) Select Port B for pin 1 external interrupt by writing 0001 in EXTI1*/
-    /* (3) Configure the corresponding mask bit in the EXTI_IMR register */
-    /* (4) Configure the Trigger Selection bits of the Interrupt line on rising edge*/
-    /* (5) Configure the Trigger Selection bits of the Interrupt line on falling edge*/
-    SYSCFG->EXTICR[0] = SYSCFG_EXTICR1_EXTI1_PB; /* (2) */
-    EXTI->IMR = EXTI_IMR_MR1; /* (3) */
-    //EXTI->RTSR = 0x0000; /* (4) */
-    EXTI->FTSR = EXTI_FTSR_TR1; /* (5) */
-    /* (6) Enable Interrupt on EXTI0_1 */
-    /* (7) Set priority for EXTI0_1 */
-    NVIC_EnableIRQ(EXTI0_1_IRQn); /* (6) */
-    NVIC_SetPriority(EXTI0_1_IRQn, 3); /* (7) */
+    // PB1 - flow sensor input capture
+    GPIOB->MODER = GPIO_MODER_MODER1_AF;
     // alternate functions:
     // PA4 - TIM14_CH1 (AF4)
     // PA6 - TIM16_CH1 (AF5), PA7 - TIM17_CH1 (AF5)
+    // PB1 - TIM3_CH4 (AF1)
     GPIOA->AFR[0] = (GPIOA->AFR[0] &~ (GPIO_AFRL_AFRL4 | GPIO_AFRL_AFRL6 | GPIO_AFRL_AFRL7)) \
                 | (4 << (4 * 4)) | (5 << (6 * 4)) | (5 << (7 * 4));
+    GPIOB->AFR[0] = (GPIOB->AFR[0] &~ GPIO_AFRL_AFRL1) | (1 << (1 * 4));
 }
 
 static inline void timers_setup(){
     // timer 14 ch1 - cooler PWM
     // timer 16 ch1 - heater PWM
     // timer 17 ch1 - pump PWM
-    RCC->APB1ENR |= RCC_APB1ENR_TIM3EN | RCC_APB1ENR_TIM14EN; // enable clocking for timers 3 and 14
+    RCC->APB1ENR |= RCC_APB1ENR_TIM14EN; // enable clocking for timer 14 (TIM3 is flow sensor)
     RCC->APB2ENR |= RCC_APB2ENR_TIM16EN | RCC_APB2ENR_TIM17EN; // & timers 16/17
     // PWM mode 1 (active -> inactive)
     TIM14->CCMR1 = TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1M_1;
@@ -188,16 +180,7 @@ void hw_setup(){
     gpio_setup();
     adc_setup();
     timers_setup();
+    flow_setup();
     USART1_config();
     iwdg_setup();
 }
-
-/*
- * Flow sensor counter
- */
-void exti0_1_isr(){
-    if (EXTI->PR & EXTI_PR_PR1){
-        EXTI->PR |= EXTI_PR_PR1; /* Clear the pending bit */
-        ++flow_cntr;
-    }
-}
@@ -20,10 +20,8 @@
 #define HARDWARE_H
 #include "stm32f0.h"
 
-// measure flow sensor data each 1 second
-#define FLOW_RATE_MS        (999)
-// previous as string constant
-#define FLOWRATESTR         "1"
+// send critical error message each 1 second
+#define CRITMSG_MS          (999)
 
 // each TMEASURE_MS ms calculate temperatures & check them
 #define TMEASURE_MS         (1000)
@@ -50,13 +48,15 @@
 /*
                 other limits & tolerances
 */
-// minimal flow rate - 0.2l per minute
-#define MIN_FLOW_RATE       (20)
+// minimal flow rate - 0.2l per minute (in ml/min)
+#define MIN_FLOW_RATE       (200)
 // normal flow rate
-#define NORMAL_FLOW_RATE    (30)
+#define NORMAL_FLOW_RATE    (300)
 // minimal PWM values when motors should work
 #define MIN_PUMP_PWM        (90)
 #define MIN_COOLER_PWM      (90)
+// no flow checking after pump start for this time (ms), should be longer than FLOW_TIMEOUT
+#define PUMP_SPINUP_MS      (3000)
 
 // PWM setters and getters
 #define SET_COOLER_PWM(N)   do{TIM14->CCR1 = (uint32_t)N;}while(0)
@@ -71,7 +71,6 @@
 #define ALARM_OFF()         pin_clear(GPIOF, 2)
 #define ALARM_STATE()       pin_read(GPIOF, 2)
 
-extern volatile uint16_t flow_rate, flow_cntr;
 extern volatile uint32_t Tms;
 
 void hw_setup(void);
@@ -27,8 +27,6 @@
 #include "mainloop.h"
 
 volatile uint32_t Tms = 0;
-volatile uint16_t flow_rate = 0; // flow sensor rate
-volatile uint16_t flow_cntr = 0; // flow sensor trigger counter
 // this variable is global as user need to clear it in protocol.c
 uint8_t crit_error = 0; // got critical error, need user acknowledgement
 
@@ -54,7 +52,7 @@ static void print_state(uint8_t state){
 }
 
 int main(void){
-    uint32_t lastTflow = 0; // last flow measurement time
+    uint32_t lastTcrit = 0; // last critical message time
     chiller_state ost = {ST_OK, ST_OK, ST_OK, ST_OK}, *st; // old & current chiller states
     char *txt;
     hw_setup();
@@ -69,10 +67,8 @@ int main(void){
     RCC->CSR |= RCC_CSR_RMVF; // remove reset flags
     while (1){
         IWDG->KR = IWDG_REFRESH;
-        if(Tms - lastTflow > FLOW_RATE_MS){ // onse per one second check flow sensor counter
-            lastTflow = Tms;
-            flow_rate = flow_cntr;
-            flow_cntr = 0;
+        if(Tms - lastTcrit > CRITMSG_MS){ // once per one second remind about critical error
+            lastTcrit = Tms;
             if(crit_error) SEND("CRITICAL=1\n");
         }
         if(usart1_getline(&txt)){ // usart1 received command, process it
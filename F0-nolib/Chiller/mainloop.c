@@ -19,6 +19,7 @@
 #include "mainloop.h"
 #include "hardware.h"
 #include "adc.h"
+#include "flow.h"
 
 int16_t Tset = 200; // temperature setpoint
 int16_t NTCval[4] = {0,};
@@ -120,6 +121,27 @@ static void change_cooler_pwm(uint8_t dir){
     }
 }
 
+/**
+ * @brief pump_spinning - check whether pump was just turned on
+ * there's no flow pulses yet while pump spins up, so flow rate is checked only
+ * PUMP_SPINUP_MS after pump start
+ * @return 1 if pump is off or spinning up
+ */
+static uint8_t pump_spinning(){
+    static uint8_t pumpon = 0;
+    static uint32_t pumpstart = 0;
+    if(GET_PUMP_PWM() < MIN_PUMP_PWM){
+        pumpon = 0;
+        return 1;
+    }
+    if(!pumpon){
+        pumpon = 1;
+        pumpstart = Tms;
+    }
+    if(Tms - pumpstart < PUMP_SPINUP_MS) return 1;
+    return 0;
+}
+
 /**
  * @brief get_critical - check device for critical errors
  * @return 1 if critical error occured
@@ -173,7 +195,7 @@ static inline uint8_t get_critical(){
     }
     // check flow rate & pump working
     if(GET_PUMP_PWM() >= MIN_PUMP_PWM){ // pump working
-        if(flow_rate < MIN_FLOW_RATE){ // check pump
+        if(!pump_spinning() && flow_getrate() < MIN_FLOW_RATE){ // check pump
             // change chiller state to CRIT_NOFLOW
             retstatus.common_state = ST_CRITICAL|ST_OK;
             // increase pump speed
@@ -217,13 +239,29 @@ static inline void check_alarm(){
             }
         }
         if(chiller_error & CE_NOFLOW){ // clear CE_NOFLOW if there's flow pulses
-            if(flow_rate > NORMAL_FLOW_RATE){
+            if(flow_getrate() > NORMAL_FLOW_RATE){
                 chiller_error &= ~CE_NOFLOW;
             }
         }
     }
 }
 
+/**
+ * @brief chk_noflow - fast flow check on each mainloop call
+ * flow rate falls below MIN_FLOW_RATE in one pulse period after pump stops,
+ * so there's no need to wait for next temperature measurement
+ * @return 1 if flow just stopped
+ */
+static inline uint8_t chk_noflow(){
+    if(chiller_error & CE_NOFLOW) return 0; // already detected
+    if(pump_spinning()) return 0; // pump is off (get_critical() will turn it on) or just started
+    if(flow_getrate() >= MIN_FLOW_RATE) return 0;
+    retstatus.common_state = ST_CRITICAL|ST_OK;
+    retstatus.pump_state = ST_CRITICAL;
+    chiller_error |= CE_NOFLOW;
+    return 1;
+}
+
 static inline void checkOutT(){
     // check that T is between limits
     int8_t hc = 0; // need heating or cooling?
@@ -281,6 +319,11 @@ chiller_state *mainloop(){
     retstatus.heater_state = ST_OK;
     retstatus.cooler_state = ST_OK;
     retstatus.pump_state   = ST_OK;
+    // 0. Check flow sensor
+    if(chk_noflow()){
+        ALARM_ON();
+        return &retstatus;
+    }
     // 1. Get temperatures and check critical situations
     if(Tms - lastTmeas < TMEASURE_MS) return &retstatus;
     lastTmeas = Tms;
@@ -20,6 +20,7 @@
 #include "usart.h"
 #include "adc.h"
 #include "mainloop.h"
+#include "flow.h"
 
 extern uint8_t crit_error;
 
@@ -48,10 +49,10 @@ static void debugging_proc(const char *command){
             usart1_sendbuf();
         break;
         case 'F':
-            put_string("PB_IDR, flow_cntr: ");
+            put_string("PB_IDR, flow period (us): ");
             put_uint(GPIOB->IDR);
             put_string(", ");
-            put_uint(flow_cntr);
+            put_uint(flow_period());
             usart1_sendbuf();
         break;
         case 'T': // all raw T values
@@ -98,7 +99,7 @@ char *process_command(const char *command){
                 "Ax - alarm on(1)/off(0)\n"
                 "Cx - cooler PWM\n"
                 "CLR- clear critical error\n"
-                "F  - get flow sensor rate for " FLOWRATESTR "s (5880 pulses per liter)\n"
+                "F  - get flow rate (ml/min, 5880 pulses per liter)\n"
                 "Hx - heater PWM\n"
                 "L  - check water level\n"
                 "Px - pump PWM\n"
@@ -111,7 +112,7 @@ char *process_command(const char *command){
 #ifdef EBUG
             SEND_BLK("d -> goto debug:\n"
                  "\tAx - get raw ADCx value\n"
-                 "\tF - get flow_cntr\n"
+                 "\tF - get flow sensor pulses period\n"
                  "\tT - show raw T values\n"
                  "\tw - test watchdog"
                  );
@@ -136,7 +137,7 @@ char *process_command(const char *command){
         break;
         case 'F':
             put_string("FLOWRATE=");
-            put_uint(flow_rate);
+            put_uint(flow_getrate());
         break;
         case 'H': // heater PWM - TIM16CH1
             if(getnum(ptr, &N) && N > -1 && N < 256){
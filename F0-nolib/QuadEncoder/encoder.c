@@ -0,0 +1,135 @@
+/*
+ * This file is part of the QuadEncoder project.
+ * Copyright 2019 Edward V. Emelianov <edward.emelianoff@gmail.com>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * TIM3 counts in encoder mode over full 16-bit range; each millisecond
+ * signed difference of CNT is added to 32-bit position (quad.c), so it can't
+ * be lost until speed is less than 32767 counts per ms.
+ * At low speed edges of A & B (EXTI6/7 on the same pins) are timestamped with
+ * microsecond resolution (Tms + SysTick) for period measurement; at high speed
+ * EXTI is masked and velocity is measured by counts difference.
+ * Index pulse (TIM3_CH4) latches CNT by capture.
+ */
+
+#include "encoder.h"
+#include "hardware.h"
+
+// EXTI lines of encoder inputs PA6/PA7
+#define EDGE_LINES      (EXTI_IMR_MR6 | EXTI_IMR_MR7)
+// SysTick ticks per microsecond (HCLK/8)
+#define TICKS_PER_US    (6)
+
+volatile uint8_t index_latched = 0; // new index position latched
+
+static quadenc enc;
+static volatile int32_t idxpos = 0;     // position latched by index pulse
+
+// microseconds from start; interrupts should be disabled
+static uint32_t micros(){
+    uint32_t ms = Tms, val = SysTick->VAL;
+    if(SCB->ICSR & SCB_ICSR_PENDSTSET_Msk){ // SysTick reloaded, but Tms wasn't incremented yet
+        val = SysTick->VAL;
+        ++ms;
+    }
+    return ms * 1000 + (SysTick->LOAD - val) / TICKS_PER_US;
+}
+
+// switch edges timestamping on/off
+static void edges_on(uint8_t on){
+    if(on){
+        if(EXTI->IMR & EDGE_LINES) return;
+        EXTI->PR = EDGE_LINES;
+        EXTI->IMR |= EDGE_LINES;
+    }else EXTI->IMR &= ~EDGE_LINES;
+}
+
+/**
+ * @brief encoder_setup - initial state (after TIM3 setup)
+ */
+void encoder_setup(){
+    __disable_irq();
+    quad_init(&enc, TIM3->CNT, Tms, micros());
+    edges_on(1);
+    __enable_irq();
+}
+
+/**
+ * @brief encoder_tick - update position & velocity, should be called each 1ms
+ */
+void encoder_tick(){
+    __disable_irq();
+    edges_on(!quad_tick(&enc, TIM3->CNT, Tms, micros()));
+    __enable_irq();
+}
+
+/**
+ * @brief encoder_get - get current position & velocity
+ * @param s (o) - sample
+ */
+void encoder_get(enc_sample *s){
+    __disable_irq();
+    s->pos = quad_update(&enc, TIM3->CNT);
+    s->vel = enc.vel;
+    s->T = Tms;
+    __enable_irq();
+}
+
+/**
+ * @brief encoder_index - get position latched by last index pulse
+ */
+int32_t encoder_index(){
+    index_latched = 0;
+    return idxpos;
+}
+
+/**
+ * @brief encoder_zero - set current position as zero
+ */
+void encoder_zero(){
+    __disable_irq();
+    quad_update(&enc, TIM3->CNT);
+    idxpos -= quad_zero(&enc);
+    __enable_irq();
+}
+
+/*
+ * Index pulse capture
+ */
+void tim3_isr(){
+    if(TIM3->SR & TIM_SR_CC4IF){
+        uint16_t ccr = TIM3->CCR4; // clears CC4IF
+        __disable_irq();
+        quad_update(&enc, TIM3->CNT);
+        idxpos = enc.pos - (int16_t)(enc.lastcnt - ccr);
+        __enable_irq();
+        index_latched = 1;
+    }
+    TIM3->SR = 0;
+}
+
+/*
+ * A/B edges (low speed only)
+ */
+void exti4_15_isr(){
+    uint32_t us;
+    __disable_irq();
+    us = micros();
+    EXTI->PR = EDGE_LINES;
+    if(quad_edge(&enc, TIM3->CNT, us)) edges_on(0);
+    __enable_irq();
+}
@@ -0,0 +1,43 @@
+/*
+ * This file is part of the QuadEncoder project.
+ * Copyright 2019 Edward V. Emelianov <edward.emelianoff@gmail.com>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef ENCODER_H__
+#define ENCODER_H__
+#include "stm32f0.h"
+#include "quad.h"
+
+// counts (quarters of pulses) per revolution
+#define ENC_CPR             (80)
+// max stream period (ms)
+#define ENC_MAX_STREAM      (60000)
+
+typedef struct{
+    int32_t pos;    // extended position, counts
+    int32_t vel;    // velocity, 1e-3 counts per second
+    uint32_t T;     // timestamp, ms
+} enc_sample;
+
+extern volatile uint8_t index_latched;
+
+void encoder_setup();
+void encoder_tick();
+void encoder_get(enc_sample *s);
+int32_t encoder_index();
+void encoder_zero();
+
+#endif // ENCODER_H__
@@ -18,13 +18,12 @@
 #include "hardware.h"
 #include "usart.h"
 
-volatile uint8_t tim3upd = 0;
-
 /**
  * @brief gpio_setup - setup GPIOs for external IO
  * GPIO pinout:
  *      PA4 - open drain        - onboard LED (always ON when board works)
  *      PA6, PA7 - TIM3_CH1/CH2 - encoder input
+ *      PB1 - TIM3_CH4          - index pulse input
  */
 static inline void gpio_setup(){
     // Enable clocks to the GPIO subsystems
@@ -32,10 +31,12 @@ static inline void gpio_setup(){
     // PA6/7 - AF; PB1 - AF
     GPIOA->MODER = GPIO_MODER_MODER4_O | GPIO_MODER_MODER6_AF | GPIO_MODER_MODER7_AF;
     GPIOA->OTYPER = GPIO_OTYPER_OT_4;
+    GPIOB->MODER = GPIO_MODER_MODER1_AF;
     // alternate functions:
-    // PA6 - TIM3_CH1, PA7 - TIM3_CH2
+    // PA6 - TIM3_CH1, PA7 - TIM3_CH2, PB1 - TIM3_CH4
     GPIOA->AFR[0] = (GPIOA->AFR[0] &~ (GPIO_AFRL_AFRL6 | GPIO_AFRL_AFRL7)) \
                 | (1 << (6 * 4)) | (1 << (7 * 4));
+    GPIOB->AFR[0] = (GPIOB->AFR[0] &~ GPIO_AFRL_AFRL1) | (1 << (1 * 4));
 }
 
 static inline void timers_setup(){
@@ -49,13 +50,22 @@ static inline void timers_setup(){
     TIM3->CCMR1 = TIM_CCMR1_CC1S_0 | TIM_CCMR1_CC2S_0; /* (1)*/
     //TIMx->CCER &= (uint16_t)(~(TIM_CCER_CC21 | TIM_CCER_CC2P); /* (2) */
     TIM3->SMCR =  TIM_SMCR_ETF_3 | TIM_SMCR_SMS_0 | TIM_SMCR_SMS_1; /* (3) */
-    // enable update interrupt
-    TIM3->DIER = TIM_DIER_UIE;
-    // set ARR to 79 - generate interrupt each 80 counts (one revolution)
-    TIM3->ARR = 79;
+    // full 16-bit range, position extends to 32 bits in encoder_tick()
+    TIM3->ARR = 0xffff;
+    // CC4 - index pulse: input on TI4, rising edge, filter fCK_INT N=8
+    TIM3->CCMR2 = TIM_CCMR2_CC4S_0 | TIM_CCMR2_IC4F_0 | TIM_CCMR2_IC4F_1;
+    TIM3->CCER = TIM_CCER_CC4E;
+    // enable index capture interrupt
+    TIM3->DIER = TIM_DIER_CC4IE;
     // enable timer
     TIM3->CR1 = TIM_CR1_CEN; /* (4) */
     NVIC_EnableIRQ(TIM3_IRQn);
+    // PA6/PA7 edges: EXTI6/7 (port A is default in SYSCFG) for low speed velocity,
+    // interrupts are unmasked by encoder.c
+    RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+    EXTI->RTSR |= EXTI_RTSR_TR6 | EXTI_RTSR_TR7;
+    EXTI->FTSR |= EXTI_FTSR_TR6 | EXTI_FTSR_TR7;
+    NVIC_EnableIRQ(EXTI4_15_IRQn);
 }
 
 void hw_setup(){
@@ -64,10 +74,3 @@ void hw_setup(){
     timers_setup();
     USART1_config();
 }
-
-void tim3_isr(){
-    if(TIM3->SR & TIM_SR_UIF){
-        tim3upd = 1;
-    }
-    TIM3->SR = 0;
-}
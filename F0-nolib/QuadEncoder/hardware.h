@@ -20,7 +20,6 @@
 #define HARDWARE_H__
 #include "stm32f0.h"
 
-extern volatile uint8_t tim3upd;
 extern volatile uint32_t Tms;
 void hw_setup(void);
 
@@ -21,22 +21,26 @@
 #include "hardware.h"
 #include "protocol.h"
 #include "usart.h"
+#include "encoder.h"
 #include <stm32f0.h>
 
 
 volatile uint32_t Tms = 0;
+uint32_t stream_period = 0; // period of position/velocity stream, ms (0 - off)
 
 // Called when systick fires
 void sys_tick_handler(void){
     ++Tms;
+    encoder_tick();
 }
 
 int main(void){
     uint32_t T = 0;
-    uint32_t tim3cnt = 0;
+    enc_sample s;
     char *txt;
     hw_setup();
     SysTick_Config(6000, 1);
+    encoder_setup();
     SEND("Encoder controller v0.1\n");
     while (1){
         if(usart1_getline(&txt)){ // usart1 received command, process it
@@ -45,22 +49,22 @@ int main(void){
         if(txt){ // text waits for sending
             while(ALL_OK != usart1_send(txt, 0));
         }
-        if(Tms - T == 10){
-            T = Tms;
-            if(tim3cnt != TIM3->CNT){
-                int32_t diff = TIM3->CNT - tim3cnt;
-                if(tim3upd){
-                    if(TIM3->CR1 & TIM_CR1_DIR) diff -= 80;
-                    else diff += 80;
-                    tim3upd = 0;
-                }
-                tim3cnt = TIM3->CNT;
-                put_string("Speed: ");
-                put_int(diff);
-                put_string(", pos: ");
-                put_uint(TIM3->CNT);
-                put_char('\n');
-            }
+        if(stream_period && Tms - T >= stream_period){
+            T += stream_period;
+            if(Tms - T >= stream_period) T = Tms; // missed samples
+            encoder_get(&s);
+            put_string("T=");
+            put_uint(s.T);
+            put_string(", P=");
+            put_int(s.pos);
+            put_string(", V=");
+            put_int(s.vel);
+            put_char('\n');
+        }
+        if(index_latched){
+            put_string("INDEX=");
+            put_int(encoder_index());
+            put_char('\n');
         }
         usart1_sendbuf();
     }
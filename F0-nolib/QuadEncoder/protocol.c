@@ -18,6 +18,9 @@
 #include "hardware.h"
 #include "protocol.h"
 #include "usart.h"
+#include "encoder.h"
+
+extern uint32_t stream_period;
 
 
 
@@ -28,27 +31,60 @@
  */
 char *process_command(const char *command){
     char *ret = NULL;
+    int32_t N;
+    enc_sample s;
     usart1_sendbuf(); // send buffer (if it is already filled)
     switch(*command){
         case '?': // help
             SEND_BLK(
                 "D - get rotation direction\n"
+                "I - get position latched by index pulse\n"
+                "P - get position, revolutions and velocity\n"
                 "R - reset\n"
+                "Sx - stream position/velocity each x ms (0 - stop)\n"
                 "T - get timer value\n"
+                "Z - set current position as zero\n"
                 );
         break;
         case 'D':
             if(TIM3->CR1 & TIM_CR1_DIR) SEND("negative\n");
             else SEND("positive\n");
         break;
+        case 'I':
+            put_string("INDEX=");
+            put_int(encoder_index());
+            put_char('\n');
+        break;
+        case 'P':
+            encoder_get(&s);
+            put_string("POS=");
+            put_int(s.pos);
+            put_string("\nREVS=");
+            put_int(s.pos / ENC_CPR);
+            put_string("\nVEL=");
+            put_int(s.vel);
+            put_char('\n');
+        break;
         case 'R': // reset MCU
             NVIC_SystemReset();
         break;
+        case 'S':
+            if(getnum(command + 1, &N) && N > -1 && N <= ENC_MAX_STREAM){
+                stream_period = N;
+            }
+            put_string("STREAM=");
+            put_uint(stream_period);
+            put_char('\n');
+        break;
         case 'T':
             put_string("TIM3->CNT=");
             put_uint(TIM3->CNT);
             put_char('\n');
         break;
+        case 'Z':
+            encoder_zero();
+            SEND("POS=0\n");
+        break;
     }
     usart1_sendbuf();
     return ret;
@@ -0,0 +1,158 @@
+/*
+ * This file is part of the QuadEncoder project.
+ * Copyright 2019 Edward V. Emelianov <edward.emelianoff@gmail.com>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Position & velocity of quadrature encoder (no hardware here, so it could be
+ * tested on host). Position: signed difference of 16-bit counter is added to
+ * 32-bit value on each update. Velocity (M/T method):
+ *  - high speed (>= ENC_HIGHSPEED_CNT counts per ENC_VEL_WINDOW ms): counts
+ *    difference in window;
+ *  - low speed: counts between two last edges in the same direction divided
+ *    by interval between their timestamps (us); edge of opposite direction
+ *    coming in less than ENC_GLITCH_US which returns counter back is a glitch
+ *    and is forgotten; between edges velocity is bounded by 1/(time since last
+ *    edge) and becomes zero after ENC_STOP_MS.
+ */
+
+#include "quad.h"
+
+/**
+ * @brief quad_init - reset state
+ * @param cnt - current counter value
+ * @param ms, us - current time
+ */
+void quad_init(quadenc *q, uint16_t cnt, uint32_t ms, uint32_t us){
+    q->pos = q->vel = 0;
+    q->lastcnt = cnt;
+    q->highspeed = 0;
+    q->dir = q->prevdir = 0;
+    q->winpos = q->edgepos = q->prevpos = 0;
+    q->winT = ms;
+    q->edgeus = q->prevus = us;
+    q->prevvel = 0;
+}
+
+/**
+ * @brief quad_update - add counts passed since last update
+ * @param cnt - counter value
+ * @return extended position
+ */
+int32_t quad_update(quadenc *q, uint16_t cnt){
+    q->pos += (int16_t)(cnt - q->lastcnt);
+    q->lastcnt = cnt;
+    return q->pos;
+}
+
+/**
+ * @brief quad_edge - process edge of A or B signal (low speed only)
+ * @param cnt - counter value after edge
+ * @param us  - edge timestamp
+ * @return 1 if speed is too high for edges processing
+ */
+uint8_t quad_edge(quadenc *q, uint16_t cnt, uint32_t us){
+    int32_t pos = quad_update(q, cnt), d;
+    int8_t dir;
+    if(q->highspeed) return 1;
+    d = pos - q->winpos;
+    if(d >= ENC_HIGHSPEED_CNT || d <= -ENC_HIGHSPEED_CNT){ // there's no need to wait for window end
+        q->highspeed = 1;
+        return 1;
+    }
+    d = pos - q->edgepos;
+    if(d == 0) return 0; // counter didn't change (e.g. both edges of glitch passed)
+    dir = (d > 0) ? 1 : -1;
+    if(q->dir && dir != q->dir && pos == q->prevpos && us - q->edgeus < ENC_GLITCH_US){
+        // glitch: forget previous edge
+        q->edgepos = q->prevpos;
+        q->edgeus = q->prevus;
+        q->vel = q->prevvel;
+        q->dir = q->prevdir;
+        return 0;
+    }
+    q->prevpos = q->edgepos;
+    q->prevus = q->edgeus;
+    q->prevvel = q->vel;
+    q->prevdir = q->dir;
+    if(dir == q->dir){
+        uint32_t dt = us - q->edgeus;
+        if(dt == 0) dt = 1;
+        q->vel = (int32_t)((int64_t)d * 1000000000LL / dt);
+    }else if(q->dir) q->vel = 0; // reversal: there's no period in new direction yet
+    q->dir = dir;
+    q->edgepos = pos;
+    q->edgeus = us;
+    return 0;
+}
+
+/**
+ * @brief quad_tick - update position & velocity, should be called each 1ms
+ * @param cnt - counter value
+ * @param ms, us - current time
+ * @return 1 if speed is high (edges shouldn't be processed)
+ */
+uint8_t quad_tick(quadenc *q, uint16_t cnt, uint32_t ms, uint32_t us){
+    int32_t pos = quad_update(q, cnt);
+    if(ms - q->winT >= ENC_VEL_WINDOW){
+        int32_t d = pos - q->winpos;
+        uint8_t hs = (d >= ENC_HIGHSPEED_CNT || d <= -ENC_HIGHSPEED_CNT);
+        // count difference is used in high speed & until first edges in low speed
+        if(hs || q->highspeed){ // 64 bits: d*1e5 overflows int32 over ~2.1M counts/s
+            int64_t v = (int64_t)d * (1000000 / ENC_VEL_WINDOW);
+            if(v > INT32_MAX) v = INT32_MAX;
+            else if(v < -INT32_MAX) v = -INT32_MAX;
+            q->vel = (int32_t)v;
+        }
+        if(q->highspeed && !hs){ // wait for edges from now
+            q->dir = 0;
+            q->edgepos = pos;
+            q->edgeus = us;
+        }
+        q->highspeed = hs;
+        q->winpos = pos;
+        q->winT = ms;
+    }
+    if(q->highspeed){ // edges are not processed: last "edge" is now
+        q->dir = 0;
+        q->edgepos = pos;
+        q->edgeus = us;
+        return 1;
+    }
+    uint32_t dt = us - q->edgeus;
+    if(dt > ENC_STOP_MS * 1000){
+        q->vel = 0;
+        q->dir = 0;
+    }else if(dt){ // next count can't come earlier than now
+        int32_t vmax = (int32_t)(1000000000U / dt);
+        if(q->vel > vmax) q->vel = vmax;
+        else if(q->vel < -vmax) q->vel = -vmax;
+    }
+    return 0;
+}
+
+/**
+ * @brief quad_zero - set current position as zero (quad_update() should be called before)
+ * @return old position
+ */
+int32_t quad_zero(quadenc *q){
+    int32_t p = q->pos;
+    q->pos = 0;
+    q->winpos -= p;
+    q->edgepos -= p;
+    q->prevpos -= p;
+    return p;
+}
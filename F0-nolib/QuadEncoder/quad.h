@@ -0,0 +1,56 @@
+/*
+ * This file is part of the QuadEncoder project.
+ * Copyright 2019 Edward V. Emelianov <edward.emelianoff@gmail.com>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef QUAD_H__
+#define QUAD_H__
+
+#include <stdint.h>
+
+// velocity measurement window for high speed (ms)
+#define ENC_VEL_WINDOW      (10)
+// measure by count difference when there was at least this counts in window,
+// else by period between edges
+#define ENC_HIGHSPEED_CNT   (32)
+// velocity is zero when there was no counts during this time (ms)
+#define ENC_STOP_MS         (2000)
+// opposite edge which came earlier than this after previous one is glitch (us)
+#define ENC_GLITCH_US       (50)
+
+typedef struct{
+    int32_t pos;        // extended position, counts
+    int32_t vel;        // velocity, 1e-3 counts per second
+    uint16_t lastcnt;   // counter value on last position update
+    uint8_t highspeed;  // velocity measured by count difference
+    int8_t dir;         // direction of last edge (0 - there's no reference edge)
+    int32_t winpos;     // position at start of velocity window
+    uint32_t winT;      // start of velocity window, ms
+    int32_t edgepos;    // position on last edge
+    uint32_t edgeus;    // time of last edge, us
+    int32_t prevpos;    // the same for edge before it (to roll glitch back)
+    uint32_t prevus;
+    int32_t prevvel;
+    int8_t prevdir;
+} quadenc;
+
+void quad_init(quadenc *q, uint16_t cnt, uint32_t ms, uint32_t us);
+int32_t quad_update(quadenc *q, uint16_t cnt);
+uint8_t quad_edge(quadenc *q, uint16_t cnt, uint32_t us);
+uint8_t quad_tick(quadenc *q, uint16_t cnt, uint32_t ms, uint32_t us);
+int32_t quad_zero(quadenc *q);
+
+#endif // QUAD_H__
@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "quad.h"
+
+/*
+ * Model of encoder.c: time step is 1us, shaft position is integrated from
+ * velocity profile, each change of integer position is one A or B edge
+ * (TIM3 in encoder mode counts all of them into 16-bit CNT). Edge interrupt
+ * (EXTI, masked at high speed) comes with latency 1..3us and reads CNT when
+ * it is served; SysTick calls quad_tick() each 1ms.
+ * Glitch is short pulse on A or B: counter goes one step and back.
+ */
+
+typedef double (*profile)(double t);
+
+typedef struct{
+    const char *name;
+    profile v;          // velocity, counts per second
+    double len;         // length of run, s
+    int glitch;         // glitch period, ms (0 - no glitches)
+    double settle;      // check velocity after this time
+    double vmin;        // don't check velocity if true velocity is less than this
+    double relerr;      // max velocity error: relative
+    double abserr;      // and absolute (counts per second)
+    double zero_after;  // velocity should be zero after this time (0 - don't check)
+} scenario;
+
+static double v_crawl(double t){ (void)t; return 5.; }
+static double v_slow(double t){ (void)t; return 300.; }
+static double v_fast(double t){ (void)t; return -40000.; }
+static double v_sine(double t){
+    double x = t - 2. * (int)(t / 2.), s = 1.; // sin(pi*t) by parabola approximation is enough here
+    if(x > 1.){ x -= 1.; s = -1.; }
+    return s * 500. * 4. * x * (1. - x);
+}
+static double v_ramp(double t){
+    if(t < 2.) return 10000. * t;
+    if(t < 4.) return 20000. - 10000. * (t - 2.);
+    return 0.;
+}
+static double v_stop(double t){ return t < 1. ? 1000. : 0.; }
+
+static scenario scenarios[] = {
+    {"crawl 5 counts/s", v_crawl, 5., 0, 0.5, 1., 0.01, 0.1, 0.},
+    {"low speed 300 counts/s", v_slow, 3., 0, 0.1, 1., 0.005, 1., 0.},
+    {"high speed -40000 counts/s (CNT wraps)", v_fast, 3., 0, 0.1, 1., 0.01, 100., 0.},
+    {"sine 500 counts/s with reversals", v_sine, 4., 0, 0.1, 100., 0.05, 30., 0.},
+    {"ramp 0 -> 20000 -> 0 counts/s, then stop", v_ramp, 6.5, 0, 0.1, 50., 0.05, 250., 4. + ENC_STOP_MS / 1000. + 0.01},
+    {"300 counts/s with glitch each 37ms", v_slow, 3., 37, 0.1, 1., 0.005, 1., 0.},
+    {"1000 counts/s, stop at 1s", v_stop, 4., 0, 0.1, 1., 0.01, 2., 1. + ENC_STOP_MS / 1000. + 0.01},
+};
+
+static int verbose = 0;
+
+static uint64_t rnd = 88172645463325252ULL;
+static uint32_t urand(){
+    rnd ^= rnd << 13; rnd ^= rnd >> 7; rnd ^= rnd << 17;
+    return (uint32_t)(rnd >> 32);
+}
+
+static quadenc enc;
+static uint16_t CNT;        // timer counter
+static int64_t counted;     // position made by edges
+static uint8_t exti_on;     // edge interrupts unmasked
+static int64_t isr_at;      // time of pending edge interrupt service (-1 - none)
+
+static void edge(int dir, int64_t us){
+    CNT += dir;
+    counted += dir;
+    if(exti_on && isr_at < 0) isr_at = us + 1 + urand() % 3;
+}
+
+static int run(const scenario *S){
+    int64_t us, N = (int64_t)(S->len * 1e6), glitch_end = -1;
+    double x = 0., maxerr = 0.;
+    int64_t target, glitch_dir = 0;
+    int bad = 0, nchk = 0, nedges = 0, nfast = 0;
+    printf("%s\n", S->name);
+    CNT = (uint16_t)urand();
+    counted = 0;
+    isr_at = -1;
+    exti_on = 1;
+    quad_init(&enc, CNT, 0, 0);
+    for(us = 1; us <= N; ++us){
+        double t = us * 1e-6, v = S->v(t);
+        x += v * 1e-6;
+        target = (int64_t)(x >= 0. ? x : x - 1.);
+        // glitch: one step in random direction and back after 2us
+        if(S->glitch && us % (S->glitch * 1000) == 500 && glitch_end < 0){
+            glitch_dir = (urand() & 1) ? 1 : -1;
+            edge(glitch_dir, us);
+            glitch_end = us + 2;
+        }else if(us == glitch_end){
+            edge(-glitch_dir, us);
+            glitch_end = -1;
+        }
+        while(glitch_end < 0 && counted < target){ edge(1, us); ++nedges; }
+        while(glitch_end < 0 && counted > target){ edge(-1, us); ++nedges; }
+        if(us == isr_at){ // exti4_15_isr()
+            isr_at = -1;
+            if(quad_edge(&enc, CNT, us)) exti_on = 0;
+        }
+        if(us % 1000) continue;
+        // sys_tick_handler()
+        uint8_t fast = quad_tick(&enc, CNT, (uint32_t)(us / 1000), (uint32_t)us);
+        nfast += fast;
+        if(fast) exti_on = 0;
+        else if(!exti_on){ exti_on = 1; isr_at = -1; }
+        if(glitch_end < 0 && (int32_t)enc.pos != (int32_t)counted){
+            printf("\tt=%.3f: position %d, should be %lld\n", t, enc.pos, (long long)counted);
+            ++bad;
+            counted = enc.pos; // don't repeat message
+        }
+        double vel = enc.vel / 1000.;
+        if(verbose && (us % 10000) == 0)
+            printf("%7.3f %-4s pos=%9d vel=%10.3f (true %10.3f)\n", t, fast ? "fast" : "slow", enc.pos, vel, v);
+        if(S->zero_after > 0. && t >= S->zero_after && enc.vel){
+            printf("\tt=%.3f: velocity %.3f should be zero\n", t, vel);
+            ++bad;
+            break;
+        }
+        if(t < S->settle || (v < S->vmin && v > -S->vmin)) continue;
+        double err = vel - v;
+        if(err < 0.) err = -err;
+        ++nchk;
+        if(err > maxerr) maxerr = err;
+        if(err > S->relerr * (v < 0. ? -v : v) + S->abserr){
+            if(bad < 10) printf("\tt=%.3f: velocity %.3f, should be %.3f\n", t, vel, v);
+            ++bad;
+        }
+    }
+    printf("\tposition %d, %d edges, %d ms at high speed, max velocity error %.3f counts/s (%d checks)\n",
+        enc.pos, nedges, nfast, maxerr, nchk);
+    return bad;
+}
+
+int main(int argc, char **argv){
+    int bad = 0;
+    if(argc > 1 && !strcmp(argv[1], "-v")) verbose = 1;
+    for(size_t i = 0; i < sizeof(scenarios)/sizeof(scenarios[0]); ++i)
+        bad += run(&scenarios[i]);
+    if(bad) printf("%d errors\n", bad);
+    else printf("All OK\n");
+    return bad ? 1 : 0;
+}
@@ -18,6 +18,7 @@
 
 #include "effects.h"
 #include "hardware.h"
+#include "traject.h"
 #include "usart.h"
 
 uint8_t dma_eff = 0;
@@ -109,8 +110,13 @@ static const uint16_t dmabufstar[] = {  1300,930,1300,930,1300,930,1300,930,1300
                                         1470,800,1470,800,1470,800,1470,800,1470,800,1470,800};
 
 static void DMA_eff(const void* buff, uint8_t len){
+    TIM3->DCR = (1 << 8) | // DBL=1 -- two transfers
+                 (((uint32_t)&TIM3->CCR1 - (uint32_t)&TIM3->CR1) >> 2); // reg = (DBA + TIM3->CR1)/4
     DMA1_Channel3->CMAR = (uint32_t)(buff);
     DMA1_Channel3->CNDTR = len;
+    // memsiz 16bit, psiz 32bit, memincrement, from memory, circulate
+    DMA1_Channel3->CCR = DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_1
+                       | DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_CIRC;
     DMA1_Channel3->CCR |= DMA_CCR_EN;
     TIM3->DIER |= TIM_DIER_UDE;
 }
@@ -141,7 +147,9 @@ effect_t set_effect(int n, effect_t eff){
     if(n < 0 || n > 2) return EFF_NONE;
     cntr[n] = 0;
     dir[n] = 1;
-    if(dma_eff){
+    if(traj_running){
+        traj_stop();
+    }else if(dma_eff){
         TIM3->DIER &= ~TIM_DIER_UDE; // turn off DMA requests from UE
         DMA1_Channel3->CCR &= ~DMA_CCR_EN; // turn off DMA if current was with it
         dma_eff = 0;
@@ -169,13 +169,8 @@ static inline void timers_setup(){
     // enable timer & ARR buffering
     TIM3->CR1 |= TIM_CR1_CEN | TIM_CR1_ARPE;
     RCC->AHBENR |= RCC_AHBENR_DMA1EN;
-    // DMA for more effects (channel 3 -> TIM3_UP)
+    // DMA for effects & trajectories (channel 3 -> TIM3_UP), DCR and CCR are set before start
     DMA1_Channel3->CPAR = (uint32_t)(&(TIM3->DMAR)); // each writing to DMAR will change next register
-    // memsiz 16bit, psiz 32bit, memincrement, from memory, circulate
-    DMA1_Channel3->CCR |=  DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_1
-                       | DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_CIRC;
-    TIM3->DCR = (1 << 8) | // DBL=1 -- two transfers
-                 (((uint32_t)&TIM3->CCR1 - (uint32_t)&TIM3->CR1) >> 2); // reg = (DBA + TIM3->CR1)/4
     NVIC_EnableIRQ(TIM3_IRQn);
 }
 
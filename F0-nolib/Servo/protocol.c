@@ -19,6 +19,7 @@
 #include "effects.h"
 #include "hardware.h"
 #include "protocol.h"
+#include "traject.h"
 #include "usart.h"
 
 
@@ -146,6 +147,53 @@ static void DMA_effect(const char *cmd){
     }
 }
 
+/**
+ * @brief keyframe - trajectory commands
+ * @param cmd - "S" - start, "X" - stop, "p1,p2,p3,dur[,ease]" - add keyframe,
+ *              empty - get status
+ */
+static void keyframe(const char *cmd){
+    keyframe_t kf;
+    int32_t N;
+    switch(*cmd){
+        case 'S':
+            traj_start();
+        break;
+        case 'X':
+            traj_stop();
+        break;
+        case 0:
+        break;
+        default: // new keyframe
+            for(int i = 0; i < 4; ++i){
+                if(!(cmd = getnum(cmd, &N)) || N < 0 || N > 65535 || (i < 3 && *cmd++ != ',')){
+                    put_string("Bad keyframe\n");
+                    return;
+                }
+                if(i < 3) kf.pos[i] = N;
+                else kf.dur = N;
+            }
+            kf.ease = EASE_INOUT;
+            if(*cmd++ == ','){
+                if(!getnum(cmd, &N) || N < 0 || N >= EASE_AMOUNT){
+                    put_string("Bad ease\n");
+                    return;
+                }
+                kf.ease = N;
+            }
+            if(!traj_add(&kf)){
+                put_string("KERR\n");
+                return;
+            }
+        break;
+    }
+    put_string("KRUN=");
+    put_char('0' + traj_running);
+    put_string("\nKFREE=");
+    put_int(traj_free());
+    put_char('\n');
+}
+
 /**
  * @brief process_command - command parser
  * @param command - command text (all inside [] without spaces)
@@ -160,6 +208,9 @@ char *process_command(const char *command){
                 "1-3[pos[,speed]]- set/get xth pulse length (us) (0,1,2 - min, max, mid)\n"
                 "fx - servo period (us)\n"
                 "Dx - DMA effect x\n"
+                "K  - trajectory status\n"
+                "Kp1,p2,p3,T[,e] - add keyframe: pulses (0 - don't change), time (ms), ease\n"
+                "KS - start trajectory, KX - stop & clear\n"
                 "Mn - set Mad Wipe effect\n"
                 "Pn - set Pendulum effect\n"
                 "R  - reset\n"
@@ -186,6 +237,9 @@ char *process_command(const char *command){
         case 'D':
             DMA_effect(++command);
         break;
+        case 'K':
+            keyframe(++command);
+        break;
         case 'M':
             chk_effect(command, EFF_MADWIPE, "mad wipe");
         break;
@@ -0,0 +1,176 @@
+/*
+ * This file is part of the Servo project.
+ * Copyright 2019 Edward Emelianov <eddy@sao.ru>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Trajectories: keyframes received by USART are interpolated for each PWM
+ * period and written into circular DMA buffer; TIM3 update event makes DMA
+ * burst of four words into CCR1..CCR4 (CCR3 isn't used), so all channels
+ * change at once. While DMA sends one half of buffer, HT/TC interrupt
+ * fills another one.
+ */
+
+#include "effects.h"
+#include "hardware.h"
+#include "traject.h"
+
+uint8_t traj_running = 0;
+
+static keyframe_t queue[TRAJ_QUEUE];
+static volatile uint8_t qhead = 0, qtail = 0; // read from head, write to tail
+
+// DMA buffer: [half][period][CCR1, CCR2, CCR3, CCR4], CCR3 slot is never filled (stays zero)
+static uint16_t dmabuf[2][TRAJ_HALF][4];
+
+// current segment
+static int32_t segstart[3], segdiff[3];
+static uint32_t segframes = 0, curframe = 0;
+static uint8_t segease = EASE_LINEAR;
+
+/**
+ * @brief ease - interpolation curves
+ * @param u - time fraction (0..32768)
+ * @param e - curve
+ * @return position fraction (0..32768)
+ */
+static uint32_t ease(uint32_t u, uint8_t e){
+    switch(e){
+        case EASE_INOUT: // u^2*(3-2u)
+            return (((u * u) >> 15) * (3*32768 - 2*u)) >> 15;
+        case EASE_IN: // u^2
+            return (u * u) >> 15;
+        case EASE_OUT: // 1-(1-u)^2
+            u = 32768 - u;
+            return 32768 - ((u * u) >> 15);
+        default:
+        break;
+    }
+    return u;
+}
+
+// get next keyframe from queue and calculate new segment; return 0 if queue is empty
+static int next_segment(){
+    if(qhead == qtail) return 0;
+    keyframe_t *kf = &queue[qhead];
+    for(int i = 0; i < 3; ++i){
+        segstart[i] += segdiff[i]; // end of previous segment
+        segdiff[i] = kf->pos[i] ? (int32_t)kf->pos[i] - segstart[i] : 0;
+    }
+    segframes = ((uint32_t)kf->dur * 1000) / (TIM3->ARR + 1);
+    if(segframes == 0) segframes = 1;
+    curframe = 0;
+    segease = kf->ease;
+    qhead = (qhead + 1) & (TRAJ_QUEUE - 1);
+    return 1;
+}
+
+// fill one half of DMA buffer
+static void fill_half(int h){
+    for(int f = 0; f < TRAJ_HALF; ++f){
+        uint16_t *ccr = dmabuf[h][f];
+        if(curframe >= segframes) next_segment(); // or stay in last position
+        uint32_t e = 32768;
+        if(curframe < segframes){
+            ++curframe;
+            e = ease((curframe << 15) / segframes, segease);
+        }
+        ccr[0] = segstart[0] + ((segdiff[0] * (int32_t)e) >> 15);
+        ccr[1] = segstart[1] + ((segdiff[1] * (int32_t)e) >> 15);
+        ccr[3] = segstart[2] + ((segdiff[2] * (int32_t)e) >> 15);
+    }
+}
+
+/**
+ * @brief traj_add - add keyframe to queue
+ * @param kf - keyframe
+ * @return 0 if queue is full or keyframe is wrong
+ */
+int traj_add(const keyframe_t *kf){
+    for(int i = 0; i < 3; ++i){
+        uint16_t p = kf->pos[i];
+        if(p && (p < SG90_MINPULSE || p > SG90_MAXPULSE)) return 0;
+    }
+    if(kf->ease >= EASE_AMOUNT || kf->dur > TRAJ_MAXDUR) return 0;
+    uint8_t nxt = (qtail + 1) & (TRAJ_QUEUE - 1);
+    if(nxt == qhead) return 0;
+    queue[qtail] = *kf;
+    qtail = nxt;
+    return 1;
+}
+
+/**
+ * @brief traj_free - amount of free places in queue
+ */
+int traj_free(){
+    return (qhead - qtail - 1) & (TRAJ_QUEUE - 1);
+}
+
+/**
+ * @brief traj_start - start trajectory from current position
+ */
+void traj_start(){
+    if(traj_running) return;
+    for(int i = 0; i < 3; ++i) set_effect(i, EFF_NONE); // stop other effects
+    for(int i = 0; i < 3; ++i){
+        segstart[i] = getPWM(i);
+        segdiff[i] = 0;
+    }
+    segframes = curframe = 0;
+    fill_half(0);
+    fill_half(1);
+    traj_running = 1;
+    dma_eff = 1; // stop slewing in tim3_isr
+    DMA1_Channel3->CCR = 0;
+    DMA1->IFCR = DMA_IFCR_CGIF3; // clear HT/TC flags left by effects DMA
+    // 4 transfers (CCR1..CCR4) on each update
+    TIM3->DCR = (3 << 8) | (((uint32_t)&TIM3->CCR1 - (uint32_t)&TIM3->CR1) >> 2);
+    DMA1_Channel3->CMAR = (uint32_t)dmabuf;
+    DMA1_Channel3->CNDTR = sizeof(dmabuf) / sizeof(uint16_t);
+    // memsiz 16bit, psiz 32bit, memincrement, from memory, circulate, HT & TC interrupts
+    DMA1_Channel3->CCR = DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_1 | DMA_CCR_MINC | DMA_CCR_DIR
+                       | DMA_CCR_CIRC | DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_EN;
+    TIM3->DIER |= TIM_DIER_UDE;
+}
+
+/**
+ * @brief traj_stop - stop trajectory & clear queue; servos stay in current positions
+ */
+void traj_stop(){
+    qhead = qtail;
+    if(!traj_running) return;
+    TIM3->DIER &= ~TIM_DIER_UDE;
+    DMA1_Channel3->CCR = 0;
+    DMA1->IFCR = DMA_IFCR_CGIF3;
+    traj_running = 0;
+    dma_eff = 0;
+    for(int i = 0; i < 3; ++i) setPWM(i, getPWM(i), 0);
+}
+
+/**
+ * @brief traj_dmaproc - fill next half of buffer; called from DMA channels 2/3 interrupt
+ */
+void traj_dmaproc(){
+    uint32_t isr = DMA1->ISR;
+    if(isr & DMA_ISR_HTIF3){ // first half sent, refill it
+        DMA1->IFCR = DMA_IFCR_CHTIF3;
+        fill_half(0);
+    }
+    if(isr & DMA_ISR_TCIF3){
+        DMA1->IFCR = DMA_IFCR_CTCIF3;
+        fill_half(1);
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ * This file is part of the Servo project.
+ * Copyright 2019 Edward Emelianov <eddy@sao.ru>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef TRAJECT_H__
+#define TRAJECT_H__
+
+#include "stm32f0.h"
+
+// keyframes queue length (power of 2)
+#define TRAJ_QUEUE      (16)
+// PWM periods in each half of DMA buffer
+#define TRAJ_HALF       (4)
+// max keyframe duration, ms
+#define TRAJ_MAXDUR     (60000)
+
+// interpolation curves
+typedef enum{
+    EASE_LINEAR,    // constant speed
+    EASE_INOUT,     // smoothstep: slow start & stop
+    EASE_IN,        // slow start
+    EASE_OUT,       // slow stop
+    EASE_AMOUNT
+} ease_t;
+
+// position 0 means "don't change"
+typedef struct{
+    uint16_t pos[3];    // target pulse lengths, us
+    uint16_t dur;       // time to reach target, ms
+    uint8_t ease;       // ease_t
+} keyframe_t;
+
+extern uint8_t traj_running;
+
+int traj_add(const keyframe_t *kf);
+int traj_free();
+void traj_start();
+void traj_stop();
+void traj_dmaproc();
+
+#endif // TRAJECT_H__
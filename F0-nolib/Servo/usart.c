@@ -19,6 +19,7 @@
  * MA 02110-1301, USA.
  */
 
+#include "traject.h"
 #include "usart.h"
 #include <string.h> // memcpy
 
@@ -210,6 +211,7 @@ void dma1_channel2_3_isr(){
         DMA1->IFCR |= DMA_IFCR_CTCIF2; // clear TC flag
         txrdy = 1;
     }
+    if(traj_running) traj_dmaproc(); // channel 3: servos trajectory
 }
 
 /**
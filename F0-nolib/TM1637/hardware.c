@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "hardware.h"
+#include "i2cdma.h"
 #include "usart.h"
 
 
@@ -40,25 +41,6 @@ static inline void gpio_setup(){
     */
 }
 
-static inline void i2c_setup(){
-    I2C1->CR1 = 0;
-/*
- * GPIO Resources: I2C1_SCL - PB6 (AF1), I2C1_SDA - PB7 (AF1)
- */
-    GPIOB->MODER |= GPIO_MODER_MODER6_AF | GPIO_MODER_MODER7_AF; // alternate function
-    GPIOB->AFR[0] = (GPIOB->AFR[0] &~ (GPIO_AFRL_AFRL6 | GPIO_AFRL_AFRL7)) \
-                | (1 << (6 * 4)) | (1 << (7 * 4));
-   // GPIOB->OTYPER |= GPIO_OTYPER_OT_6 | GPIO_OTYPER_OT_7; // opendrain
-    // I2C
-    RCC->APB1ENR |= RCC_APB1ENR_I2C1EN; // timing
-    RCC->CFGR3 |= RCC_CFGR3_I2C1SW; // use sysclock for timing
-    // 100kHz
-    // Clock = 6MHz, 0.16(6)us, need 5us (*30)
-    // PRESC=4 (f/5), SCLDEL=0 (t_SU=5/6us), SDADEL=0 (t_HD=5/6us), SCLL,SCLH=14 (2.(3)us)
-    I2C1->TIMINGR = (0xB<<28) | (4<<20) | (2<<16) | (0x12<<8) | (0x11);
-    I2C1->CR1 = I2C_CR1_PE; // Enable I2C
-}
-
 void hw_setup(){
     sysreset();
     gpio_setup();
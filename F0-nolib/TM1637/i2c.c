@@ -21,85 +21,45 @@
  *
  */
 #include "stm32f0.h"
-#include "hardware.h"
 #include "i2c.h"
-#include "usart.h"
+#include "i2cdma.h"
 
-static uint32_t cntr;
+// TM1637 commands are sent as I2C addresses (I2C_RAW transactions)
+typedef struct{
+    i2c_trans_t t;
+    uint8_t buf[TM_MAXCMDS];
+} tmtrans_t;
 
-static uint8_t wri2c(uint8_t byte){
-    I2C1->CR2 = byte;// | I2C_CR2_AUTOEND;
-    if(byte & 1) I2C1->CR2 |= I2C_CR2_RD_WRN;
-    // now start transfer
-    I2C1->CR2 |= I2C_CR2_START;
-    if(I2C1->ISR & I2C_ISR_RXNE) (void) I2C1->RXDR;
-    cntr = Tms;
-    while((I2C1->ISR & I2C_ISR_TC) == 0) if(Tms - cntr > I2C_TIMEOUT) return 0;
-    if(I2C1->ISR & I2C_ISR_RXNE) (void) I2C1->RXDR;
-    I2C1->ICR = 0xff; // clear all error flags
-    return 1;
-}
+// commands are copied here, so caller can use local buffers
+static tmtrans_t pool[I2C_QUEUE_LEN];
 
 /**
- * write command byte to I2C
- * @param addr - device address (TSYS01_ADDR0 or TSYS01_ADDR1)
- * @param data - byte to write
- * @return 0 if error
+ * queue sequence of command bytes
+ * @param commands - bytes to send
+ * @param nbytes - their amount (1..TM_MAXCMDS)
+ * @return 0 if queue is full
  */
 uint8_t write_i2c(const uint8_t *commands, uint8_t nbytes){
-    uint8_t r = 1;
-    cntr = Tms;
-    while(I2C1->ISR & I2C_ISR_BUSY) if(Tms - cntr > I2C_TIMEOUT) return 0;  // check busy
-    cntr = Tms;
-    while(I2C1->CR2 & I2C_CR2_START) if(Tms - cntr > I2C_TIMEOUT) return 0; // check start
-    for(uint8_t i = 0; i < nbytes; ++i){
-        if(!wri2c(commands[i])){
-            r = 0;
-            break;
-        }
+    if(nbytes == 0 || nbytes > TM_MAXCMDS) return 0;
+    for(int i = 0; i < I2C_QUEUE_LEN; ++i){
+        tmtrans_t *p = &pool[i];
+        if(p->t.status == I2C_PENDING) continue;
+        for(uint8_t j = 0; j < nbytes; ++j) p->buf[j] = commands[j];
+        p->t.addr = commands[0];
+        p->t.op = I2C_RAW;
+        p->t.wbuf = p->buf;
+        p->t.wlen = nbytes;
+        return i2c_submit(&p->t);
     }
-    I2C1->CR2 |= I2C_CR2_STOP;
-    return r;
+    return 0;
 }
 
 /**
- * read nbytes (0..4) of data from I2C line
+ * read one byte (waits not more than I2C_TRANS_TMOUT)
  * @return 1 if all OK, 0 if NACK or no device found
  */
 uint8_t read_i2c(uint8_t command, uint8_t *data){
-    cntr = Tms;
-    while(I2C1->ISR & I2C_ISR_BUSY) if(Tms - cntr > 5) return 0;  // check busy
-    cntr = Tms;
-    while(I2C1->CR2 & I2C_CR2_START) if(Tms - cntr > 5) return 0; // check start
-    // read 1 byte
-    if(command & 1){
-        I2C1->CR2 = (1<<16) | command | I2C_CR2_RD_WRN;
-    }else{
-        wri2c(command);
-        /*
-        I2C1->CR2 = command;
-        I2C1->CR2 |= I2C_CR2_START;
-        cntr = Tms;
-        while((I2C1->ISR & I2C_ISR_TC) == 0) if(Tms - cntr > I2C_TIMEOUT) return 0;
-        */
-        I2C1->CR2 = (1<<16) |0xff | I2C_CR2_RD_WRN;
-    }
-    I2C1->CR2 |= I2C_CR2_START;
-    I2C1->CR2 |= I2C_CR2_STOP;
-    cntr = Tms;
-    while(Tms == cntr);
-/*
-    while(!(I2C1->ISR & I2C_ISR_RXNE)){ // wait for data
-        if(I2C1->ISR & I2C_ISR_NACKF){
-            I2C1->ICR |= I2C_ICR_NACKCF;
-            return 0;
-        }
-        if(Tms - cntr > 5) return 0;
-    }
-*/
-    if(I2C1->ISR & I2C_ISR_RXNE){
-        *data = I2C1->RXDR;
-        return 1;
-    }
-    return 0;
- }
+    i2c_trans_t t = {.addr = command, .op = I2C_READ, .rlen = 1, .rbuf = data};
+    if(!i2c_submit(&t)) return 0;
+    return (i2c_wait(&t) == I2C_OK);
+}
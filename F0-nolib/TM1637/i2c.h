@@ -21,8 +21,18 @@
 
 #include "stm32f0.h"
 
-// timeout in ms
-#define I2C_TIMEOUT             (15)
+// I2C1_SCL - PB6, I2C1_SDA - PB7 (AF1)
+#define I2C_GPIO                GPIOB
+#define I2C_SCL                 (6)
+#define I2C_SDA                 (7)
+#define I2C_AF                  (1)
+// TM1637 has no pull-ups: SCL/SDA are push-pull
+#define I2C_OPENDRAIN           (0)
+// 100kHz
+#define I2C_TIMING              ((0xB<<28) | (4<<20) | (2<<16) | (0x12<<8) | (0x11))
+
+// max length of commands sequence
+#define TM_MAXCMDS              (8)
 
 uint8_t read_i2c(uint8_t command, uint8_t *data);
 uint8_t write_i2c(const uint8_t *commands, uint8_t nbytes);
@@ -17,6 +17,7 @@
  */
 #include "hardware.h"
 #include "i2c.h"
+#include "i2cdma.h"
 #include "protocol.h"
 #include "usart.h"
 #include <stm32f0.h>
@@ -46,6 +47,7 @@ int main(void){
         if(txt){ // text waits for sending
             while(ALL_OK != usart1_send(txt, 0));
         }
+        i2c_process();
         if(Tms - T > 49){
             T = Tms;
         }
@@ -110,12 +110,15 @@ void USART1_config(){
     USART1->ICR |= USART_ICR_TCCF; /* clear TC flag */
     USART1->CR1 |= USART_CR1_RXNEIE; /* enable TC, TXE & RXNE interrupt */
     RCC->AHBENR |= RCC_AHBENR_DMA1EN;
-    DMA1_Channel2->CPAR = (uint32_t) &(USART1->TDR); // periph
-    DMA1_Channel2->CMAR = (uint32_t) tbuf; // mem
-    DMA1_Channel2->CCR |= DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_TCIE; // 8bit, mem++, mem->per, transcompl irq
+    // USART1_TX DMA remapped to channel 4 (channels 2/3 are used by I2C1)
+    RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+    SYSCFG->CFGR1 |= SYSCFG_CFGR1_USART1TX_DMA_RMP;
+    DMA1_Channel4->CPAR = (uint32_t) &(USART1->TDR); // periph
+    DMA1_Channel4->CMAR = (uint32_t) tbuf; // mem
+    DMA1_Channel4->CCR |= DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_TCIE; // 8bit, mem++, mem->per, transcompl irq
     USART1->CR3 = USART_CR3_DMAT;
-    NVIC_SetPriority(DMA1_Channel2_3_IRQn, 3);
-    NVIC_EnableIRQ(DMA1_Channel2_3_IRQn);
+    NVIC_SetPriority(DMA1_Channel4_5_IRQn, 3);
+    NVIC_EnableIRQ(DMA1_Channel4_5_IRQn);
     /* Configure IT */
     /* (3) Set priority for USART1_IRQn */
     /* (4) Enable USART1_IRQn */
@@ -201,9 +204,9 @@ void usart1_isr(){
     }
 }
 
-void dma1_channel2_3_isr(){
-    if(DMA1->ISR & DMA_ISR_TCIF2){ // Tx
-        DMA1->IFCR |= DMA_IFCR_CTCIF2; // clear TC flag
+void dma1_channel4_5_isr(){
+    if(DMA1->ISR & DMA_ISR_TCIF4){ // Tx
+        DMA1->IFCR |= DMA_IFCR_CTCIF4; // clear TC flag
         txrdy = 1;
     }
 }
@@ -237,11 +240,11 @@ TXstatus usart1_send(const char *str, int len){
         while(*ptr++) ++len;
     }
     if(len == 0) return ALL_OK;
-    DMA1_Channel2->CCR &= ~DMA_CCR_EN;
+    DMA1_Channel4->CCR &= ~DMA_CCR_EN;
     memcpy(tbuf, str, len);
 //    tbuf[len++] = '\n';
-    DMA1_Channel2->CNDTR = len;
-    DMA1_Channel2->CCR |= DMA_CCR_EN; // start transmission
+    DMA1_Channel4->CNDTR = len;
+    DMA1_Channel4->CCR |= DMA_CCR_EN; // start transmission
     return ALL_OK;
 }
 
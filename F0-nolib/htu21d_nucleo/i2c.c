@@ -22,6 +22,8 @@
  */
 #include "stm32f0.h"
 #include "i2c.h"
+#include "i2cdma.h"
+#include "sched.h"
 
 /**
  * I2C for HTU21D
@@ -51,63 +53,26 @@
  */
 
 /*
- * Resources: I2C1_SCL - PA9, I2C1_SDA - PA10
- * GPIOA->AFR[1] AF4 -- GPIOA->AFR[1] &= ~0xff0, GPIOA->AFR[1] |= 0x440
+ * Resources: I2C1_SCL - PA9, I2C1_SDA - PA10 (see i2c.h)
+ * All transactions are non-blocking, see i2cdma.c
  */
-extern volatile uint32_t Tms;
-static uint32_t cntr;
 
-void i2c_setup(){
-    // GPIO
-    RCC->AHBENR |= RCC_AHBENR_GPIOAEN; // clock
-    GPIOA->AFR[1] &= ~0xff0; // alternate function F4 for PA9/PA10
-    GPIOA->AFR[1] |= 0x440;
-    GPIOA->OTYPER |= GPIO_OTYPER_OT_9 | GPIO_OTYPER_OT_10; // opendrain
-    GPIOA->MODER &= ~(GPIO_MODER_MODER9 | GPIO_MODER_MODER10);
-    GPIOA->MODER |= GPIO_MODER_MODER9_AF | GPIO_MODER_MODER10_AF; // alternate function
-    // I2C
-    RCC->APB1ENR |= RCC_APB1ENR_I2C1EN; // timing
-    RCC->CFGR3 |= RCC_CFGR3_I2C1SW; // use sysclock for timing
-    // Clock = 6MHz, 0.16(6)us, need 5us (*30)
-    // PRESC=4 (f/5), SCLDEL=0 (t_SU=5/6us), SDADEL=0 (t_HD=5/6us), SCLL,SCLH=14 (2.(3)us)
-    I2C1->TIMINGR = (4<<28) | (14<<8) | (14); // 0x40000e0e
-    I2C1->CR1 = I2C_CR1_PE;// | I2C_CR1_RXIE; // Enable I2C & (interrupt on receive - not supported yet)
-}
-// I2C2->TIMINGR = (uint32_t)0x00B01A4B;
-// PRECS=0 - tpresc=20.8(3)ns, SCLDEL=B (tSU 12tpresc), SDADEL=0 (tHD=0), SCLH=1a (27), SCLL=4B (76)
-// https://github.com/mattbrejza/magnet-node/blob/master/firmware-basestation/htu21.c
-// prescaler = 1, low period = 0x13, high period = 0xf, hold time = 2, setup = 4
-// I2C_TIMINGR(H_I2C) = (1<<28) | (4<<20) | (2<<16) | (0xf<<8) | 0x13;
+static uint8_t cmdbuf[2];   // command (and register value)
+static uint8_t rdbuf[3];    // data MSB, LSB, CRC
+static i2c_trans_t wtrans = {.addr = HTU21_ADDR, .op = I2C_WRITE, .wbuf = cmdbuf};
+static i2c_trans_t rtrans = {.addr = HTU21_ADDR, .op = I2C_READ, .rbuf = rdbuf, .rlen = 3};
 
-/* transmit:
- * I2Cx_CR2:
- *      Addressing mode (7-bit or 10-bit): ADD10
- *      Slave address to be sent: SADD[9:0]
- *      Transfer direction: I2C_CR2_RD_WRN=0
- *      The number of bytes to be transferred: NBYTES[7:0] (NBYTES<<16)
- *      You must then set the START bit in I2Cx_CR2 register.
- *      Automatic end mode (AUTOEND = '1' in the I2Cx_CR2 register),
- * I2C1->CR2 = I2C_CR2_HEAD10R | SLAVE_ADDR; // 7bit, slave address
+/**
+ * @brief htu_write_i2c - queue command
+ * @param data - command
+ * @return 0 if previous command isn't sent yet or queue is full
  */
-// return 1 if all OK, 0 if NACK
 uint8_t htu_write_i2c(uint8_t data){
-    cntr = Tms;
-    while(I2C1->ISR & I2C_ISR_BUSY) if(Tms - cntr > 5) return 0;  // check busy
-    cntr = Tms;
-    while(I2C1->CR2 & I2C_CR2_START) if(Tms - cntr > 5) return 0; // check start
-    I2C1->CR2 = 1<<16 | HTU21_ADDR | I2C_CR2_AUTOEND;  // 1 byte, autoend
-    // now start transfer
-    I2C1->CR2 |= I2C_CR2_START;
-    cntr = Tms;
-    while(!(I2C1->ISR & I2C_ISR_TXIS)){ // ready to transmit
-        if(I2C1->ISR & I2C_ISR_NACKF){
-            I2C1->ICR |= I2C_ICR_NACKCF;
-            return 0;
-        }
-        if(Tms - cntr > 5) return 0;
-    }
-    I2C1->TXDR = data; // send data
-    return 1;
+    if(wtrans.status == I2C_PENDING) return 0;
+    cmdbuf[0] = data;
+    wtrans.op = I2C_WRITE;
+    wtrans.wlen = 1;
+    return i2c_submit(&wtrans);
 }
 
 #define SHIFTED_DIVISOR 0x988000    //This is the 0x0131 polynomial shifted to farthest left of three bytes
@@ -125,96 +90,49 @@ uint32_t htu_check_crc(uint16_t data, uint8_t crc){
     return remainder;
 }
 
-// return 1 if all OK, 0 if NACK
-uint8_t htu_read_i2c(uint16_t *data){
-    uint8_t buf[3];
-    cntr = Tms;
-    while(I2C1->ISR & I2C_ISR_BUSY) if(Tms - cntr > 5) return 0;  // check busy
-    cntr = Tms;
-    while(I2C1->CR2 & I2C_CR2_START) if(Tms - cntr > 5) return 0; // check start
-    // read three bytes
-    I2C1->CR2 = 3<<16 | HTU21_ADDR | 1 | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
-    I2C1->CR2 |= I2C_CR2_START;
-    int i;
-    cntr = Tms;
-    for(i = 0; i < 3; ++i){
-        while(!(I2C1->ISR & I2C_ISR_RXNE)){ // wait for data
-            if(I2C1->ISR & I2C_ISR_NACKF){
-                I2C1->ICR |= I2C_ICR_NACKCF;
-                return 0;
-            }
-            if(Tms - cntr > 5) return 0;
-        }
-        buf[i] = I2C1->RXDR;
-    }
-    *data = (buf[0] << 8) | buf[1];
-    if(htu_check_crc(*data, buf[2])) return 1; // CRC error
-    return 1;
- }
+/**
+ * @brief htu_read_i2c - queue reading of measured value (no hold master mode)
+ * @return 0 if previous reading isn't done yet or queue is full
+ */
+uint8_t htu_read_i2c(){
+    if(rtrans.status == I2C_PENDING) return 0;
+    return i2c_submit(&rtrans);
+}
 
-// return 0 if all OK
+/**
+ * @brief htu_read_result - check reading started by htu_read_i2c()
+ * @param data (o) - measured value
+ * @return I2C_PENDING while reading, I2C_NACK if conversion isn't ready,
+ *         HTU21_CRCERR if CRC is wrong, I2C_OK if data is good
+ */
+uint8_t htu_read_result(uint16_t *data){
+    uint8_t st = rtrans.status;
+    if(st != I2C_OK) return st;
+    *data = (rdbuf[0] << 8) | rdbuf[1];
+    if(htu_check_crc(*data, rdbuf[2])) return HTU21_CRCERR;
+    return I2C_OK;
+}
+
+// return 1 if all OK
 uint8_t htu_read_reg(uint8_t *data){
-    cntr = Tms;
-    while(I2C1->ISR & I2C_ISR_BUSY) if(Tms - cntr > 5) return 0;  // check busy
-    cntr = Tms;
-    while(I2C1->CR2 & I2C_CR2_START) if(Tms - cntr > 5) return 0; // check start
-    I2C1->CR2 = 1<<16 | HTU21_ADDR;  // 1 byte
-    I2C1->CR2 |= I2C_CR2_START;
-    cntr = Tms;
-    while(!(I2C1->ISR & I2C_ISR_TXIS)){ // ready to transmit
-        if(I2C1->ISR & I2C_ISR_NACKF){
-            I2C1->ICR |= I2C_ICR_NACKCF;
-            return 0;
-        }
-        if(Tms - cntr > 5) return 0;
-    }
-    I2C1->TXDR = HTU21_READ_REG;
-    cntr = Tms;
-    while(!(I2C1->ISR & I2C_ISR_TC)) if(Tms - cntr > 5) return 0; // wait transfer completion
-    I2C1->CR2 = 1<<16 | HTU21_ADDR | 1 | I2C_CR2_RD_WRN | I2C_CR2_AUTOEND; // receive, autoend
-    I2C1->CR2 |= I2C_CR2_START;
-    cntr = Tms;
-    while(!(I2C1->ISR & I2C_ISR_RXNE)){ // wait for data
-        if(I2C1->ISR & I2C_ISR_NACKF){
-            I2C1->ICR |= I2C_ICR_NACKCF;
-            return 0;
-        }
-        if(Tms - cntr > 5) return 0;
-    }
-    *data = I2C1->RXDR;
-    return 1;
+    if(wtrans.status == I2C_PENDING) return 0;
+    cmdbuf[0] = HTU21_READ_REG;
+    wtrans.op = I2C_WRITEREAD;
+    wtrans.wlen = 1;
+    wtrans.rbuf = data;
+    wtrans.rlen = 1;
+    if(!i2c_submit(&wtrans)) return 0;
+    return (i2c_wait(&wtrans) == I2C_OK);
 }
 
 uint8_t htu_write_reg(uint8_t data){
-    cntr = Tms;
-    while(I2C1->ISR & I2C_ISR_BUSY) if(Tms - cntr > 5) return 0;  // check busy
-    cntr = Tms;
-    while(I2C1->CR2 & I2C_CR2_START) if(Tms - cntr > 5) return 0; // check start
-    I2C1->CR2 = 1<<16 | HTU21_ADDR;  // 1 byte
-    I2C1->CR2 |= I2C_CR2_START;
-    cntr = Tms;
-    while(!(I2C1->ISR & I2C_ISR_TXIS)){ // ready to transmit
-        if(I2C1->ISR & I2C_ISR_NACKF){
-            I2C1->ICR |= I2C_ICR_NACKCF;
-            return 0;
-        }
-        if(Tms - cntr > 5) return 0;
-    }
-    I2C1->TXDR = HTU21_WRITE_REG;
-    cntr = Tms;
-    while(!(I2C1->ISR & I2C_ISR_TC)) if(Tms - cntr > 5) return 0; // wait transfer completion
-    I2C1->CR2 |= I2C_CR2_AUTOEND; // receive, autoend
-    I2C1->CR2 |= I2C_CR2_START;
-    cntr = Tms;
-    while(!(I2C1->ISR & I2C_ISR_TXIS)){ // ready to transmit
-        if(I2C1->ISR & I2C_ISR_NACKF){
-            I2C1->ICR |= I2C_ICR_NACKCF;
-            return 0;
-        }
-        if(Tms - cntr > 5) return 0;
-    }
-    I2C1->TXDR = data;
-    return 1;
+    if(wtrans.status == I2C_PENDING) return 0;
+    cmdbuf[0] = HTU21_WRITE_REG;
+    cmdbuf[1] = data;
+    wtrans.op = I2C_WRITE;
+    wtrans.wlen = 2;
+    if(!i2c_submit(&wtrans)) return 0;
+    return (i2c_wait(&wtrans) == I2C_OK);
 }
 
 
@@ -235,3 +153,26 @@ int16_t convert_humidity(uint16_t in){
     int16_t val = (int16_t)a - 60;
     return val;
 }
+
+// scheduler callbacks: channel 0 - temperature, 1 - humidity (no hold master)
+static uint8_t htu_start(int n){
+    return htu_write_i2c(n ? HTU21_READ_HUMID : HTU21_READ_TEMP);
+}
+static uint8_t htu_read(int n){
+    (void) n;
+    return htu_read_i2c();
+}
+// result: T in degC*10 or RH in %*10
+static uint8_t htu_result(int n, int32_t *val){
+    uint16_t raw;
+    uint8_t st = htu_read_result(&raw);
+    if(st == I2C_OK) *val = n ? convert_humidity(raw) : convert_temperature(raw);
+    return st;
+}
+
+// both channels are in one chip, so they can't convert simultaneously
+static uint8_t htu_lock;
+sensor_t htu_sensors[HTU21_NCHANNELS] = {
+    {.start = htu_start, .read = htu_read, .result = htu_result, .convtime = HTU21_CONV_TIME, .lock = &htu_lock},
+    {.start = htu_start, .read = htu_read, .result = htu_result, .convtime = HTU21_CONV_TIMEH, .lock = &htu_lock},
+};
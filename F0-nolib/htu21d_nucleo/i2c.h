@@ -21,6 +21,24 @@
  *
  */
 
+#pragma once
+#ifndef I2C_H__
+#define I2C_H__
+
+#include "stm32f0.h"
+#include "sched.h"
+
+// I2C1_SCL - PA9, I2C1_SDA - PA10 (AF4)
+#define I2C_GPIO            GPIOA
+#define I2C_SCL             (9)
+#define I2C_SDA             (10)
+#define I2C_AF              (4)
+// SCL/SDA are opendrain (pull-ups on board), 0 - push-pull
+#define I2C_OPENDRAIN       (1)
+// Clock = 6MHz, 0.16(6)us, need 5us (*30)
+// PRESC=4 (f/5), SCLDEL=0 (t_SU=5/6us), SDADEL=0 (t_HD=5/6us), SCLL,SCLH=14 (2.(3)us)
+#define I2C_TIMING          ((4<<28) | (14<<8) | (14)) // 0x40000e0e
+
 #define HTU21_ADDR          (0x40 << 1)
 #define HTU21_READ_TEMP     (0xF3)
 #define HTU21_READ_HUMID    (0xF5)
@@ -34,11 +52,22 @@
 #define HTU21_REG_HTR       (0x04)
 #define HTU21_REG_ODIS      (0x02)
 
-void i2c_setup();
+// max conversion time: T(14bit) - 50ms, RH(12bit) - 16ms
+#define HTU21_CONV_TIME     (50)
+#define HTU21_CONV_TIMEH    (16)
+// scheduler channels: T, RH
+#define HTU21_NCHANNELS     (2)
+// status of htu_read_result: wrong CRC
+#define HTU21_CRCERR        (0xff)
 
 int16_t convert_temperature(uint16_t in);
 int16_t convert_humidity(uint16_t in);
 uint8_t htu_write_reg(uint8_t data);
 uint8_t htu_read_reg(uint8_t *data);
-uint8_t htu_read_i2c(uint16_t *data);
+uint8_t htu_read_i2c();
+uint8_t htu_read_result(uint16_t *data);
 uint8_t htu_write_i2c(uint8_t data);
+
+extern sensor_t htu_sensors[HTU21_NCHANNELS];
+
+#endif // I2C_H__
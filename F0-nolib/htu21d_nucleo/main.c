@@ -22,6 +22,8 @@
 #include "stm32f0.h"
 #include "usart.h"
 #include "i2c.h"
+#include "i2cdma.h"
+#include "sched.h"
 
 volatile uint32_t Tms = 0;
 
@@ -61,64 +63,97 @@ void printi(int16_t val){
     while(ALL_OK != usart2_send_blocking(buf, l+bpos));
 }
 
+// print 32bit unsigned int
+static void printu(uint32_t val){
+    char buf[10];
+    int l = 10;
+    do{
+        buf[--l] = val % 10 + '0';
+        val /= 10;
+    }while(val);
+    while(ALL_OK != usart2_send_blocking(buf + l, 10 - l));
+}
+
+// show sample: "Temperature: 234/10 degrC" or "Tms channel value" in stream mode
+static void showsample(const sample_t *smpl, uint8_t stream){
+    if(stream){
+        printu(smpl->T);
+        char b[3] = {' ', '0' + smpl->sensor, ' '};
+        while(ALL_OK != usart2_send_blocking(b, 3));
+        printi(smpl->val);
+        while(ALL_OK != usart2_send_blocking("\n", 1));
+    }else if(smpl->sensor == 0){
+        while(ALL_OK != usart2_send_blocking("Temperature: ", 13));
+        printi(smpl->val);
+        while(ALL_OK != usart2_send_blocking("/10 degrC\n", 10));
+    }else{
+        while(ALL_OK != usart2_send_blocking("Humidity: ", 10));
+        printi(smpl->val);
+        while(ALL_OK != usart2_send_blocking("/10 %\n", 6));
+    }
+}
+
 int main(void){
-    uint32_t lastT = 0;
+    uint32_t lastT = 0, last1s = 0;
     int16_t L = 0;
-    int _1sec = 0, T_H = 0; // T_H - read t(1) or h(0)
-    uint32_t msctr = 0;
+    uint8_t stream = 0; // show all samples
+    sample_t smpl, last[HTU21_NCHANNELS] = {0};
+    uint8_t havelast[HTU21_NCHANNELS] = {0};
     char *txt;
     sysreset();
     SysTick_Config(6000, 1);
     gpio_setup();
     usart2_setup();
     i2c_setup();
+    sched_init(htu_sensors, HTU21_NCHANNELS);
 
     while (1){
         if(lastT > Tms || Tms - lastT > 499){
             pin_toggle(GPIOB, 1<<3); // blink by onboard LED once per second
             lastT = Tms;
         }
+        i2c_process();
+        sched_poll();
+        while(sched_get(&smpl)){
+            if(smpl.sensor >= HTU21_NCHANNELS) continue;
+            last[smpl.sensor] = smpl;
+            havelast[smpl.sensor] = 1;
+            if(stream) showsample(&smpl, 1);
+        }
         if(usart2rx()){ // usart1 received data, store in in buffer
             L = usart2_getline(&txt);
-            printi(L);
-            // do something with received data
+            if(L == 2){
+                if(txt[0] == 'M'){ // 'M' - toggle stream mode
+                    stream = !stream;
+                }else if(txt[0] == 'S'){ // 'S' - I2C statistics
+                    const i2c_stat_t *st = i2c_getstat(HTU21_ADDR);
+                    if(st){
+                        while(ALL_OK != usart2_send_blocking("ok/nack/buserr/timeout: ", 24));
+                        printu(st->ok);
+                        while(ALL_OK != usart2_send_blocking("/", 1));
+                        printu(st->nack);
+                        while(ALL_OK != usart2_send_blocking("/", 1));
+                        printu(st->buserr);
+                        while(ALL_OK != usart2_send_blocking("/", 1));
+                        printu(st->timeout);
+                        while(ALL_OK != usart2_send_blocking("\n", 1));
+                    }
+                    while(ALL_OK != usart2_send_blocking("lost: ", 6));
+                    printu(sched_lost);
+                    while(ALL_OK != usart2_send_blocking("\n", 1));
+                }
+            }
         }
         if(L){ // text waits for sending
             if(ALL_OK == usart2_send(txt, L)){
                 L = 0;
             }
         }
-        if(msctr != Tms){
-            msctr = Tms;
-            if(++_1sec >= 1000){ // once per 1 second
-                _1sec = 0;
-                // send H/T
-                uint8_t command = HTU21_READ_HUMID;
-                if(T_H) command = HTU21_READ_TEMP;
-                if(!htu_write_i2c(command))
-                    while(ALL_OK != usart2_send_blocking("Error!\n", 7));
-            }
-        }
-        // poll I2C
-        uint16_t val = 0;
-        if(htu_read_i2c(&val)){ // got data
-            if(T_H){
-                while(ALL_OK != usart2_send_blocking("Temperature: ", 13));
-                int16_t t = convert_temperature(val);
-                printi(t);
-                while(ALL_OK != usart2_send_blocking("/10 degrC\n", 10));
-            }else{
-                while(ALL_OK != usart2_send_blocking("Humidity: ", 10));
-                int16_t h = convert_humidity(val);
-                printi(h);
-                while(ALL_OK != usart2_send_blocking("/10 %\n", 6));
-            }
-            T_H = !T_H;
-        }else{
-            if(val) // CRC error
-                while(ALL_OK != usart2_send_blocking("CRC error!\n", 11));
+        if(!stream && Tms - last1s > 999){ // once per 1 second show last values
+            last1s = Tms;
+            for(int n = 0; n < HTU21_NCHANNELS; ++n)
+                if(havelast[n]) showsample(&last[n], 0);
         }
     }
     return 0;
 }
-
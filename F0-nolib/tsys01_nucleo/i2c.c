@@ -22,6 +22,8 @@
  */
 #include "stm32f0.h"
 #include "i2c.h"
+#include "i2cdma.h"
+#include "sched.h"
 
 /**
  * I2C for TSYS01
@@ -37,86 +39,189 @@
  *      +(-1.5)* k0 * 10^{-2}
  * All coefficiens are in registers:
  * k4 - 0xA2, k3 - 0xA4, k2 - 0xA6, k1 - 0xA8, k0 - 0xAA
+ *
+ * Fixed point: A = ADC16/2^16, then
+ * T*100 = C0 + A*(C1 + A*(C2 + A*(C3 + A*C4))), where
+ * C_n = sign_n * k_n * F_n, F_n = factor_n * 100 * 2^{16n} / 10^{...};
+ * F_n are stored in Q24, C_n - in Q8 (so T*100 = Horner result >> 8)
  */
 
 /*
- * Resources: I2C1_SCL - PA9, I2C1_SDA - PA10
- * GPIOA->AFR[1] AF4 -- GPIOA->AFR[1] &= ~0xff0, GPIOA->AFR[1] |= 0x440
+ * Resources: I2C1_SCL - PA9, I2C1_SDA - PA10 (see i2c.h)
+ * All transactions are non-blocking, see i2cdma.c
  */
-extern volatile uint32_t Tms;
-static uint32_t cntr;
 
-void i2c_setup(){
-    I2C1->CR1 = 0;
-    // GPIO
-    RCC->AHBENR |= RCC_AHBENR_GPIOAEN; // clock
-    GPIOA->AFR[1] &= ~0xff0; // alternate function F4 for PA9/PA10
-    GPIOA->AFR[1] |= 0x440;
-    GPIOA->OTYPER |= GPIO_OTYPER_OT_9 | GPIO_OTYPER_OT_10; // opendrain
-    GPIOA->MODER &= ~(GPIO_MODER_MODER9 | GPIO_MODER_MODER10);
-    GPIOA->MODER |= GPIO_MODER_MODER9_AF | GPIO_MODER_MODER10_AF; // alternate function
-    // I2C
-    RCC->APB1ENR |= RCC_APB1ENR_I2C1EN; // timing
-    RCC->CFGR3 |= RCC_CFGR3_I2C1SW; // use sysclock for timing
-    // Clock = 6MHz, 0.16(6)us, need 5us (*30)
-    // PRESC=4 (f/5), SCLDEL=0 (t_SU=5/6us), SDADEL=0 (t_HD=5/6us), SCLL,SCLH=14 (2.(3)us)
-    I2C1->TIMINGR = (4<<28) | (14<<8) | (14); // 0x40000e0e
-    I2C1->CR1 = I2C_CR1_PE;// | I2C_CR1_RXIE; // Enable I2C & (interrupt on receive - not supported yet)
+typedef struct{
+    i2c_trans_t cmd;    // command
+    i2c_trans_t adc;    // ADC reading
+    i2c_trans_t rst;    // reset (separate, so it isn't blocked by pending start)
+    uint8_t cmdbyte;
+    uint8_t adcbuf[3];
+    uint8_t havecoef;   // C[] are valid
+    uint16_t k[5];      // calibration coefficients k0..k4
+    int32_t C[5];       // precomputed polynomial coefficients, Q8
+} tsys_t;
+
+// |F_n| in Q24: 1.5, 100*2^16/10^6, 2*100*2^32/10^11, 4*100*2^48/10^16, 2*100*2^64/10^21
+static const uint32_t Fq24[5] = {25165824, 109951163, 144115188, 188894659, 61897002};
+static const uint8_t promregs[5] = {0xAA, 0xA8, 0xA6, 0xA4, 0xA2}; // k0..k4
+
+static const uint8_t adccmd = TSYS01_ADC_READ;
+static const uint8_t rstcmd = TSYS01_RESET;
+static tsys_t sensors[2] = {
+    {.cmd = {.addr = TSYS01_ADDR0, .op = I2C_WRITE, .wlen = 1, .wbuf = &sensors[0].cmdbyte},
+     .adc = {.addr = TSYS01_ADDR0, .op = I2C_WRITEREAD, .wlen = 1, .wbuf = &adccmd,
+             .rlen = 3, .rbuf = sensors[0].adcbuf},
+     .rst = {.addr = TSYS01_ADDR0, .op = I2C_WRITE, .wlen = 1, .wbuf = &rstcmd}},
+    {.cmd = {.addr = TSYS01_ADDR1, .op = I2C_WRITE, .wlen = 1, .wbuf = &sensors[1].cmdbyte},
+     .adc = {.addr = TSYS01_ADDR1, .op = I2C_WRITEREAD, .wlen = 1, .wbuf = &adccmd,
+             .rlen = 3, .rbuf = sensors[1].adcbuf},
+     .rst = {.addr = TSYS01_ADDR1, .op = I2C_WRITE, .wlen = 1, .wbuf = &rstcmd}},
+};
+
+/**
+ * queue command for sensor
+ * @param n - sensor number (0 - TSYS01_ADDR0, 1 - TSYS01_ADDR1)
+ * @param data - command
+ * @return 0 if previous command isn't sent yet or queue is full
+ */
+uint8_t tsys_cmd(int n, uint8_t data){
+    if(n < 0 || n > 1) return 0;
+    tsys_t *s = &sensors[n];
+    if(s->cmd.status == I2C_PENDING) return 0;
+    s->cmdbyte = data;
+    return i2c_submit(&s->cmd);
 }
 
 /**
- * write command byte to I2C
- * @param addr - device address (TSYS01_ADDR0 or TSYS01_ADDR1)
- * @param data - byte to write
- * @return 0 if error
+ * queue reset command (even if conversion start is pending)
+ * @param n - sensor number
+ * @return 0 if previous reset isn't sent yet or queue is full
  */
-uint8_t write_i2c(uint8_t addr, uint8_t data){
-    cntr = Tms;
-    while(I2C1->ISR & I2C_ISR_BUSY) if(Tms - cntr > 5) return 0;  // check busy
-    cntr = Tms;
-    while(I2C1->CR2 & I2C_CR2_START) if(Tms - cntr > 5) return 0; // check start
-    I2C1->CR2 = 1<<16 | addr | I2C_CR2_AUTOEND;  // 1 byte, autoend
-    // now start transfer
-    I2C1->CR2 |= I2C_CR2_START;
-    cntr = Tms;
-    while(!(I2C1->ISR & I2C_ISR_TXIS)){ // ready to transmit
-        if(I2C1->ISR & I2C_ISR_NACKF){
-            I2C1->ICR |= I2C_ICR_NACKCF;
-            return 0;
-        }
-        if(Tms - cntr > 5) return 0;
+uint8_t tsys_reset(int n){
+    if(n < 0 || n > 1) return 0;
+    tsys_t *s = &sensors[n];
+    if(s->rst.status == I2C_PENDING) return 0;
+    return i2c_submit(&s->rst);
+}
+
+/**
+ * queue ADC reading
+ * @param n - sensor number
+ * @return 0 if previous reading isn't done yet or queue is full
+ */
+uint8_t tsys_readadc(int n){
+    if(n < 0 || n > 1) return 0;
+    tsys_t *s = &sensors[n];
+    if(s->adc.status == I2C_PENDING) return 0;
+    return i2c_submit(&s->adc);
+}
+
+/**
+ * check ADC reading started by tsys_readadc()
+ * @param n - sensor number
+ * @param data (o) - 24-bit ADC value
+ * @return i2c_status_t; I2C_NACK if conversion isn't ready (sensor returns 0 when
+ *      ADC is read before the end of conversion), so scheduler will retry
+ */
+uint8_t tsys_adcresult(int n, uint32_t *data){
+    if(n < 0 || n > 1) return I2C_BUSERR;
+    tsys_t *s = &sensors[n];
+    uint8_t st = s->adc.status;
+    if(st != I2C_OK) return st;
+    *data = (s->adcbuf[0] << 16) | (s->adcbuf[1] << 8) | s->adcbuf[2];
+    if(*data == 0) return I2C_NACK;
+    return I2C_OK;
+}
+
+/**
+ * read calibration coefficients of sensor into cache and precompute polynomial
+ * (blocking, should be called once after reset)
+ * @param n - sensor number
+ * @return 1 if all OK
+ */
+uint8_t tsys_getcoeffs(int n){
+    if(n < 0 || n > 1) return 0;
+    tsys_t *s = &sensors[n];
+    s->havecoef = 0;
+    for(int i = 0; i < 5; ++i)
+        if(!tsys_readprom(s->cmd.addr, promregs[i], &s->k[i])) return 0;
+    for(int i = 0; i < 5; ++i){
+        int32_t c = (int32_t)(((uint64_t)s->k[i] * Fq24[i]) >> 16);
+        s->C[i] = (i & 1) ? c : -c; // signs: -, +, -, +, -
     }
-    I2C1->TXDR = data; // send data
+    s->havecoef = 1;
     return 1;
 }
 
 /**
- * read nbytes (2 or 3) of data from I2C line
- * @return 1 if all OK, 0 if NACK or no device found
+ * get cached calibration coefficient
+ * @param n - sensor number
+ * @param i - coefficient index (0..4)
+ * @return k_i or -1 if coefficients wasn't read
  */
-uint8_t read_i2c(uint8_t addr, uint32_t *data, uint8_t nbytes){
-    uint32_t result = 0;
-    cntr = Tms;
-    while(I2C1->ISR & I2C_ISR_BUSY) if(Tms - cntr > 5) return 0;  // check busy
-    cntr = Tms;
-    while(I2C1->CR2 & I2C_CR2_START) if(Tms - cntr > 5) return 0; // check start
-    // read N bytes
-    I2C1->CR2 = (nbytes<<16) | addr | 1 | I2C_CR2_AUTOEND | I2C_CR2_RD_WRN;
-    I2C1->CR2 |= I2C_CR2_START;
-    uint8_t i;
-    cntr = Tms;
-    for(i = 0; i < nbytes; ++i){
-        while(!(I2C1->ISR & I2C_ISR_RXNE)){ // wait for data
-            if(I2C1->ISR & I2C_ISR_NACKF){
-                I2C1->ICR |= I2C_ICR_NACKCF;
-                return 0;
-            }
-            if(Tms - cntr > 5) return 0;
-        }
-        result = (result << 8) | I2C1->RXDR;
-    }
-    *data = result;
+int32_t tsys_coeff(int n, int i){
+    if(n < 0 || n > 1 || i < 0 || i > 4 || !sensors[n].havecoef) return -1;
+    return sensors[n].k[i];
+}
+
+/**
+ * convert ADC value into temperature
+ * @param n - sensor number
+ * @param adc - 24-bit ADC value
+ * @param T (o) - temperature, degC*100
+ * @return 0 if there's no calibration coefficients
+ */
+uint8_t tsys_temperature(int n, uint32_t adc, int32_t *T){
+    if(n < 0 || n > 1 || !sensors[n].havecoef) return 0;
+    const int32_t *C = sensors[n].C;
+    int64_t A = adc >> 8, acc = C[4];
+    for(int i = 3; i >= 0; --i) acc = ((acc * A) >> 16) + C[i];
+    *T = (int32_t)(acc >> 8);
     return 1;
- }
+}
+
+// scheduler callbacks
+static uint8_t tsys_start(int n){
+    return tsys_cmd(n, TSYS01_START_CONV);
+}
+// start command failed: reset sensor, scheduler will try again after pause
+static uint8_t tsys_started(int n){
+    uint8_t st = sensors[n].cmd.status;
+    if(st != I2C_OK && st != I2C_PENDING) tsys_reset(n);
+    return st;
+}
+static uint8_t tsys_read(int n){
+    return tsys_readadc(n);
+}
+// result: T*100 or raw ADC value if there's no coefficients
+static uint8_t tsys_result(int n, int32_t *val){
+    uint32_t adc;
+    uint8_t st = tsys_adcresult(n, &adc);
+    if(st == I2C_OK && !tsys_temperature(n, adc, val)) *val = (int32_t)adc;
+    return st;
+}
 
+// each sensor is separate chip, so they convert simultaneously
+sensor_t tsys_sensors[TSYS_NSENSORS] = {
+    {.start = tsys_start, .started = tsys_started, .read = tsys_read, .result = tsys_result,
+     .convtime = CONV_TIME},
+    {.start = tsys_start, .started = tsys_started, .read = tsys_read, .result = tsys_result,
+     .convtime = CONV_TIME},
+};
 
+/**
+ * read PROM register (waits not more than I2C_TRANS_TMOUT)
+ * @param addr - sensor address
+ * @param reg - register
+ * @param data (o) - value
+ * @return 1 if all OK
+ */
+uint8_t tsys_readprom(uint8_t addr, uint8_t reg, uint16_t *data){
+    uint8_t buf[2];
+    i2c_trans_t t = {.addr = addr, .op = I2C_WRITEREAD, .wlen = 1, .wbuf = &reg, .rlen = 2, .rbuf = buf};
+    if(!i2c_submit(&t)) return 0;
+    if(i2c_wait(&t) != I2C_OK) return 0;
+    *data = (buf[0] << 8) | buf[1];
+    return 1;
+}
@@ -21,6 +21,24 @@
  *
  */
 
+#pragma once
+#ifndef I2C_H__
+#define I2C_H__
+
+#include "stm32f0.h"
+#include "sched.h"
+
+// I2C1_SCL - PA9, I2C1_SDA - PA10 (AF4)
+#define I2C_GPIO                GPIOA
+#define I2C_SCL                 (9)
+#define I2C_SDA                 (10)
+#define I2C_AF                  (4)
+// SCL/SDA are opendrain (pull-ups on board), 0 - push-pull
+#define I2C_OPENDRAIN           (1)
+// Clock = 6MHz, 0.16(6)us, need 5us (*30)
+// PRESC=4 (f/5), SCLDEL=0 (t_SU=5/6us), SDADEL=0 (t_HD=5/6us), SCLL,SCLH=14 (2.(3)us)
+#define I2C_TIMING              ((4<<28) | (14<<8) | (14)) // 0x40000e0e
+
 // CSB=1, address 1110110
 #define TSYS01_ADDR0            (0x76 << 1)
 // CSB=0, address 1110111
@@ -32,8 +50,20 @@
 #define TSYS01_PROM_ADDR0       (0xA0)
 // conversion time = 10ms
 #define CONV_TIME               (10)
+// time after reset to PROM reading, ms (2.8ms by datasheet)
+#define RESET_TIME              (3)
+// amount of sensors
+#define TSYS_NSENSORS           (2)
+
+extern sensor_t tsys_sensors[TSYS_NSENSORS];
 
-void i2c_setup();
+uint8_t tsys_cmd(int n, uint8_t data);
+uint8_t tsys_reset(int n);
+uint8_t tsys_readadc(int n);
+uint8_t tsys_adcresult(int n, uint32_t *data);
+uint8_t tsys_readprom(uint8_t addr, uint8_t reg, uint16_t *data);
+uint8_t tsys_getcoeffs(int n);
+int32_t tsys_coeff(int n, int i);
+uint8_t tsys_temperature(int n, uint32_t adc, int32_t *T);
 
-uint8_t read_i2c(uint8_t addr, uint32_t *data, uint8_t nbytes);
-uint8_t write_i2c(uint8_t addr, uint8_t data);
+#endif // I2C_H__
@@ -0,0 +1,332 @@
+/*
+ * This file is part of the stm32samples project.
+ * Copyright 2019 Edward V. Emelianov <edward.emelianoff@gmail.com>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Non-blocking I2C1 master: transactions are queued by i2c_submit() and
+ * processed in I2C1 interrupt; data bytes are moved by DMA
+ * (I2C1_TX - DMA1 channel 2, I2C1_RX - DMA1 channel 3).
+ * i2c_process() should be called from main loop: it checks timeouts and
+ * restores hung bus by 9 clocks on SCL and STOP condition. Recovery is made
+ * by one SCL half-period per i2c_process() call, so interrupt handler only
+ * stops peripheral and queue waits until bus is free.
+ * Pins and timing are defined in i2c.h:
+ *      I2C_GPIO, I2C_SCL, I2C_SDA - port and pin numbers
+ *      I2C_AF                     - alternate function number
+ *      I2C_TIMING                 - TIMINGR value
+ */
+
+#include "i2c.h"
+#include "i2cdma.h"
+
+extern volatile uint32_t Tms;
+
+static i2c_trans_t *queue[I2C_QUEUE_LEN];
+static volatile uint8_t qhead = 0, qtail = 0;
+static i2c_trans_t * volatile cur = NULL;   // current transaction
+static volatile uint32_t tstart;            // its start time
+static uint8_t rawidx;                      // index of next byte in I2C_RAW mode
+static uint8_t nacked;                      // NACK received, wait for STOP
+static i2c_stat_t stats[I2C_MAXDEV];
+static volatile uint8_t rcvstep = 0;        // bus recovery step (RCV_IDLE - bus is OK)
+static uint8_t rcvclk;                      // SCL clocks made by recovery
+
+// bus recovery steps
+enum{
+    RCV_IDLE,
+    RCV_START,      // pins -> GPIO
+    RCV_SCLLOW,     // SCL=0 if slave still holds SDA (no more than 9 clocks)
+    RCV_SCLHIGH,    // SCL=1
+    RCV_STOP1,      // STOP: SCL=0
+    RCV_STOP2,      //       SDA=0
+    RCV_STOP3,      //       SCL=1
+    RCV_STOP4,      //       SDA=1
+    RCV_DONE        // pins -> I2C, run queue
+};
+
+#define CR1_IRQS    (I2C_CR1_TCIE | I2C_CR1_STOPIE | I2C_CR1_NACKIE | I2C_CR1_ERRIE)
+#define AFSHIFT(p)  (((p) & 7) * 4)
+
+static void pins_af(){
+    I2C_GPIO->AFR[I2C_SCL >> 3] = (I2C_GPIO->AFR[I2C_SCL >> 3] & ~(0xf << AFSHIFT(I2C_SCL)))
+                                | (I2C_AF << AFSHIFT(I2C_SCL));
+    I2C_GPIO->AFR[I2C_SDA >> 3] = (I2C_GPIO->AFR[I2C_SDA >> 3] & ~(0xf << AFSHIFT(I2C_SDA)))
+                                | (I2C_AF << AFSHIFT(I2C_SDA));
+#if I2C_OPENDRAIN
+    I2C_GPIO->OTYPER |= (1 << I2C_SCL) | (1 << I2C_SDA); // opendrain
+#endif
+    I2C_GPIO->MODER = (I2C_GPIO->MODER & ~((3 << (I2C_SCL*2)) | (3 << (I2C_SDA*2))))
+                    | (2 << (I2C_SCL*2)) | (2 << (I2C_SDA*2));
+}
+
+// pins as outputs (of type set by pins_af()) for bus recovery
+static void pins_od(){
+    I2C_GPIO->BSRR = (1 << I2C_SCL) | (1 << I2C_SDA);
+    I2C_GPIO->MODER = (I2C_GPIO->MODER & ~((3 << (I2C_SCL*2)) | (3 << (I2C_SDA*2))))
+                    | (1 << (I2C_SCL*2)) | (1 << (I2C_SDA*2));
+}
+
+// ~5us
+static void i2c_delay(){
+    for(volatile int i = 0; i < 20; ++i) nop();
+}
+
+void i2c_setup(){
+    I2C1->CR1 = 0;
+    RCC->AHBENR |= RCC_AHBENR_DMA1EN;
+    RCC->APB1ENR |= RCC_APB1ENR_I2C1EN;
+    RCC->CFGR3 |= RCC_CFGR3_I2C1SW; // use sysclock for timing
+    pins_af();
+    I2C1->TIMINGR = I2C_TIMING;
+    DMA1_Channel2->CPAR = (uint32_t)&I2C1->TXDR;
+    DMA1_Channel2->CCR = DMA_CCR_MINC | DMA_CCR_DIR; // 8bit, mem++, mem->per
+    DMA1_Channel3->CPAR = (uint32_t)&I2C1->RXDR;
+    DMA1_Channel3->CCR = DMA_CCR_MINC; // 8bit, mem++, per->mem
+    I2C1->CR1 = I2C_CR1_PE | CR1_IRQS;
+    NVIC_SetPriority(I2C1_IRQn, 2);
+    NVIC_EnableIRQ(I2C1_IRQn);
+}
+
+// find or allocate statistics record; return NULL if table is full
+static i2c_stat_t *findstat(uint8_t addr, uint8_t alloc){
+    for(int i = 0; i < I2C_MAXDEV; ++i){
+        if(stats[i].addr == addr) return &stats[i];
+        if(stats[i].addr == 0){
+            if(!alloc) return NULL;
+            stats[i].addr = addr;
+            return &stats[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief i2c_getstat - get device statistics
+ * @param addr - device address
+ * @return NULL if there was no transactions with this device
+ */
+const i2c_stat_t *i2c_getstat(uint8_t addr){
+    return findstat(addr & 0xfe, 0);
+}
+
+// start writing phase
+static void start_write(){
+    DMA1_Channel2->CCR &= ~DMA_CCR_EN;
+    DMA1_Channel2->CMAR = (uint32_t)cur->wbuf;
+    DMA1_Channel2->CNDTR = cur->wlen;
+    DMA1_Channel2->CCR |= DMA_CCR_EN;
+    I2C1->CR1 |= I2C_CR1_TXDMAEN;
+    uint32_t cr2 = cur->addr | (cur->wlen << 16);
+    if(cur->op == I2C_WRITE) cr2 |= I2C_CR2_AUTOEND;
+    I2C1->CR2 = cr2 | I2C_CR2_START;
+}
+
+// start reading phase (or repeated start after writing)
+static void start_read(){
+    DMA1_Channel3->CCR &= ~DMA_CCR_EN;
+    DMA1_Channel3->CMAR = (uint32_t)cur->rbuf;
+    DMA1_Channel3->CNDTR = cur->rlen;
+    DMA1_Channel3->CCR |= DMA_CCR_EN;
+    I2C1->CR1 |= I2C_CR1_RXDMAEN;
+    I2C1->CR2 = cur->addr | I2C_CR2_RD_WRN | (cur->rlen << 16) | I2C_CR2_AUTOEND | I2C_CR2_START;
+}
+
+// send next byte as address in I2C_RAW mode
+static void start_raw(){
+    uint8_t byte = cur->wbuf[rawidx++];
+    uint32_t cr2 = byte;
+    if(byte & 1) cr2 |= I2C_CR2_RD_WRN;
+    I2C1->CR2 = cr2 | I2C_CR2_START;
+}
+
+// start next transaction from queue; I2C interrupt should be disabled or we are in it
+static void start_next(){
+    if(cur || rcvstep || qhead == qtail) return;
+    cur = queue[qhead];
+    qhead = (qhead + 1) & (I2C_QUEUE_LEN - 1);
+    tstart = Tms;
+    nacked = 0;
+    I2C1->ICR = I2C_ICR_NACKCF | I2C_ICR_STOPCF | I2C_ICR_BERRCF | I2C_ICR_ARLOCF | I2C_ICR_OVRCF;
+    switch(cur->op){
+        case I2C_READ:
+            start_read();
+        break;
+        case I2C_RAW:
+            rawidx = 0;
+            start_raw();
+        break;
+        default: // I2C_WRITE, I2C_WRITEREAD
+            start_write();
+        break;
+    }
+}
+
+// finish current transaction & start next
+static void finish(i2c_status_t status){
+    DMA1_Channel2->CCR &= ~DMA_CCR_EN;
+    DMA1_Channel3->CCR &= ~DMA_CCR_EN;
+    I2C1->CR1 &= ~(I2C_CR1_TXDMAEN | I2C_CR1_RXDMAEN);
+    i2c_trans_t *t = cur;
+    cur = NULL;
+    if(!t) return;
+    i2c_stat_t *s = findstat(t->addr & 0xfe, 1);
+    if(s) switch(status){
+        case I2C_OK: ++s->ok; break;
+        case I2C_NACK: ++s->nack; break;
+        case I2C_BUSERR: ++s->buserr; break;
+        default: ++s->timeout; break;
+    }
+    t->status = status;
+    if(t->cb) t->cb(t);
+    start_next();
+}
+
+// stop peripheral, abort current transaction and leave bus recovery to i2c_process()
+static void recover(i2c_status_t status){
+    I2C1->CR1 = 0;
+    rcvstep = RCV_START;
+    finish(status);
+}
+
+/**
+ * @brief i2c_unstick - restore hung bus: 9 clocks on SCL until slave releases SDA, then STOP
+ * (recovery is made by i2c_process(), current transaction fails with I2C_BUSERR)
+ */
+void i2c_unstick(){
+    NVIC_DisableIRQ(I2C1_IRQn);
+    if(!rcvstep) recover(I2C_BUSERR);
+    NVIC_EnableIRQ(I2C1_IRQn);
+}
+
+// next step of bus recovery, not less than 5us each
+static void unstick_step(){
+    switch(rcvstep){
+        case RCV_START:
+            pins_od();
+            rcvclk = 0;
+            rcvstep = RCV_SCLLOW;
+        break;
+        case RCV_SCLLOW:
+            if(rcvclk == 9 || (I2C_GPIO->IDR & (1 << I2C_SDA))) rcvstep = RCV_STOP1;
+            else{
+                I2C_GPIO->BRR = 1 << I2C_SCL;
+                rcvstep = RCV_SCLHIGH;
+            }
+        break;
+        case RCV_SCLHIGH:
+            I2C_GPIO->BSRR = 1 << I2C_SCL;
+            ++rcvclk;
+            rcvstep = RCV_SCLLOW;
+        break;
+        // STOP: SDA 0->1 while SCL=1
+        case RCV_STOP1:
+            I2C_GPIO->BRR = 1 << I2C_SCL;
+            ++rcvstep;
+        break;
+        case RCV_STOP2:
+            I2C_GPIO->BRR = 1 << I2C_SDA;
+            ++rcvstep;
+        break;
+        case RCV_STOP3:
+            I2C_GPIO->BSRR = 1 << I2C_SCL;
+            ++rcvstep;
+        break;
+        case RCV_STOP4:
+            I2C_GPIO->BSRR = 1 << I2C_SDA;
+            ++rcvstep;
+        break;
+        default: // RCV_DONE
+            pins_af();
+            NVIC_DisableIRQ(I2C1_IRQn);
+            I2C1->CR1 = I2C_CR1_PE | CR1_IRQS;
+            rcvstep = RCV_IDLE;
+            start_next();
+            NVIC_EnableIRQ(I2C1_IRQn);
+            return;
+    }
+    i2c_delay();
+}
+
+/**
+ * @brief i2c_submit - add transaction to queue
+ * @param t - transaction (shouldn't be changed until its status is I2C_PENDING)
+ * @return 0 if queue is full
+ */
+int i2c_submit(i2c_trans_t *t){
+    uint8_t nxt = (qtail + 1) & (I2C_QUEUE_LEN - 1);
+    if(nxt == qhead) return 0;
+    if((t->op == I2C_RAW || t->op == I2C_WRITEREAD) && t->wlen == 0) return 0;
+    t->status = I2C_PENDING;
+    queue[qtail] = t;
+    NVIC_DisableIRQ(I2C1_IRQn);
+    qtail = nxt;
+    start_next();
+    NVIC_EnableIRQ(I2C1_IRQn);
+    return 1;
+}
+
+/**
+ * @brief i2c_process - check timeouts & restore bus, should be called from main loop
+ */
+void i2c_process(){
+    if(rcvstep){
+        unstick_step();
+        return;
+    }
+    if(!cur || Tms - tstart <= I2C_TRANS_TMOUT) return;
+    NVIC_DisableIRQ(I2C1_IRQn);
+    if(cur && Tms - tstart > I2C_TRANS_TMOUT) recover(I2C_TIMEOUT);
+    NVIC_EnableIRQ(I2C1_IRQn);
+}
+
+/**
+ * @brief i2c_wait - wait for transaction end (not more than I2C_TRANS_TMOUT after its start)
+ * @param t - transaction
+ * @return its status
+ */
+i2c_status_t i2c_wait(i2c_trans_t *t){
+    while(t->status == I2C_PENDING) i2c_process();
+    return t->status;
+}
+
+void i2c1_isr(){
+    uint32_t isr = I2C1->ISR;
+    if(!cur){ // spurious interrupt
+        I2C1->ICR = I2C_ICR_NACKCF | I2C_ICR_STOPCF | I2C_ICR_BERRCF | I2C_ICR_ARLOCF | I2C_ICR_OVRCF;
+        return;
+    }
+    if(isr & (I2C_ISR_BERR | I2C_ISR_ARLO | I2C_ISR_OVR)){
+        I2C1->ICR = I2C_ICR_BERRCF | I2C_ICR_ARLOCF | I2C_ICR_OVRCF;
+        recover(I2C_BUSERR);
+        return;
+    }
+    if(isr & I2C_ISR_NACKF){
+        I2C1->ICR = I2C_ICR_NACKCF;
+        nacked = 1;
+        if(!(I2C1->CR2 & I2C_CR2_AUTOEND)) I2C1->CR2 |= I2C_CR2_STOP;
+    }
+    if(isr & I2C_ISR_STOPF){
+        I2C1->ICR = I2C_ICR_STOPCF;
+        finish(nacked ? I2C_NACK : I2C_OK);
+        return;
+    }
+    if(isr & I2C_ISR_TC){ // end of writing phase without AUTOEND
+        if(cur->op == I2C_WRITEREAD) start_read();
+        else if(cur->op == I2C_RAW && rawidx < cur->wlen) start_raw();
+        else I2C1->CR2 |= I2C_CR2_STOP;
+    }
+}
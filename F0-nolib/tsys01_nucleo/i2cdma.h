@@ -0,0 +1,81 @@
+/*
+ * This file is part of the stm32samples project.
+ * Copyright 2019 Edward V. Emelianov <edward.emelianoff@gmail.com>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef I2CDMA_H__
+#define I2CDMA_H__
+
+#include "stm32f0.h"
+
+// transactions queue length (power of 2)
+#define I2C_QUEUE_LEN       (8)
+// max amount of devices in statistics table
+#define I2C_MAXDEV          (4)
+// transaction timeout, ms
+#define I2C_TRANS_TMOUT     (5)
+
+// transaction types
+typedef enum{
+    I2C_WRITE,      // write wbuf
+    I2C_READ,       // read rbuf
+    I2C_WRITEREAD,  // write wbuf, repeated start, read rbuf
+    I2C_RAW         // each byte of wbuf sent as address with repeated starts (TM1637)
+} i2c_op_t;
+
+// transaction status
+typedef enum{
+    I2C_OK,         // done (or never started)
+    I2C_PENDING,    // in queue or in progress
+    I2C_NACK,       // device not answered
+    I2C_BUSERR,     // bus error or arbitration lost
+    I2C_TIMEOUT
+} i2c_status_t;
+
+typedef struct i2c_trans i2c_trans_t;
+// completion callback, runs in interrupt context
+typedef void (*i2c_cb_t)(i2c_trans_t *t);
+
+// transaction lives in caller's memory until status != I2C_PENDING
+struct i2c_trans{
+    uint8_t addr;           // 8-bit address (7-bit << 1)
+    uint8_t op;             // i2c_op_t
+    uint8_t wlen;           // length of wbuf
+    uint8_t rlen;           // length of rbuf
+    const uint8_t *wbuf;
+    uint8_t *rbuf;
+    i2c_cb_t cb;            // called when transaction done (or NULL)
+    void *arg;              // user data for callback
+    volatile uint8_t status;// i2c_status_t
+};
+
+// per-device statistics
+typedef struct{
+    uint8_t addr;
+    uint32_t ok;
+    uint32_t nack;
+    uint32_t buserr;
+    uint32_t timeout;
+} i2c_stat_t;
+
+void i2c_setup();
+int i2c_submit(i2c_trans_t *t);
+void i2c_process();
+i2c_status_t i2c_wait(i2c_trans_t *t);
+void i2c_unstick();
+const i2c_stat_t *i2c_getstat(uint8_t addr);
+
+#endif // I2CDMA_H__
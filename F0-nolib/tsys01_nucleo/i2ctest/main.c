@@ -0,0 +1,403 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "i2c.h"
+#include "i2cdma.h"
+
+/*
+ * Model of I2C1, DMA1 channels 2/3 and slaves on I2C_SCL/I2C_SDA pins for ../i2cdma.c.
+ * Time step is 1us, main loop calls i2c_process() each 5us. Peripheral starts
+ * transfer when START bit in CR2 is set, one byte on bus (with ACK) takes 90us;
+ * at the end it sets ISR flags and calls i2c1_isr() if its interrupt is enabled
+ * in NVIC and CR1 (as NVIC does). As in real STM32 STOP is sent automatically
+ * after NACK. Slave holding SDA doesn't allow START, so transfer hangs.
+ * When pins are GPIO outputs model follows SCL/SDA levels: counts SCL clocks
+ * (slave releases SDA after given amount of them) and STOP conditions.
+ * Interrupt handler should never touch pins.
+ */
+
+I2C_TypeDef sim_I2C1;
+DMA_Channel_TypeDef sim_DMA1_Channel2, sim_DMA1_Channel3;
+GPIO_TypeDef sim_GPIOA;
+RCC_TypeDef sim_RCC;
+volatile uint32_t Tms = 0;
+
+#define BYTE_US     (90)
+#define LOOP_US     (5)
+
+#define CHECK(cond, ...) do{ if(!(cond)){ printf("\t"); printf(__VA_ARGS__); printf("\n"); ++errors; } }while(0)
+
+static int errors = 0;
+static uint64_t now = 0;        // time, us
+static int irq_on = 0;          // I2C1_IRQn enabled in NVIC
+
+void NVIC_SetPriority(int irq, uint32_t prio){ (void)irq; (void)prio; }
+void NVIC_EnableIRQ(int irq){ if(irq == I2C1_IRQn) irq_on = 1; }
+void NVIC_DisableIRQ(int irq){ if(irq == I2C1_IRQn) irq_on = 0; }
+
+typedef struct{
+    uint8_t addr;       // 8-bit address (0 - answers to any address & logs it, like TM1637)
+    uint8_t rx[16];     // data written (or addresses in "any address" mode)
+    int nrx;
+    int nack_at;        // NACK on this data byte (from 1, 0 - never)
+    int berr;           // bus error on next transfer
+    int hold;           // hold SDA low after next transfer for this amount of SCL clocks
+} slave;
+
+// TSYS01-like: read returns bytes "last command + i"
+static slave tsys = {.addr = TSYS01_ADDR0};
+static slave tm1637 = {.addr = 0};
+static slave *slaves[] = {&tsys, &tm1637};
+static int rawmode = 0; // tm1637 is on bus
+
+// bus state
+static int busy = 0;            // transfer in progress
+static uint64_t busy_until;     // its end
+static uint32_t pend;           // ISR flags at end of transfer
+static int waitstop = 0;        // TC was set, waiting for STOP or repeated START
+static slave *holder = NULL;    // slave which will hold SDA after STOP
+static int sda_hold = 0;        // SCL clocks until slave releases SDA
+// pins in GPIO mode
+static int scl = 1, sda = 1;
+static int clocks = 0, stops = 0;
+
+static slave *findslave(uint8_t addr){
+    for(size_t i = 0; i < sizeof(slaves)/sizeof(slaves[0]); ++i){
+        if(slaves[i]->addr == addr) return slaves[i];
+        if(slaves[i]->addr == 0 && rawmode) return slaves[i];
+    }
+    return NULL;
+}
+
+static int pinmode(int pin){ return (GPIOA->MODER >> (pin*2)) & 3; }
+
+// bus stop: slave which should hold SDA starts to do it
+static void busstop(){
+    waitstop = 0;
+    if(holder){
+        sda_hold = holder->hold;
+        holder->hold = 0;
+        holder = NULL;
+    }
+}
+
+// check DMA channel for transfer of n bytes, return its buffer
+static uint8_t *dmabuf(DMA_Channel_TypeDef *ch, volatile uint32_t *reg, uint32_t dmaen, int dir, int n){
+    CHECK(ch->CCR & DMA_CCR_EN, "t=%llu: DMA channel for %s is off", (unsigned long long)now, dir ? "TX" : "RX");
+    CHECK(I2C1->CR1 & dmaen, "t=%llu: I2C DMA requests are off", (unsigned long long)now);
+    CHECK(!!(ch->CCR & DMA_CCR_DIR) == dir && (ch->CCR & DMA_CCR_MINC), "DMA CCR=0x%x", (unsigned)ch->CCR);
+    CHECK(ch->CPAR == (uint32_t)(uintptr_t)reg, "wrong DMA peripheral address");
+    CHECK((int)ch->CNDTR == n, "DMA CNDTR=%u, NBYTES=%d", (unsigned)ch->CNDTR, n);
+    ch->CNDTR = 0;
+    return (uint8_t*)(uintptr_t)ch->CMAR;
+}
+
+// START: address phase and data
+static void transfer(uint32_t cr2){
+    uint8_t addr = cr2 & 0xfe;
+    int rd = !!(cr2 & I2C_CR2_RD_WRN), n = (cr2 & I2C_CR2_NBYTES) >> 16;
+    slave *s = findslave(addr);
+    busy = 1;
+    busy_until = now + BYTE_US;
+    waitstop = 0;
+    if(!s){
+        pend = I2C_ISR_NACKF | I2C_ISR_STOPF;
+        return;
+    }
+    if(s->berr){
+        s->berr = 0;
+        pend = I2C_ISR_BERR;
+        return;
+    }
+    if(s->addr == 0){
+        if(s->nrx < 16) s->rx[s->nrx++] = addr | rd;
+    }else if(rd){
+        uint8_t *buf = dmabuf(DMA1_Channel3, &I2C1->RXDR, I2C_CR1_RXDMAEN, 0, n);
+        for(int i = 0; i < n; ++i) buf[i] = s->rx[0] + i;
+    }else{
+        uint8_t *buf = dmabuf(DMA1_Channel2, &I2C1->TXDR, I2C_CR1_TXDMAEN, 1, n);
+        if(s->nack_at && s->nack_at <= n) n = s->nack_at;
+        for(int i = 0; i < n && i < 16; ++i) s->rx[i] = buf[i];
+        s->nrx = n;
+        if(s->nack_at && s->nack_at == n){
+            busy_until += BYTE_US * n;
+            pend = I2C_ISR_NACKF | I2C_ISR_STOPF;
+            return;
+        }
+    }
+    busy_until += BYTE_US * n;
+    if(s->hold) holder = s;
+    pend = (cr2 & I2C_CR2_AUTOEND) ? I2C_ISR_STOPF : I2C_ISR_TC;
+}
+
+// GPIO: BSRR/BRR -> ODR -> bus levels -> IDR
+static void gpio(){
+    GPIO_TypeDef *g = GPIOA;
+    g->ODR |= g->BSRR & 0xffff;
+    g->ODR &= ~(g->BSRR >> 16);
+    g->ODR &= ~g->BRR;
+    g->BSRR = 0; g->BRR = 0;
+    int nscl = (pinmode(I2C_SCL) == 1) ? !!(g->ODR & (1 << I2C_SCL)) : 1;
+    if(!scl && nscl){
+        ++clocks;
+        if(sda_hold) --sda_hold;
+    }
+    int nsda = ((pinmode(I2C_SDA) == 1) ? !!(g->ODR & (1 << I2C_SDA)) : 1) && !sda_hold;
+    if(scl && nscl && !sda && nsda) ++stops;
+    scl = nscl; sda = nsda;
+    g->IDR = (scl << I2C_SCL) | (sda << I2C_SDA);
+}
+
+static void periph(){
+    I2C_TypeDef *i = I2C1;
+    gpio();
+    i->ISR &= ~i->ICR;
+    i->ICR = 0;
+    if(!(i->CR1 & I2C_CR1_PE)){ // software reset
+        i->ISR = 0;
+        i->CR2 &= ~(I2C_CR2_START | I2C_CR2_STOP);
+        busy = 0; waitstop = 0;
+        return;
+    }
+    if((i->CR2 & I2C_CR2_START) && !busy && !sda_hold){
+        CHECK(pinmode(I2C_SCL) == 2 && pinmode(I2C_SDA) == 2, "t=%llu: START while pins aren't in AF mode",
+            (unsigned long long)now);
+        uint32_t cr2 = i->CR2;
+        i->CR2 &= ~I2C_CR2_START;
+        i->ISR &= ~I2C_ISR_TC;
+        transfer(cr2);
+    }
+    if((i->CR2 & I2C_CR2_STOP) && !busy){
+        i->CR2 &= ~I2C_CR2_STOP;
+        i->ISR &= ~I2C_ISR_TC;
+        if(waitstop){
+            busy = 1;
+            busy_until = now + 10;
+            pend = I2C_ISR_STOPF;
+        }
+    }
+    if(busy && now >= busy_until){
+        busy = 0;
+        i->ISR |= pend;
+        if(pend & I2C_ISR_STOPF) busstop();
+        else if(pend & I2C_ISR_TC) waitstop = 1;
+    }
+    // interrupt
+    uint32_t mask = 0;
+    if(i->CR1 & I2C_CR1_TCIE) mask |= I2C_ISR_TC;
+    if(i->CR1 & I2C_CR1_STOPIE) mask |= I2C_ISR_STOPF;
+    if(i->CR1 & I2C_CR1_NACKIE) mask |= I2C_ISR_NACKF;
+    if(i->CR1 & I2C_CR1_ERRIE) mask |= I2C_ISR_BERR | I2C_ISR_ARLO | I2C_ISR_OVR;
+    for(int n = 0; irq_on && (i->ISR & mask); ++n){
+        if(n == 10){
+            CHECK(0, "t=%llu: interrupt storm, ISR=0x%x", (unsigned long long)now, (unsigned)i->ISR);
+            break;
+        }
+        uint32_t moder = GPIOA->MODER;
+        i2c1_isr();
+        CHECK(moder == GPIOA->MODER && !GPIOA->BSRR && !GPIOA->BRR, "t=%llu: i2c1_isr() touches pins",
+            (unsigned long long)now);
+        i->ISR &= ~i->ICR;
+        i->ICR = 0;
+        // START or STOP clears TC
+        if(i->CR2 & (I2C_CR2_START | I2C_CR2_STOP)) i->ISR &= ~I2C_ISR_TC;
+        if(i->CR1 & I2C_CR1_PE) continue;
+        i->ISR = 0;
+        busy = 0;
+    }
+}
+
+static void step(){
+    ++now;
+    if(now % 1000 == 0) ++Tms;
+    periph();
+    if(now % LOOP_US == 0) i2c_process();
+}
+
+// wait for end of transaction, return its status
+static int wait(i2c_trans_t *t, int ms){
+    uint64_t end = now + ms * 1000;
+    while(t->status == I2C_PENDING && now < end) step();
+    CHECK(t->status != I2C_PENDING, "transaction hangs");
+    return t->status;
+}
+
+// run model for given time
+static void idle(int ms){
+    uint64_t end = now + ms * 1000;
+    while(now < end) step();
+}
+
+static const char *stname(int s){
+    static const char *names[] = {"OK", "PENDING", "NACK", "BUSERR", "TIMEOUT"};
+    if(s < 0 || s > I2C_TIMEOUT) return "?";
+    return names[s];
+}
+
+#define STATUS(t, s) CHECK((t)->status == (s), "status %s, should be %s", stname((t)->status), stname(s))
+
+static int cbord[16], ncb = 0;
+static void cb(i2c_trans_t *t){
+    if(ncb < 16) cbord[ncb++] = (int)(intptr_t)t->arg;
+}
+
+static uint8_t cmd[4], buf[8][4];
+static i2c_trans_t tr[10];
+
+static void mktrans(i2c_trans_t *t, uint8_t addr, uint8_t op, uint8_t wlen, uint8_t rlen, uint8_t *rbuf, int id){
+    memset(t, 0, sizeof(i2c_trans_t));
+    t->addr = addr; t->op = op;
+    t->wlen = wlen; t->rlen = rlen;
+    t->wbuf = cmd; t->rbuf = rbuf;
+    t->cb = cb; t->arg = (void*)(intptr_t)id;
+}
+
+static void t_writeread(){
+    printf("write command, repeated start, read\n");
+    cmd[0] = TSYS01_PROM_ADDR0 + 2;
+    mktrans(&tr[0], TSYS01_ADDR0, I2C_WRITEREAD, 1, 2, buf[0], 1);
+    ncb = 0;
+    CHECK(i2c_submit(&tr[0]), "can't submit");
+    wait(&tr[0], 10);
+    STATUS(&tr[0], I2C_OK);
+    CHECK(buf[0][0] == 0xA2 && buf[0][1] == 0xA3, "read 0x%02x 0x%02x", buf[0][0], buf[0][1]);
+    CHECK(ncb == 1 && cbord[0] == 1, "callback called %d times", ncb);
+}
+
+static void t_queue(){
+    printf("queue order and overflow\n");
+    ncb = 0;
+    int n = 0;
+    for(int i = 0; i < I2C_QUEUE_LEN; ++i){
+        mktrans(&tr[i], TSYS01_ADDR0, (i & 1) ? I2C_READ : I2C_WRITE, 1, 3, buf[i], i);
+        n += i2c_submit(&tr[i]);
+    }
+    // first one is in progress, queue holds I2C_QUEUE_LEN-1
+    CHECK(n == I2C_QUEUE_LEN, "submitted %d of %d", n, I2C_QUEUE_LEN);
+    mktrans(&tr[8], TSYS01_ADDR0, I2C_WRITE, 1, 0, NULL, 8);
+    CHECK(!i2c_submit(&tr[8]), "queue overflow not detected");
+    wait(&tr[I2C_QUEUE_LEN - 1], 20);
+    for(int i = 0; i < I2C_QUEUE_LEN; ++i) STATUS(&tr[i], I2C_OK);
+    CHECK(ncb == I2C_QUEUE_LEN, "%d callbacks", ncb);
+    for(int i = 0; i < ncb; ++i) CHECK(cbord[i] == i, "callback %d for transaction %d", i, cbord[i]);
+}
+
+static void t_nack(){
+    printf("absent device and NACK on data\n");
+    mktrans(&tr[0], TSYS01_ADDR1, I2C_WRITE, 1, 0, NULL, 0);
+    i2c_submit(&tr[0]);
+    wait(&tr[0], 10);
+    STATUS(&tr[0], I2C_NACK);
+    cmd[0] = TSYS01_RESET; cmd[1] = 1; cmd[2] = 2;
+    tsys.nack_at = 2;
+    mktrans(&tr[1], TSYS01_ADDR0, I2C_WRITEREAD, 3, 2, buf[1], 1);
+    mktrans(&tr[2], TSYS01_ADDR0, I2C_WRITE, 1, 0, NULL, 2);
+    i2c_submit(&tr[1]);
+    i2c_submit(&tr[2]);
+    wait(&tr[1], 10);
+    STATUS(&tr[1], I2C_NACK);
+    CHECK(tsys.nrx == 2, "slave got %d bytes, should be 2", tsys.nrx);
+    tsys.nack_at = 0;
+    wait(&tr[2], 10);
+    STATUS(&tr[2], I2C_OK);
+}
+
+static void t_buserr(){
+    printf("bus error: recovery in main loop, then queue goes on\n");
+    tsys.berr = 1;
+    cmd[0] = TSYS01_ADC_READ;
+    mktrans(&tr[0], TSYS01_ADDR0, I2C_WRITEREAD, 1, 3, buf[0], 0);
+    mktrans(&tr[1], TSYS01_ADDR0, I2C_WRITEREAD, 1, 3, buf[1], 1);
+    i2c_submit(&tr[0]);
+    i2c_submit(&tr[1]);
+    int st = stops;
+    wait(&tr[0], 10);
+    STATUS(&tr[0], I2C_BUSERR);
+    CHECK(tr[1].status == I2C_PENDING, "next transaction ended before bus recovery");
+    wait(&tr[1], 10);
+    STATUS(&tr[1], I2C_OK);
+    CHECK(stops == st + 1, "%d STOP conditions on recovery", stops - st);
+}
+
+static void t_stuck(int hold, int ntmout){
+    printf("slave holds SDA for %d clocks: %d timeout(s), recovery\n", hold, ntmout);
+    cmd[0] = TSYS01_START_CONV;
+    mktrans(&tr[0], TSYS01_ADDR0, I2C_WRITE, 1, 0, NULL, 0);
+    tsys.hold = hold;
+    i2c_submit(&tr[0]);
+    wait(&tr[0], 10);
+    STATUS(&tr[0], I2C_OK);
+    CHECK(sda_hold == hold, "SDA isn't held");
+    int cl = clocks, st = stops;
+    for(int i = 0; i < ntmout; ++i){
+        uint32_t T0 = Tms;
+        mktrans(&tr[1], TSYS01_ADDR0, I2C_WRITE, 1, 0, NULL, 1);
+        i2c_submit(&tr[1]);
+        wait(&tr[1], 20);
+        STATUS(&tr[1], I2C_TIMEOUT);
+        CHECK(Tms - T0 > I2C_TRANS_TMOUT, "timeout after %u ms", Tms - T0);
+    }
+    mktrans(&tr[2], TSYS01_ADDR0, I2C_WRITEREAD, 1, 3, buf[2], 2);
+    i2c_submit(&tr[2]);
+    wait(&tr[2], 20);
+    STATUS(&tr[2], I2C_OK);
+    // last recovery ends with STOP: one more clock
+    CHECK(clocks - cl == hold + 1, "%d SCL clocks on recovery, should be %d", clocks - cl, hold + 1);
+    // STOP impossible while SDA is held
+    CHECK(stops - st == 1, "%d STOP conditions on recovery", stops - st);
+}
+
+static void t_raw(){
+    printf("raw mode: each byte as address with repeated start\n");
+    rawmode = 1;
+    cmd[0] = 0x40; cmd[1] = 0xC1; cmd[2] = 0x88;
+    mktrans(&tr[0], 0x40, I2C_RAW, 3, 0, NULL, 0);
+    i2c_submit(&tr[0]);
+    wait(&tr[0], 10);
+    STATUS(&tr[0], I2C_OK);
+    CHECK(tm1637.nrx == 3 && !memcmp(tm1637.rx, cmd, 3), "got %d bytes: 0x%02x 0x%02x 0x%02x",
+        tm1637.nrx, tm1637.rx[0], tm1637.rx[1], tm1637.rx[2]);
+    rawmode = 0;
+}
+
+static void t_unstick(){
+    printf("i2c_unstick() from main loop\n");
+    int st = stops;
+    i2c_unstick();
+    cmd[0] = TSYS01_ADC_READ;
+    mktrans(&tr[0], TSYS01_ADDR0, I2C_WRITEREAD, 1, 3, buf[0], 0);
+    i2c_submit(&tr[0]);
+    wait(&tr[0], 10);
+    STATUS(&tr[0], I2C_OK);
+    CHECK(stops == st + 1, "%d STOP conditions on recovery", stops - st);
+}
+
+static void t_stat(){
+    printf("statistics\n");
+    const i2c_stat_t *s = i2c_getstat(TSYS01_ADDR0);
+    CHECK(s && s->ok == 16 && s->nack == 1 && s->buserr == 1 && s->timeout == 3,
+        "TSYS01: ok=%u, nack=%u, buserr=%u, timeout=%u", s ? s->ok : 0, s ? s->nack : 0,
+        s ? s->buserr : 0, s ? s->timeout : 0);
+    s = i2c_getstat(TSYS01_ADDR1);
+    CHECK(s && s->nack == 1 && s->ok == 0, "absent device statistics");
+}
+
+int main(){
+    GPIOA->IDR = (1 << I2C_SCL) | (1 << I2C_SDA);
+    i2c_setup();
+    CHECK(I2C1->CR1 & I2C_CR1_PE, "I2C isn't enabled");
+    t_writeread();
+    t_queue();
+    t_nack();
+    t_buserr();
+    t_stuck(5, 1);
+    t_stuck(12, 2);
+    t_raw();
+    t_unstick();
+    idle(10);
+    t_stat();
+    if(errors) printf("%d errors\n", errors);
+    else printf("All OK\n");
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * This file is part of the stm32samples project.
+ * Copyright 2019 Edward V. Emelianov <edward.emelianoff@gmail.com>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Host replacement of stm32f0.h: only registers & bits used by ../i2cdma.c,
+ * peripherals are plain structures served by device model in main.c
+ */
+
+#pragma once
+#ifndef STM32F0_H__
+#define STM32F0_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct{
+    volatile uint32_t CR1, CR2, OAR1, OAR2, TIMINGR, TIMEOUTR, ISR, ICR, PECR, RXDR, TXDR;
+} I2C_TypeDef;
+
+typedef struct{
+    volatile uint32_t CCR, CNDTR, CPAR, CMAR;
+} DMA_Channel_TypeDef;
+
+typedef struct{
+    volatile uint32_t MODER, OTYPER, OSPEEDR, PUPDR, IDR, ODR, BSRR, LCKR, AFR[2], BRR;
+} GPIO_TypeDef;
+
+typedef struct{
+    volatile uint32_t AHBENR, APB1ENR, CFGR3;
+} RCC_TypeDef;
+
+extern I2C_TypeDef sim_I2C1;
+extern DMA_Channel_TypeDef sim_DMA1_Channel2, sim_DMA1_Channel3;
+extern GPIO_TypeDef sim_GPIOA;
+extern RCC_TypeDef sim_RCC;
+
+#define I2C1                (&sim_I2C1)
+#define DMA1_Channel2       (&sim_DMA1_Channel2)
+#define DMA1_Channel3       (&sim_DMA1_Channel3)
+#define GPIOA               (&sim_GPIOA)
+#define RCC                 (&sim_RCC)
+
+#define I2C1_IRQn           (23)
+void NVIC_SetPriority(int irq, uint32_t prio);
+void NVIC_EnableIRQ(int irq);
+void NVIC_DisableIRQ(int irq);
+#define nop()
+void i2c1_isr();
+
+#define I2C_CR1_PE          ((uint32_t)0x00000001)
+#define I2C_CR1_NACKIE      ((uint32_t)0x00000010)
+#define I2C_CR1_STOPIE      ((uint32_t)0x00000020)
+#define I2C_CR1_TCIE        ((uint32_t)0x00000040)
+#define I2C_CR1_ERRIE       ((uint32_t)0x00000080)
+#define I2C_CR1_TXDMAEN     ((uint32_t)0x00004000)
+#define I2C_CR1_RXDMAEN     ((uint32_t)0x00008000)
+#define I2C_CR2_SADD        ((uint32_t)0x000003FF)
+#define I2C_CR2_RD_WRN      ((uint32_t)0x00000400)
+#define I2C_CR2_START       ((uint32_t)0x00002000)
+#define I2C_CR2_STOP        ((uint32_t)0x00004000)
+#define I2C_CR2_NBYTES      ((uint32_t)0x00FF0000)
+#define I2C_CR2_AUTOEND     ((uint32_t)0x02000000)
+#define I2C_ISR_NACKF       ((uint32_t)0x00000010)
+#define I2C_ISR_STOPF       ((uint32_t)0x00000020)
+#define I2C_ISR_TC          ((uint32_t)0x00000040)
+#define I2C_ISR_BERR        ((uint32_t)0x00000100)
+#define I2C_ISR_ARLO        ((uint32_t)0x00000200)
+#define I2C_ISR_OVR         ((uint32_t)0x00000400)
+#define I2C_ICR_NACKCF      ((uint32_t)0x00000010)
+#define I2C_ICR_STOPCF      ((uint32_t)0x00000020)
+#define I2C_ICR_BERRCF      ((uint32_t)0x00000100)
+#define I2C_ICR_ARLOCF      ((uint32_t)0x00000200)
+#define I2C_ICR_OVRCF       ((uint32_t)0x00000400)
+#define DMA_CCR_EN          ((uint32_t)0x00000001)
+#define DMA_CCR_DIR         ((uint32_t)0x00000010)
+#define DMA_CCR_MINC        ((uint32_t)0x00000080)
+#define RCC_AHBENR_DMA1EN   ((uint32_t)0x00000001)
+#define RCC_APB1ENR_I2C1EN  ((uint32_t)0x00200000)
+#define RCC_CFGR3_I2C1SW    ((uint32_t)0x00000010)
+
+#endif // STM32F0_H__
@@ -22,6 +22,8 @@
 #include "stm32f0.h"
 #include "usart.h"
 #include "i2c.h"
+#include "i2cdma.h"
+#include "sched.h"
 
 volatile uint32_t Tms = 0;
 
@@ -57,28 +59,69 @@ void printu(uint32_t val){
     while(ALL_OK != usart2_send_blocking(buf, l+bpos));
 }
 
-void showcoeffs(uint8_t addr){ // show norm coefficiens
+void showcoeffs(int n){ // show cached coefficiens
     int i;
-    const uint8_t regs[5] = {0xAA, 0xA8, 0xA6, 0xA4, 0xA2}; // commands for coefficients
-    uint32_t K;
     for(i = 0; i < 5; ++i){
-        if(write_i2c(addr, regs[i])){
-            if(read_i2c(addr, &K, 2)){
-                char b[3] = {'K', i+'0', '='};
-                while(ALL_OK != usart2_send_blocking(b, 3));
-                printu(K);
-                while(ALL_OK != usart2_send_blocking("\n", 1));
-            }
-        }
+        int32_t K = tsys_coeff(n, i);
+        if(K < 0) return;
+        char b[3] = {'K', i+'0', '='};
+        while(ALL_OK != usart2_send_blocking(b, 3));
+        printu(K);
+        while(ALL_OK != usart2_send_blocking("\n", 1));
+    }
+}
+
+// print signed int
+static void printi(int32_t val){
+    if(val < 0){
+        while(ALL_OK != usart2_send_blocking("-", 1));
+        val = -val;
+    }
+    printu((uint32_t)val);
+}
+
+// show I2C statistics for given device
+static void showstat(uint8_t addr){
+    const i2c_stat_t *s = i2c_getstat(addr);
+    if(!s) return;
+    while(ALL_OK != usart2_send_blocking("ok/nack/buserr/timeout: ", 24));
+    printu(s->ok);
+    while(ALL_OK != usart2_send_blocking("/", 1));
+    printu(s->nack);
+    while(ALL_OK != usart2_send_blocking("/", 1));
+    printu(s->buserr);
+    while(ALL_OK != usart2_send_blocking("/", 1));
+    printu(s->timeout);
+    while(ALL_OK != usart2_send_blocking("\n", 1));
+}
+
+// show sample: "T0=2345" (degC*100) or "Tms sensor value" in stream mode
+static void showsample(const sample_t *smpl, uint8_t stream){
+    if(stream){
+        printu(smpl->T);
+        char b[3] = {' ', '0' + smpl->sensor, ' '};
+        while(ALL_OK != usart2_send_blocking(b, 3));
+    }else{
+        char b[3] = {'T', '0' + smpl->sensor, '='};
+        while(ALL_OK != usart2_send_blocking(b, 3));
     }
+    printi(smpl->val);
+    while(ALL_OK != usart2_send_blocking("\n", 1));
+}
+
+// reset both sensors, scheduler will be restarted after RESET_TIME
+static void resetall(){
+    tsys_reset(0);
+    tsys_reset(1);
 }
 
 int main(void){
-    uint32_t lastT = 0;
+    uint32_t lastT = 0, last5s = 0, Treset;
     int16_t L = 0;
-    int _5sec = 0; // five second counter
-    uint32_t started0=0, started1=0; // time of measurements for given sensor started
-    uint32_t msctr = 0;
+    uint8_t needinit = 1; // sensors was reset, need to read coefficients
+    uint8_t stream = 0; // show all samples
+    sample_t smpl, last[TSYS_NSENSORS] = {0};
+    uint8_t havelast[TSYS_NSENSORS] = {0};
     char *txt;
     sysreset();
     SysTick_Config(6000, 1);
@@ -86,47 +129,48 @@ int main(void){
     usart2_setup();
     i2c_setup();
     // reset on start
-    write_i2c(TSYS01_ADDR0, TSYS01_RESET);
-    write_i2c(TSYS01_ADDR1, TSYS01_RESET);
+    resetall();
+    Treset = Tms;
 
     while (1){
         if(lastT > Tms || Tms - lastT > 499){
             pin_toggle(GPIOB, 1<<3); // blink by onboard LED once per second
             lastT = Tms;
         }
-        if(started0 && Tms - started0 > CONV_TIME){ // poll sensor0
-            if(write_i2c(TSYS01_ADDR0, TSYS01_ADC_READ)){
-                uint32_t t;
-                if(read_i2c(TSYS01_ADDR0, &t, 3)){
-                    while(ALL_OK != usart2_send_blocking("T0=", 3));
-                    printu(t);
-                    while(ALL_OK != usart2_send_blocking("\n", 1));
-                    started0 = 0;
-                }
-            }
-        }
-        if(started1 && Tms - started1 > CONV_TIME){ // poll sensor1
-            if(write_i2c(TSYS01_ADDR1, TSYS01_ADC_READ)){
-                uint32_t t;
-                if(read_i2c(TSYS01_ADDR1, &t, 3)){
-                    while(ALL_OK != usart2_send_blocking("T1=", 3));
-                    printu(t);
-                    while(ALL_OK != usart2_send_blocking("\n", 1));
-                    started1 = 0;
-                }
+        i2c_process();
+        if(needinit){
+            if(Tms - Treset > RESET_TIME){ // read calibration & start polling
+                for(int n = 0; n < TSYS_NSENSORS; ++n) tsys_getcoeffs(n);
+                sched_init(tsys_sensors, TSYS_NSENSORS);
+                needinit = 0;
             }
+        }else sched_poll();
+        while(sched_get(&smpl)){
+            if(smpl.sensor >= TSYS_NSENSORS) continue;
+            last[smpl.sensor] = smpl;
+            havelast[smpl.sensor] = 1;
+            if(stream) showsample(&smpl, 1);
         }
         if(usart2rx()){ // usart1 received data, store in in buffer
             L = usart2_getline(&txt);
             if(L == 2){
                 if(txt[0] == 'C'){ // 'C' - show coefficients
-                    showcoeffs(TSYS01_ADDR0);
-                    showcoeffs(TSYS01_ADDR1);
+                    showcoeffs(0);
+                    showcoeffs(1);
                 }else if(txt[0] == 'R'){ // 'R' - reset both
-                    write_i2c(TSYS01_ADDR0, TSYS01_RESET);
-                    write_i2c(TSYS01_ADDR1, TSYS01_RESET);
+                    resetall();
+                    Treset = Tms;
+                    needinit = 1;
                 }else if(txt[0] == 'I'){ // 'I' - reinit I2C
                     i2c_setup();
+                }else if(txt[0] == 'M'){ // 'M' - toggle stream mode
+                    stream = !stream;
+                }else if(txt[0] == 'S'){ // 'S' - I2C statistics
+                    showstat(TSYS01_ADDR0);
+                    showstat(TSYS01_ADDR1);
+                    while(ALL_OK != usart2_send_blocking("lost: ", 6));
+                    printu(sched_lost);
+                    while(ALL_OK != usart2_send_blocking("\n", 1));
                 }
             }
         }
@@ -135,17 +179,11 @@ int main(void){
                 L = 0;
             }
         }
-        if(msctr != Tms){
-            msctr = Tms;
-            if(++_5sec >= 5000){ // once per 5 second
-                _5sec = 0;
-                if(write_i2c(TSYS01_ADDR0, TSYS01_START_CONV)) started0 = Tms;
-                else started0 = 0;
-                if(write_i2c(TSYS01_ADDR1, TSYS01_START_CONV)) started1 = Tms;
-                else started1 = 0;
-            }
+        if(!stream && Tms - last5s > 4999){ // once per 5 second show last values
+            last5s = Tms;
+            for(int n = 0; n < TSYS_NSENSORS; ++n)
+                if(havelast[n]) showsample(&last[n], 0);
         }
     }
     return 0;
 }
-
@@ -0,0 +1,150 @@
+/*
+ * This file is part of the stm32samples project.
+ * Copyright 2019 Edward V. Emelianov <edward.emelianoff@gmail.com>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Cooperative sensors scheduler: each sensor has its own state machine
+ * (start conversion -> wait -> read), so conversions of different sensors
+ * overlap and each one works with its own max rate. Channels of one chip
+ * share `lock`, so only one of them converts at a time.
+ * Results are stored in ring buffer with timestamps.
+ */
+
+#include "i2cdma.h"
+#include "sched.h"
+
+extern volatile uint32_t Tms;
+
+uint32_t sched_lost = 0; // amount of samples lost due to ring overflow
+
+enum{
+    ST_IDLE,    // wait for next period
+    ST_CONV,    // conversion started
+    ST_READ,    // reading queued
+    ST_PAUSE    // conversion start failed, wait before next try
+};
+
+static sensor_t *sensors = NULL;
+static int Nsensors = 0;
+static sample_t ring[SCHED_RINGSZ];
+static uint8_t rhead = 0, rtail = 0;
+
+/**
+ * @brief sched_init - set sensors table
+ * @param s - array of sensors
+ * @param n - its length
+ */
+void sched_init(sensor_t *s, int n){
+    for(int i = 0; i < n; ++i){
+        s[i].state = ST_IDLE;
+        s[i].Tstart = Tms - s[i].period;
+        if(s[i].lock) *s[i].lock = 0;
+    }
+    sensors = s;
+    Nsensors = n;
+}
+
+static void put_sample(uint32_t T, int n, int32_t val){
+    uint8_t nxt = (rtail + 1) & (SCHED_RINGSZ - 1);
+    if(nxt == rhead){ // overflow: drop oldest
+        rhead = (rhead + 1) & (SCHED_RINGSZ - 1);
+        ++sched_lost;
+    }
+    ring[rtail].T = T;
+    ring[rtail].sensor = n;
+    ring[rtail].val = val;
+    rtail = nxt;
+}
+
+/**
+ * @brief sched_get - get oldest sample from ring
+ * @param s (o) - sample
+ * @return 0 if ring is empty
+ */
+int sched_get(sample_t *s){
+    if(rhead == rtail) return 0;
+    *s = ring[rhead];
+    rhead = (rhead + 1) & (SCHED_RINGSZ - 1);
+    return 1;
+}
+
+static void release(sensor_t *s){
+    s->state = ST_IDLE;
+    if(s->lock) *s->lock = 0;
+}
+
+/**
+ * @brief sched_poll - process all sensors, should be called from main loop
+ * (together with i2c_process())
+ */
+void sched_poll(){
+    for(int n = 0; n < Nsensors; ++n){
+        sensor_t *s = &sensors[n];
+        int32_t val;
+        switch(s->state){
+            case ST_IDLE:
+                if(Tms - s->Tstart < s->period) break;
+                if(s->lock && *s->lock) break; // another channel of this chip is busy
+                if(!s->start(n)) break; // queue is full, try later
+                if(s->lock) *s->lock = 1;
+                s->Tstart = Tms;
+                s->Twait = s->convtime;
+                s->tries = 0;
+                s->state = ST_CONV;
+            break;
+            case ST_CONV:
+                if(s->started && !s->tries){ // check start command until first reading
+                    uint8_t st = s->started(n);
+                    if(st == I2C_PENDING) break;
+                    if(st != I2C_OK){ // conversion didn't begin
+                        s->Tstart = Tms;
+                        s->Twait = SCHED_RESTART_MS;
+                        s->state = ST_PAUSE;
+                        break;
+                    }
+                }
+                if(Tms - s->Tstart <= s->Twait) break;
+                if(s->read(n)) s->state = ST_READ;
+            break;
+            case ST_READ:
+                switch(s->result(n, &val)){
+                    case I2C_PENDING:
+                    break;
+                    case I2C_OK:
+                        put_sample(s->Tstart, n, val);
+                        release(s);
+                    break;
+                    case I2C_NACK: // not ready yet
+                        if(++s->tries < SCHED_MAXTRIES){
+                            s->Twait = Tms - s->Tstart + SCHED_RETRY_MS;
+                            s->state = ST_CONV;
+                        }else release(s);
+                    break;
+                    default: // error: try next time
+                        release(s);
+                    break;
+                }
+            break;
+            case ST_PAUSE:
+                if(Tms - s->Tstart < s->Twait) break;
+                release(s);
+            break;
+            default:
+                release(s);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * This file is part of the stm32samples project.
+ * Copyright 2019 Edward V. Emelianov <edward.emelianoff@gmail.com>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef SCHED_H__
+#define SCHED_H__
+
+#include "stm32f0.h"
+
+// results ring buffer size (power of 2)
+#define SCHED_RINGSZ        (32)
+// pause before next reading try if sensor NACKed it (conversion isn't ready), ms
+#define SCHED_RETRY_MS      (2)
+// max amount of reading tries
+#define SCHED_MAXTRIES      (10)
+// pause before next try if conversion start failed, ms
+#define SCHED_RESTART_MS    (5)
+
+// measurement result
+typedef struct{
+    uint32_t T;         // conversion start time, ms
+    uint8_t sensor;     // sensor index
+    int32_t val;        // value
+} sample_t;
+
+// sensor descriptor, callbacks get sensor index
+typedef struct{
+    uint8_t (*start)(int n);                // queue conversion start command
+    uint8_t (*started)(int n);              // i2c_status_t of start command (NULL - don't check)
+    uint8_t (*read)(int n);                 // queue result reading
+    uint8_t (*result)(int n, int32_t *val); // i2c_status_t of reading, value if I2C_OK
+    uint16_t convtime;                      // conversion time, ms
+    uint16_t period;                        // measurement period, ms (0 - as fast as possible)
+    uint8_t *lock;                          // common for channels of one chip (or NULL)
+    // internal state
+    uint8_t state;
+    uint8_t tries;
+    uint32_t Tstart;
+    uint32_t Twait;
+} sensor_t;
+
+extern uint32_t sched_lost;
+
+void sched_init(sensor_t *s, int n);
+void sched_poll();
+int sched_get(sample_t *s);
+
+#endif // SCHED_H__
@@ -0,0 +1,295 @@
+/*
+ * This file is part of the LED_screen project.
+ * Copyright 2019 Edward V. Emelianov <eddy@sao.ru, edward.emelianoff@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Font compiler: BDF font -> packed proportional font header for fonts.c
+ * Each glyph is cut to its tight bounding box inside character cell, its rows are
+ * bit-packed without padding (or RLE-compressed if it's shorter), glyphs are indexed
+ * by ranges of Unicode code points. TTF fonts should be rasterized to BDF first
+ * (e.g. `otf2bdf -p 14 font.ttf`).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+// max cell width (blitter limit), px
+#define MAXWIDTH    32
+// max cell height, px
+#define MAXHEIGHT   255
+// max amount of code ranges in -s
+#define MAXSUBSETS  32
+// glyph flags (the same as in fonts.h)
+#define GLYPH_RLE   1
+
+typedef struct{
+    unsigned code;      // Unicode code point
+    int width;          // advance width
+    int left, top;      // tight bitmap position in cell
+    int w, h;           // tight bitmap size
+    int flags;
+    unsigned char *data;// packed bitmap
+    int size;           // its length
+} glyph;
+
+static glyph *glyphs = NULL;
+static int nglyphs = 0;
+static int ascent = -1, descent = -1, height;
+static char comments[4096];
+static unsigned subset[MAXSUBSETS][2];
+static int nsubsets = 0;
+static int userle = 0;
+
+static void usage(const char *self){
+    fprintf(stderr, "USAGE: %s [-n name] [-r] [-s first-last[,first-last...]] font.bdf > font.h\n"
+            "\t-n name - name of font (default: \"font\"), header will contain NAME(HEIGHT|BASELINE|RANGES)\n"
+            "\t          and name_bitmaps, name_glyphs, name_ranges arrays\n"
+            "\t-r      - RLE-compress glyphs if this makes them shorter\n"
+            "\t-s      - convert only given ranges of Unicode code points (hex or decimal)\n", self);
+    exit(1);
+}
+
+static void die(const char *msg, const char *arg){
+    fprintf(stderr, "Error: %s %s\n", msg, arg ? arg : "");
+    exit(2);
+}
+
+static int insubset(unsigned code){
+    if(!nsubsets) return 1;
+    for(int i = 0; i < nsubsets; ++i)
+        if(code >= subset[i][0] && code <= subset[i][1]) return 1;
+    return 0;
+}
+
+static void parsesubset(char *str){
+    char *tok = strtok(str, ",");
+    while(tok){
+        if(nsubsets == MAXSUBSETS) die("too many ranges", NULL);
+        char *eptr;
+        unsigned long f = strtoul(tok, &eptr, 0), l = f;
+        if(*eptr == '-') l = strtoul(eptr + 1, &eptr, 0);
+        if(*eptr || l < f) die("bad range", tok);
+        subset[nsubsets][0] = f;
+        subset[nsubsets][1] = l;
+        ++nsubsets;
+        tok = strtok(NULL, ",");
+    }
+}
+
+// bit-pack rows of tight bitmap
+static int packraw(unsigned char cell[][MAXWIDTH], glyph *g, unsigned char *out){
+    int bit = 0;
+    memset(out, 0, (g->w * g->h + 7) / 8);
+    for(int y = 0; y < g->h; ++y)
+        for(int x = 0; x < g->w; ++x, ++bit)
+            if(cell[g->top + y][g->left + x]) out[bit >> 3] |= 0x80 >> (bit & 7);
+    return (bit + 7) / 8;
+}
+
+// nibble RLE: run of n<15 pixels of current color then color changes; 15 - run of 15 pixels
+// without change; first run is of zeros
+static int packrle(unsigned char cell[][MAXWIDTH], glyph *g, unsigned char *out){
+    int nibbles = 0, color = 0, run = 0, total = g->w * g->h;
+    memset(out, 0, (total * 2 + 2) / 2);
+    #define PUTNIBBLE(v) do{ out[nibbles >> 1] |= (nibbles & 1) ? (v) : (v) << 4; ++nibbles; }while(0)
+    for(int i = 0; i <= total; ++i){
+        int pix = (i < total) ? cell[g->top + i / g->w][g->left + i % g->w] : !color;
+        if(pix == color){ ++run; continue; }
+        while(run >= 15){ PUTNIBBLE(15); run -= 15; }
+        PUTNIBBLE(run);
+        color = pix;
+        run = 1;
+    }
+    #undef PUTNIBBLE
+    return (nibbles + 1) / 2;
+}
+
+// cut glyph by its bounding box and pack it
+static void packglyph(unsigned char cell[][MAXWIDTH], glyph *g){
+    int x0 = MAXWIDTH, x1 = -1, y0 = height, y1 = -1;
+    for(int y = 0; y < height; ++y)
+        for(int x = 0; x < g->width; ++x){
+            if(!cell[y][x]) continue;
+            if(x < x0) x0 = x;
+            if(x > x1) x1 = x;
+            if(y < y0) y0 = y;
+            if(y > y1) y1 = y;
+        }
+    if(x1 < 0){ // empty glyph (space)
+        g->left = g->top = g->w = g->h = g->size = 0;
+        g->data = NULL;
+        return;
+    }
+    g->left = x0; g->top = y0;
+    g->w = x1 - x0 + 1; g->h = y1 - y0 + 1;
+    unsigned char raw[MAXWIDTH*MAXHEIGHT/8 + 1], rle[MAXWIDTH*MAXHEIGHT + 1];
+    int rawsz = packraw(cell, g, raw), rlesz = userle ? packrle(cell, g, rle) : rawsz;
+    g->flags = (rlesz < rawsz) ? GLYPH_RLE : 0;
+    g->size = g->flags ? rlesz : rawsz;
+    g->data = malloc(g->size);
+    memcpy(g->data, g->flags ? rle : raw, g->size);
+}
+
+static int hexval(int c){
+    if(c >= '0' && c <= '9') return c - '0';
+    c = tolower(c);
+    if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+static void readbdf(FILE *f){
+    char line[1024];
+    unsigned char cell[MAXHEIGHT][MAXWIDTH];
+    glyph g;
+    int inchar = 0, bitmap = -1, bbw = 0, bbh = 0, bbx = 0, bby = 0;
+    long code = -1;
+    while(fgets(line, sizeof(line), f)){
+        char *nl = strpbrk(line, "\r\n");
+        if(nl) *nl = 0;
+        if(bitmap >= 0){ // bitmap rows
+            if(strcmp(line, "ENDCHAR") == 0){
+                bitmap = -1;
+                inchar = 0;
+                if(code < 0 || code > 0xffff || !insubset(code)) continue;
+                g.code = code;
+                packglyph(cell, &g);
+                glyphs = realloc(glyphs, (nglyphs + 1) * sizeof(glyph));
+                glyphs[nglyphs++] = g;
+                continue;
+            }
+            // row of BBX, upper row first; its lower row lays bby pixels above baseline
+            int y = ascent - (bby + bbh) + bitmap++;
+            for(int x = 0; x < bbw && line[x/4]; ++x){
+                int v = hexval(line[x/4]);
+                if(v < 0) die("bad bitmap:", line);
+                int cx = bbx + x;
+                if(y < 0 || y >= height || cx < 0 || cx >= g.width) continue; // outside of cell
+                cell[y][cx] = (v >> (3 - (x & 3))) & 1;
+            }
+            continue;
+        }
+        if(sscanf(line, "FONT_ASCENT %d", &ascent) == 1) continue;
+        if(sscanf(line, "FONT_DESCENT %d", &descent) == 1) continue;
+        if(strncmp(line, "COMMENT ", 8) == 0 && !inchar){
+            size_t l = strlen(comments);
+            snprintf(comments + l, sizeof(comments) - l, "// %s\n", line + 8);
+            continue;
+        }
+        if(strncmp(line, "STARTCHAR", 9) == 0){
+            if(ascent < 0 || descent < 0) die("no FONT_ASCENT/FONT_DESCENT before glyphs", NULL);
+            height = ascent + descent;
+            if(height < 1 || height > MAXHEIGHT) die("bad font height", NULL);
+            memset(&g, 0, sizeof(g));
+            memset(cell, 0, sizeof(cell));
+            code = -1;
+            bbw = bbh = bbx = bby = 0;
+            inchar = 1;
+            continue;
+        }
+        if(!inchar) continue;
+        if(sscanf(line, "ENCODING %ld", &code) == 1) continue;
+        if(sscanf(line, "DWIDTH %d", &g.width) == 1){
+            // cell is MAXWIDTH wide: check width before bitmap rows are drawn into it
+            if(g.width < 0 || g.width > MAXWIDTH){
+                if(code >= 0 && code <= 0xffff && insubset(code)) die("glyph is too wide:", line);
+                g.width = (g.width < 0) ? 0 : MAXWIDTH; // glyph will be skipped
+            }
+            continue;
+        }
+        if(sscanf(line, "BBX %d %d %d %d", &bbw, &bbh, &bbx, &bby) == 4) continue;
+        if(strcmp(line, "BITMAP") == 0) bitmap = 0;
+    }
+    if(!nglyphs) die("no glyphs found", NULL);
+}
+
+static int cmpglyphs(const void *a, const void *b){
+    const glyph *A = a, *B = b;
+    return (A->code > B->code) - (A->code < B->code);
+}
+
+// print code point as UTF-8 for comment
+static void printutf(unsigned code){
+    if(code < 0x20 || code == '\\') printf("\\x%02x", code);
+    else if(code < 0x80) putchar(code);
+    else if(code < 0x800) printf("%c%c", 0xc0 | (code >> 6), 0x80 | (code & 0x3f));
+    else printf("%c%c%c", 0xe0 | (code >> 12), 0x80 | ((code >> 6) & 0x3f), 0x80 | (code & 0x3f));
+}
+
+static void writeheader(const char *name, const char *fname){
+    char NAME[256];
+    int i, l, offset = 0, nranges = 0;
+    for(l = 0; name[l] && l < 255; ++l) NAME[l] = toupper(name[l]);
+    NAME[l] = 0;
+    for(i = 0; i < nglyphs; ++i){
+        if(i && glyphs[i].code == glyphs[i-1].code) die("duplicate glyph", NULL);
+        if(!i || glyphs[i].code != glyphs[i-1].code + 1) ++nranges;
+        offset += glyphs[i].size;
+    }
+    if(offset > 0xffff) die("font is too large", NULL);
+    printf("/*\n * This file is part of the LED_screen project.\n"
+           " * Generated by fontgen from %s, don't edit it: change the font source instead.\n */\n\n"
+           "// this file should be included JUST ONCE!\n// only in fonts.c\n\n%s", fname, comments);
+    printf("\n// %s: %d glyphs, cell height %dpx, %d bytes of bitmaps\n", name, nglyphs, height, offset);
+    printf("#define %sHEIGHT%*s%d\n", NAME, 12 - l, "", height);
+    printf("#define %sBASELINE%*s%d\n", NAME, 10 - l, "", descent);
+    printf("#define %sRANGES%*s%d\n\n", NAME, 12 - l, "", nranges);
+    printf("const uint8_t %s_bitmaps[] = {\n", name);
+    for(i = 0; i < nglyphs; ++i){
+        if(!glyphs[i].size) continue;
+        printf("    ");
+        for(int j = 0; j < glyphs[i].size; ++j) printf("0x%02x,", glyphs[i].data[j]);
+        printf(" // 0x%04x\n", glyphs[i].code);
+    }
+    printf("};\n\n// offset, width, left, top, w, h, flags\nconst glyph_t %s_glyphs[] = {\n", name);
+    for(i = 0, offset = 0; i < nglyphs; ++i){
+        glyph *g = &glyphs[i];
+        printf("    {%5d, %2d, %2d, %2d, %2d, %2d, %d}, // 0x%04x '", offset, g->width, g->left, g->top, g->w, g->h, g->flags, g->code);
+        printutf(g->code);
+        printf("'\n");
+        offset += g->size;
+    }
+    printf("};\n\n// first code, amount, first glyph\nconst glyphrange_t %s_ranges[%sRANGES] = {\n", name, NAME);
+    for(i = 0; i < nglyphs; ){
+        int j = i + 1;
+        while(j < nglyphs && glyphs[j].code == glyphs[j-1].code + 1) ++j;
+        printf("    {0x%04x, %3d, %3d},\n", glyphs[i].code, j - i, i);
+        i = j;
+    }
+    printf("};\n");
+}
+
+int main(int argc, char **argv){
+    const char *name = "font", *fname = NULL;
+    for(int i = 1; i < argc; ++i){
+        if(strcmp(argv[i], "-n") == 0 && i + 1 < argc) name = argv[++i];
+        else if(strcmp(argv[i], "-r") == 0) userle = 1;
+        else if(strcmp(argv[i], "-s") == 0 && i + 1 < argc) parsesubset(argv[++i]);
+        else if(argv[i][0] == '-' || fname) usage(argv[0]);
+        else fname = argv[i];
+    }
+    if(!fname) usage(argv[0]);
+    FILE *f = fopen(fname, "r");
+    if(!f) die("can't open", fname);
+    readbdf(f);
+    fclose(f);
+    qsort(glyphs, nglyphs, sizeof(glyph), cmpglyphs);
+    const char *base = strrchr(fname, '/');
+    writeheader(name, base ? base + 1 : fname);
+    return 0;
+}
@@ -22,6 +22,7 @@
  */
 
 #include "hardware.h"
+#include "screen.h"
 #include "spi.h"
 
 static inline void gpio_setup(){
@@ -40,9 +41,20 @@ static inline void gpio_setup(){
     GPIOA->CRL = CRL(6, CNF_PPOUTPUT|MODE_SLOW) | CRL(4, CNF_PPOUTPUT|MODE_SLOW);
 }
 
+// TIM2 - screen scan timer: 1MHz, interrupts by update (end of plane) & CC1 (dimming)
+static inline void tim2_setup(){
+    RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
+    TIM2->PSC = 71; // 72MHz -> 1MHz
+    TIM2->ARR = SCREEN_PLANE_US - 1;
+    TIM2->DIER = TIM_DIER_UIE | TIM_DIER_CC1IE;
+    NVIC_SetPriority(TIM2_IRQn, 1);
+    NVIC_EnableIRQ(TIM2_IRQn);
+}
+
 void hw_setup(){
     gpio_setup();
     spi_setup();
+    tim2_setup();
 }
 
 // SPI1 DMA Tx interrupt
@@ -21,6 +21,7 @@
 
 #include "fonts.h"
 #include "hardware.h"
+#include "marquee.h"
 #include "screen.h"
 #include "usb.h"
 #include "usb_lib.h"
@@ -56,25 +57,45 @@ void iwdg_setup(){
 }
 
 static uint8_t countms = 0;
+static uint8_t needupdate = 0; // image is drawn, but UpdateScreen() isn't done yet
 
 char *parse_cmd(char *buf){
+    if((*buf == 'B' || *buf == 'L') && buf[1] >= '0' && buf[1] <= '9'){ // brightness or level
+        uint32_t N = 0;
+        for(char *p = buf + 1; *p >= '0' && *p <= '9'; ++p) N = N*10 + *p - '0';
+        if(*buf == 'B'){
+            SetBrightness(N > 255 ? 255 : N);
+            return "Brightness changed\n";
+        }
+        SetColor(N > 255 ? 255 : N);
+        return "Level changed\n";
+    }
+    if(*buf == 'P' && buf[1] >= '1' && buf[1] <= '9' && buf[2] >= '1' && buf[2] <= '9'){ // panels chain
+        ScreenOFF();
+        MarqueeStop();
+        if(SetPanels(buf[1] - '0', buf[2] - '0', buf[3] == 's')) return "Too many panels\n";
+        ShowScreen();
+        return "Panels changed\n";
+    }
+    if(*buf == 'M' && buf[1] != '\n'){ // marquee
+        MarqueeStart(buf + 1, SCREEN_HEIGHT-1-curfont->baseline);
+        return "Marquee\n";
+    }
     if(buf[1] != '\n'){
         PutStringAt(0, SCREEN_HEIGHT-1-curfont->baseline, buf);
-        ConvertScreenBuf();
+        needupdate = 1;
         return buf;
     }
     switch(*buf){
         case '0':
             ScreenOFF();
             FillScreen(0);
-            ConvertScreenBuf();
             ShowScreen();
             return "Fill 0\n";
         break;
         case '1':
             ScreenOFF();
             FillScreen(1);
-            ConvertScreenBuf();
             ShowScreen();
             return "Fill 1\n";
         break;
@@ -88,8 +109,16 @@ char *parse_cmd(char *buf){
         break;
         case 'C':
             ScreenOFF();
+            MarqueeStop();
             FillScreen(0);
             return "OK\n";
+        case 'K':
+            set_encoding(ENC_KOI8R);
+            return "KOI8-R\n";
+        break;
+        case 'm':
+            MarqueeStop();
+            return "Marquee stopped\n";
         case 'p':
             pin_toggle(USBPU_port, USBPU_pin);
             USB_send("USB pullup is ");
@@ -105,6 +134,10 @@ char *parse_cmd(char *buf){
             ShowScreen();
             return "OK\n";
         break;
+        case 'U':
+            set_encoding(ENC_UTF8);
+            return "UTF-8\n";
+        break;
         case 'W':
             USB_send("Wait for reboot\n");
             while(1){nop();};
@@ -122,8 +155,13 @@ char *parse_cmd(char *buf){
             "'0' - fill 0\n"
             "'1' - fill 1\n"
             "'2,3' - select font\n"
+            "'Bx' - set global brightness (0..255)\n"
             "'C' - clear screen\n"
+            "'K', 'U' - text encoding: KOI8-R or UTF-8\n"
+            "'Lx' - set level of pixels for next drawing (0..7)\n"
+            "'Mtext' - run marquee, 'm' - stop it\n"
             "'p' - toggle USB pullup\n"
+            "'Pcr[s]' - chain of c*r panels ('s' - serpentine)\n"
             "'R' - software reset\n"
             "'S' - show screen\n"
             "'W' - test watchdog\n"
@@ -155,7 +193,7 @@ char *get_USB(){
 }
 
 int main(void){
-    uint32_t lastT = 0, mscnt = 0, Tmscnt = 0;
+    uint32_t lastT = 0, mscnt = 0, Tmscnt = 0, Tmarquee = 0;
     sysreset();
     StartHSE();
     SysTick_Config(72000);
@@ -165,7 +203,6 @@ int main(void){
     USBPU_OFF();
     USB_setup();
     PutStringAt(0, SCREEN_HEIGHT-1-curfont->baseline, "Test string");
-    ConvertScreenBuf();
     iwdg_setup();
     USBPU_ON();
 
@@ -184,16 +221,22 @@ int main(void){
                     Tmscnt = Tms;
                     FillScreen(0);
                     PutStringAt(0, SCREEN_HEIGHT-1-curfont->baseline, u2str(++mscnt));
-                    ConvertScreenBuf();
                     ShowScreen();
+                    needupdate = 1;
                 }
             }
         }else{
             mscnt = 0;
             Tmscnt = 0;
         }
+        if(Tms - Tmarquee >= MARQUEE_MS && MarqueeActive()){
+            Tmarquee = Tms;
+            MarqueeStep(1);
+            needupdate = 1;
+        }
+        // previous update could be not shown yet: try again later
+        if(needupdate && UpdateScreen()) needupdate = 0;
         IWDG->KR = IWDG_REFRESH;
-        process_screen();
         usb_proc();
         char *txt, *ans;
         if((txt = get_USB())){
@@ -0,0 +1,37 @@
+/*
+ * This file is part of the LED_screen project.
+ * Copyright 2019 Edward V. Emelianov <eddy@sao.ru, edward.emelianoff@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#ifndef MARQUEE_H__
+#define MARQUEE_H__
+
+#include <stdint.h>
+
+// blank space between end of message and its next start, px
+#define MARQUEE_GAP         32
+// time of one pixel step, ms
+#define MARQUEE_MS          30
+// max message length
+#define MARQUEE_MAXLEN      512
+
+void MarqueeStart(const char *text, int16_t Y);
+void MarqueeStop();
+uint8_t MarqueeActive();
+void MarqueeStep(uint8_t n);
+
+#endif // MARQUEE_H__
@@ -22,11 +22,6 @@
 
 #include <stdint.h>
 
-// code number of first symbol in font table
-#define FIRST_SYMBOL_CODE 32
-// total amount of symbols - all without first 32
-#define SYMBOLS_AMOUNT      (256-FIRST_SYMBOL_CODE)
-
 // type for font choosing
 typedef enum{
     FONT_T_MIN = -1,    // no fonts <= this
@@ -35,20 +30,47 @@ typedef enum{
     FONT_T_MAX          // no fonts >= this
 } font_t;
 
-int choose_font(font_t newfont);
-/* uint8_t fontheight();
-uint8_t fontbaseline();
-uint8_t fontbytes(); */
-const uint8_t *font_char(uint8_t Char);
+// encoding of strings
+typedef enum{
+    ENC_UTF8,           // UTF-8 (bytes that aren't UTF-8 sequences are KOI8-R)
+    ENC_KOI8R           // KOI8-R
+} encoding_t;
 
+// glyph bitmap is RLE-compressed
+#define GLYPH_RLE           1
+
+// glyph of packed font (fonts are generated by fontgen/fontgen)
+typedef struct{
+    uint16_t offset;    // offset of bitmap in font bitmaps (bytes)
+    uint8_t width;      // advance width (px), not more than 32
+    uint8_t left;       // bitmap position in character cell
+    uint8_t top;
+    uint8_t w;          // bitmap size: tight bounding box of glyph
+    uint8_t h;
+    uint8_t flags;      // GLYPH_RLE
+} glyph_t;
 
+// glyphs of consecutive Unicode code points
 typedef struct{
-    const uint8_t *font;// font inself
+    uint16_t first;     // first code
+    uint16_t amount;    // amount of codes
+    uint16_t glyph;     // index of first glyph
+} glyphrange_t;
+
+typedef struct{
+    const uint8_t *bitmaps;     // glyph bitmaps
+    const glyph_t *glyphs;      // glyphs index
+    const glyphrange_t *ranges; // code ranges (sorted)
+    uint8_t nranges;    // amount of ranges
     uint8_t height;     // full font matrix height
-    uint8_t bytes;      // amount of bytes in font matrix
     uint8_t baseline;   // baseline position (coordinate from bottom line)
 } afont;
 
 extern const afont *curfont;
 
+int choose_font(font_t newfont);
+const glyph_t *font_glyph(uint16_t code);
+void set_encoding(encoding_t enc);
+uint16_t next_char(const char **str);
+
 #endif // FONTS_H__
@@ -1,6 +1,9 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include "fonts.h"
+#include "marquee.h"
 #include "screen.h"
 
 #define WHITE   "\033[1;38;40m"
@@ -57,18 +60,10 @@ void dumpbuf(){
     }
 }
 
-static uint8_t dmabuf[4][SCREENBUF_SZ/4];
+static uint8_t dmabuf[4][SCREEN_PLANES][SCREEN_MAXPANELS*PANEL_QUARTER_SZ];
 void CSB(){
-    uint8_t *screenbuf = getScreenBuf();
-    for(uint8_t partNo = 0; partNo < 4; ++ partNo){ // cycle by strings
-        uint8_t *dmaptr = dmabuf[partNo];
-        for(int X = 0; X < SCREEN_WIDTH/8; ++X){
-            for(int Y = SCREEN_HEIGHT-4+partNo; Y >= 0; Y -= 4){ // and cycle by Y
-                *dmaptr++ = screenbuf[X + Y*(SCREEN_WIDTH/8)];
-            }
-        }
-    }
-
+    for(uint8_t p = 0; p < SCREEN_PLANES; ++p)
+        for(uint8_t partNo = 0; partNo < 4; ++ partNo) ScanGather(dmabuf[partNo][p], partNo, p);
 }
 
 void dumpdmastr(uint8_t n){
@@ -76,7 +71,7 @@ void dumpdmastr(uint8_t n){
     printf("\n");
     chcolr(n);
     printf("BUF[%d]:\n", n);
-    uint8_t *ptr = dmabuf[n];
+    uint8_t *ptr = dmabuf[n][SCREEN_PLANES-1];
     for(int y = 0; y < 4; ++y){
         printf("%02d|", y);
         for(int x = 0; x < 4; ++x){
@@ -91,9 +86,396 @@ void dumpdmastr(uint8_t n){
     printf(DEFCOL);
 }
 
+// per-pixel reference: decode whole glyph bitmap and DrawPix() each pixel of its cell
+static uint8_t refDrawCharAt(int16_t X, int16_t Y, uint16_t code){
+    const glyph_t *g = font_glyph(code);
+    if(!g) return 0;
+    const uint8_t *bits = &curfont->bitmaps[g->offset];
+    uint8_t pix[32*256] = {0};
+    int total = g->w * g->h;
+    if(g->flags & GLYPH_RLE){
+        int color = 0, nib = 0;
+        for(int i = 0; i < total;){
+            int n = (nib & 1) ? bits[nib >> 1] & 0x0f : bits[nib >> 1] >> 4;
+            ++nib;
+            for(int j = 0; j < n && i < total; ++j) pix[i++] = color;
+            if(n < 15) color = !color;
+        }
+    }else for(int i = 0; i < total; ++i) pix[i] = !!(bits[i >> 3] & (0x80 >> (i & 7)));
+    Y += 1 - curfont->height + curfont->baseline;
+    for(int row = 0; row < curfont->height; ++row){
+        for(int col = 0; col < g->width; ++col){
+            int x = col - g->left, y = row - g->top;
+            uint8_t p = (x >= 0 && x < g->w && y >= 0 && y < g->h) ? pix[y*g->w + x] : 0;
+            DrawPix(X + col, Y + row, p);
+        }
+    }
+    return g->width;
+}
+
+static uint8_t refPutStringAt(int16_t X, int16_t Y, const char *str){
+    int16_t Xold = X;
+    uint16_t code;
+    while((code = next_char(&str))) X += refDrawCharAt(X, Y, code);
+    return X - Xold;
+}
+
+// get pixel value from buffer
+static uint8_t getpix(const uint8_t *buf, int16_t X, int16_t Y){
+    uint8_t pix = buf[Y*SCREEN_WIDTH/8 + X/8] & (1 << (7 - (X%8)));
+    return SCREEN_IS_NEGATIVE ? !pix : !!pix;
+}
+
+static double dtime(){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// compare blitter with per-pixel reference, return amount of errors
+static int check(char *str){
+    static uint8_t ref[SCREENBUF_MAXSZ];
+    uint8_t *buf = getScreenBuf();
+    int errs = 0;
+    for(int16_t Y = -4; Y < SCREEN_HEIGHT + 4; ++Y){
+        for(int16_t X = -24; X < SCREEN_WIDTH + 8; ++X){
+            FillScreen(1);
+            refPutStringAt(X, Y, str);
+            memcpy(ref, buf, SCREENBUF_SZ);
+            FillScreen(1);
+            PutStringAt(X, Y, str);
+            if(memcmp(ref, buf, SCREENBUF_SZ)){
+                if(!errs++) printf(RED "Glyphs differ @ (%d, %d)\n" DEFCOL, X, Y);
+            }
+            // rectangles: inverted twice should restore
+            FillRect(X, Y, 13, 5, 0);
+            for(int16_t y = Y; y < Y + 5; ++y) for(int16_t x = X; x < X + 13; ++x) DrawPix(x, y, 1);
+            XorRect(X, Y, 13, 5);
+            XorRect(X, Y, 13, 5);
+            memcpy(ref, buf, SCREENBUF_SZ);
+            for(int16_t y = Y; y < Y + 5; ++y) for(int16_t x = X; x < X + 13; ++x) DrawPix(x, y, 1);
+            if(memcmp(ref, buf, SCREENBUF_SZ)){
+                if(!errs++) printf(RED "Rectangles differ @ (%d, %d)\n" DEFCOL, X, Y);
+            }
+        }
+    }
+    // scrolling
+    for(int16_t dx = -SCREEN_WIDTH - 1; dx <= SCREEN_WIDTH + 1; ++dx){
+        FillScreen(0);
+        PutStringAt(0, SCREEN_HEIGHT-1-curfont->baseline, str);
+        memcpy(ref, buf, SCREENBUF_SZ);
+        ScrollH(2, 10, dx, 1);
+        for(int16_t y = 0; y < SCREEN_HEIGHT; ++y) for(int16_t x = 0; x < SCREEN_WIDTH; ++x){
+            uint8_t pix;
+            if(y < 2 || y > 11) pix = getpix(ref, x, y);
+            else if(x - dx < 0 || x - dx >= SCREEN_WIDTH) pix = 1;
+            else pix = getpix(ref, x - dx, y);
+            if(getpix(buf, x, y) != pix){
+                if(!errs++) printf(RED "Scroll differs @ dx=%d (%d, %d)\n" DEFCOL, dx, x, y);
+            }
+        }
+    }
+    return errs;
+}
+
+// render string at all positions N times by both paths
+static void benchmark(char *str, int N){
+    int nch = strlen(str);
+    double t0 = dtime();
+    for(int i = 0; i < N; ++i)
+        for(int16_t X = -16; X < SCREEN_WIDTH; ++X) refPutStringAt(X, SCREEN_HEIGHT-1-curfont->baseline, str);
+    double t1 = dtime();
+    for(int i = 0; i < N; ++i)
+        for(int16_t X = -16; X < SCREEN_WIDTH; ++X) PutStringAt(X, SCREEN_HEIGHT-1-curfont->baseline, str);
+    double t2 = dtime();
+    double nchars = (double)N * (SCREEN_WIDTH + 16) * nch;
+    printf("DrawPix: %.1fns/char, blitter: %.1fns/char, speedup: %.1f\n",
+           (t1 - t0) / nchars * 1e9, (t2 - t1) / nchars * 1e9, (t1 - t0) / (t2 - t1));
+}
+
+// pixel of image `img` (bit-planes of SCREENBUF_MAXSZ) in panel `i` (from the far end of chain)
+// at its local coordinates x, y
+static uint8_t panelpix(const uint8_t *img, const panelchain *c, int i, int x, int y, uint8_t p){
+    int row = i / c->cols, col = i % c->cols;
+    if(c->serpentine && (row & 1)){ // upside down
+        col = c->cols - 1 - col;
+        x = PANEL_WIDTH - 1 - x;
+        y = PANEL_HEIGHT - 1 - y;
+    }
+    x += col * PANEL_WIDTH;
+    y += row * PANEL_HEIGHT;
+    return getpix(img + p*SCREENBUF_MAXSZ, x, y);
+}
+
+// compare SPI data of quarter q, plane p with per-pixel mapping of image, return amount of wrong pixels
+static int checkgather(const uint8_t *data, const uint8_t *img, uint8_t q, uint8_t p){
+    panelchain c;
+    int np = GetPanels(&c), errs = 0;
+    for(int i = 0; i < np; ++i) // panels from the far end
+        for(int X = 0; X < PANEL_WIDTH/8; ++X) // 8px columns
+            for(int y = PANEL_HEIGHT - 4 + q; y >= 0; y -= 4, ++data) // quarter rows from bottom
+                for(int b = 0; b < 8; ++b){
+                    uint8_t pix = !!(*data & (0x80 >> b));
+                    if(SCREEN_IS_NEGATIVE) pix = !pix;
+                    if(pix != panelpix(img, &c, i, X*8 + b, y, p)) ++errs;
+                }
+    return errs;
+}
+
+// draw random primitive
+static void randdraw(){
+    SetColor(rand() % SCREEN_LEVELS);
+    int16_t X = rand() % (SCREEN_WIDTH + 20) - 10, Y = rand() % (SCREEN_HEIGHT + 20) - 10;
+    switch(rand() % 16){
+        case 0:
+            FillScreen(rand() & 1);
+        break;
+        case 1: case 2: case 3:
+            FillRect(X, Y, rand() % 40, rand() % 20, rand() & 1);
+        break;
+        case 4: case 5:
+            XorRect(X, Y, rand() % 40, rand() % 20);
+        break;
+        case 6: case 7:
+            ScrollH(Y, rand() % 16, rand() % 64 - 32, rand() & 1);
+        break;
+        case 8:
+            DrawPix(X, Y, rand() & 1);
+        break;
+        default:
+            PutStringAt(X, Y, "Ab1");
+    }
+}
+
+// check data gathered for SPI against per-pixel mapping of chain
+static int checkchain(uint8_t cols, uint8_t rows, uint8_t serp, int N){
+    int errs = 0;
+    if(SetPanels(cols, rows, serp)){
+        printf(RED "Can't set %dx%d panels\n" DEFCOL, cols, rows);
+        return 1;
+    }
+    for(int i = 0; i < N; ++i){ // random picture
+        SetColor(rand() % SCREEN_LEVELS);
+        int16_t X = rand() % SCREEN_WIDTH, Y = rand() % SCREEN_HEIGHT;
+        if(rand() & 1) FillRect(X, Y, rand() % 40, rand() % 20, rand() & 1);
+        else PutStringAt(X, Y, "Ab1");
+    }
+    CSB();
+    for(uint8_t p = 0; p < SCREEN_PLANES; ++p) for(uint8_t q = 0; q < 4; ++q)
+        errs += checkgather(dmabuf[q][p], getScreenBuf(), q, p);
+    printf("%dx%d%s panels (%dx%d px): ", cols, rows, serp ? " serpentine" : "", SCREEN_WIDTH, SCREEN_HEIGHT);
+    if(errs) printf(RED "%d wrong pixels\n" DEFCOL, errs);
+    else printf(GREEN "OK\n" DEFCOL);
+    return errs;
+}
+
+// state of checkswap(): images of the last update shown and of the last update requested
+static uint8_t shown[SCREEN_PLANES*SCREENBUF_MAXSZ], updated[SCREEN_PLANES*SCREENBUF_MAXSZ];
+static uint8_t scanQ, scanP, pending;
+static int swaperrs, frames, lit, dark, refused;
+
+// UpdateScreen() and remember image, return 0 if refused
+static int swapupdate(){
+    uint8_t upd = ScreenUpdating();
+    if(!UpdateScreen()){
+        ++refused;
+        if(!upd && !swaperrs++) printf(RED "Update is refused while nothing is pending\n" DEFCOL);
+        return 0;
+    }
+    if(upd && !swaperrs++) printf(RED "Update isn't refused while previous one is pending\n" DEFCOL);
+    memcpy(updated, getScreenBuf(), sizeof(updated));
+    pending = 1;
+    return 1;
+}
+
+// scan next plane and check it against image shown
+static void swapscan(){
+    static uint8_t data[SCREEN_MAXPANELS*PANEL_QUARTER_SZ];
+    if(scanQ == 0 && scanP == 0 && pending){ // new frame
+        memcpy(shown, updated, sizeof(shown));
+        pending = 0;
+        ++frames;
+    }
+    ScanGather(data, scanQ, scanP);
+    if(ScanDark()) ++dark;
+    else{
+        ++lit;
+        if(checkgather(data, shown, scanQ, scanP) && !swaperrs++)
+            printf(RED "Wrong data of quarter %d plane %d after %d frames\n" DEFCOL, scanQ, scanP, frames);
+    }
+    if(++scanP == SCREEN_PLANES){
+        scanP = 0;
+        scanQ = (scanQ + 1) & 3;
+    }
+}
+
+/*
+ * Draw and update at random while screen is scanned by planes (ScanGather() calls in scan order)
+ * and check that each scanned plane is a part of image of the last update shown (or screen
+ * is dark), so every frame is a complete image.
+ */
+static int checkswap(uint8_t cols, uint8_t rows, uint8_t serp, int N){
+    ScreenOFF();
+    if(SetPanels(cols, rows, serp)){
+        printf(RED "Can't set %dx%d panels\n" DEFCOL, cols, rows);
+        return 1;
+    }
+    for(int i = 0; i < 20; ++i) randdraw();
+    ShowScreen();
+    memcpy(shown, getScreenBuf(), sizeof(shown));
+    scanQ = scanP = pending = 0;
+    swaperrs = frames = lit = dark = refused = 0;
+    for(int i = 0; i < N; ++i){
+        int r = rand() % 16;
+        if(r < 7) randdraw();
+        else if(r < 9) swapupdate();
+        else swapscan();
+    }
+    // the last image should be shown in the next frame after update
+    while(!swapupdate()) swapscan();
+    for(int i = 0; i < 8*SCREEN_PLANES; ++i) swapscan();
+    if((ScanDark() || pending || memcmp(shown, getScreenBuf(), sizeof(shown))) && !swaperrs++)
+        printf(RED "The last image isn't shown\n" DEFCOL);
+    ScreenOFF();
+    printf("%dx%d%s panels: %d updates shown, %d refused, %d planes lit, %d dark: ", cols, rows,
+           serp ? " serpentine" : "", frames, refused, lit, dark);
+    if(swaperrs) printf(RED "%d errors\n" DEFCOL, swaperrs);
+    else printf(GREEN "OK\n" DEFCOL);
+    return swaperrs;
+}
+
+// print cost of update and check it, return 1 if it's wrong
+static int costline(const char *what, uint16_t n, uint16_t expected){
+    printf("%s: %d rows (%d bytes) of %d saved: ", what, n, n*SCREEN_PLANES*SCREEN_WIDTH/8, SCREEN_HEIGHT);
+    if(n != expected || ScanDark()){
+        printf(RED "wrong, should be %d\n" DEFCOL, expected);
+        return 1;
+    }
+    printf(GREEN "OK\n" DEFCOL);
+    return 0;
+}
+
+// check that update costs only rows changed
+static int checkcost(){
+    uint8_t data[SCREEN_MAXPANELS*PANEL_QUARTER_SZ];
+    int errs = 0;
+    ScreenOFF();
+    SetPanels(2, 2, 0);
+    ShowScreen();
+    int16_t Y = SCREEN_HEIGHT-1-curfont->baseline;
+    PutStringAt(0, Y, "5");
+    errs += costline("One digit", ScreenSaved(), curfont->height);
+    PutStringAt(40, Y, "7");
+    errs += costline("One more in the same rows", ScreenSaved(), curfont->height);
+    XorRect(3, 2, 10, 3);
+    errs += costline("Cursor in other rows", ScreenSaved(), curfont->height + 3);
+    UpdateScreen();
+    ScanGather(data, 0, 0); // new frame
+    errs += costline("After update is shown", ScreenSaved(), 0);
+    MarqueeStart("Text", Y);
+    UpdateScreen();
+    ScanGather(data, 0, 0);
+    MarqueeStep(1);
+    errs += costline("Marquee step", ScreenSaved(), curfont->height);
+    MarqueeStop();
+    ScreenOFF();
+    SetPanels(2, 1, 0);
+    return errs;
+}
+
+// check marquee against text drawn by PutStringAt
+static int checkmarquee(char *str, int steps){
+    static uint8_t ref[SCREENBUF_MAXSZ];
+    uint8_t *buf = getScreenBuf();
+    int16_t Y = SCREEN_HEIGHT-1-curfont->baseline, errs = 0;
+    FillScreen(0);
+    int16_t W = PutStringAt(0, Y, str);
+    SetColor(SCREEN_LEVELS - 1);
+    FillScreen(0);
+    MarqueeStart(str, Y);
+    int16_t X = SCREEN_WIDTH; // reference: text at position X, repeated with gap
+    for(int k = 1; k <= steps; ++k){
+        uint8_t n = 1 + rand() % 5;
+        MarqueeStep(n);
+        memcpy(ref, buf, SCREENBUF_SZ);
+        X -= n;
+        while(X + W + MARQUEE_GAP <= 0) X += W + MARQUEE_GAP;
+        FillScreen(0);
+        for(int16_t x = X; x < SCREEN_WIDTH; x += W + MARQUEE_GAP) PutStringAt(x, Y, str);
+        if(memcmp(ref, buf, SCREENBUF_SZ)){
+            if(!errs++) printf(RED "Marquee differs at step %d\n" DEFCOL, k);
+        }
+        memcpy(buf, ref, SCREENBUF_SZ);
+    }
+    MarqueeStop();
+    if(!errs) printf(GREEN "Marquee OK (%d steps)\n" DEFCOL, steps);
+    return errs;
+}
+
+// check that the same text in UTF-8 and KOI8-R is drawn equally
+static int checkencoding(const char *utf, const char *koi){
+    static uint8_t ref[SCREENBUF_MAXSZ];
+    uint8_t *buf = getScreenBuf();
+    int16_t Y = SCREEN_HEIGHT-1-curfont->baseline;
+    FillScreen(0);
+    int16_t W = PutStringAt(0, Y, utf);
+    memcpy(ref, buf, SCREENBUF_SZ);
+    set_encoding(ENC_KOI8R);
+    FillScreen(0);
+    int errs = (PutStringAt(0, Y, koi) != W || memcmp(ref, buf, SCREENBUF_SZ));
+    set_encoding(ENC_UTF8);
+    if(errs) printf(RED "UTF-8 and KOI8-R texts differ\n" DEFCOL);
+    else printf(GREEN "UTF-8 == KOI8-R (%dpx)\n" DEFCOL, W);
+    return errs;
+}
+
 int main(int argc, char **argv){
+    if(argc == 2 && strcmp(argv[1], "-c") == 0){
+        const uint8_t topo[][3] = {{2,1,0}, {1,1,0}, {4,1,0}, {2,2,0}, {2,2,1}, {3,3,1}, {4,4,1}, {16,1,0}, {1,16,1}};
+        for(unsigned i = 0; i < sizeof(topo)/sizeof(topo[0]); ++i)
+            checkchain(topo[i][0], topo[i][1], topo[i][2], 200);
+        SetPanels(2, 1, 0);
+        checkmarquee("Marquee text, 123", 2000);
+        SetPanels(4, 2, 1);
+        checkmarquee("AB", 500);
+        SetPanels(2, 1, 0);
+        checkmarquee("\xd0\x81\xd0\xb6 \xd1\x91\xd0\xb6", 500); // UTF-8 "Ёж ёж"
+        checkencoding("\xd0\x81\xd0\xb6 \xd1\x91\xd0\xb6", "\xb3\xd6 \xa3\xd6");
+        SetPanels(2, 1, 0);
+        return 0;
+    }
+    if(argc == 2 && strcmp(argv[1], "-s") == 0){
+        const uint8_t topo[][3] = {{2,1,0}, {1,1,0}, {4,1,0}, {2,2,1}, {16,1,0}};
+        for(unsigned i = 0; i < sizeof(topo)/sizeof(topo[0]); ++i)
+            checkswap(topo[i][0], topo[i][1], topo[i][2], 20000);
+        SetPanels(2, 1, 0);
+        return 0;
+    }
+    if(argc == 2 && strcmp(argv[1], "-d") == 0){
+        checkcost();
+        return 0;
+    }
+    if(argc == 3 || argc == 4){
+        if(strcmp(argv[1], "-b")) goto usage;
+        int N = (argc == 4) ? atoi(argv[3]) : 10000;
+        if(N < 1) N = 1;
+        for(font_t f = FONT14; f < FONT_T_MAX; ++f){
+            choose_font(f);
+            printf("FONT%d: ", f == FONT14 ? 14 : 16);
+            int errs = check(argv[2]);
+            if(errs) printf(RED "%d errors\n" DEFCOL, errs);
+            else printf(GREEN "blitter == DrawPix\n" DEFCOL);
+            benchmark(argv[2], N);
+        }
+        choose_font(FONT14);
+        return 0;
+    }
     if(argc != 2){
-        fprintf(stderr, "USAGE: %s string\n", argv[0]);
+usage:
+        fprintf(stderr, "USAGE: %s string\n       %s -b string [N] - check & benchmark blitter (N iterations)\n"
+                "       %s -c - check panels chains & marquee\n"
+                "       %s -s - check updates of scanned screen\n"
+                "       %s -d - check cost of updates\n", argv[0], argv[0], argv[0], argv[0], argv[0]);
         return 1;
     }
     printf("\n\nFONT14:\n\n");
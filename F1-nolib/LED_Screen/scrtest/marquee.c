@@ -0,0 +1,93 @@
+/*
+ * This file is part of the LED_screen project.
+ * Copyright 2019 Edward V. Emelianov <eddy@sao.ru, edward.emelianoff@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Marquee: text scrolls from right to left in band of font height.
+ * Only visible part of text exists as bitmap (in screenbuf): on each step band is
+ * scrolled and new columns at right edge are drawn directly from font tables,
+ * so message length isn't limited by screen buffer size.
+ */
+
+#include "fonts.h"
+#include "marquee.h"
+#include "screen.h"
+
+static char text[MARQUEE_MAXLEN + 1]; // message
+static uint8_t active = 0;
+static int16_t baseY;       // baseline
+static uint16_t curchar;    // last drawn char (could be cut by right edge)
+static int16_t curX;        // its X coordinate
+static const char *nextchar;// next char to draw
+static int16_t nextX;       // its X coordinate
+
+/**
+ * @brief MarqueeStart - start scrolling of text
+ * @param str - text (will be copied, trailing '\n' is omitted)
+ * @param Y   - baseline coordinate
+ */
+void MarqueeStart(const char *str, int16_t Y){
+    int l = 0;
+    while(l < MARQUEE_MAXLEN && str[l] && str[l] != '\n'){
+        text[l] = str[l];
+        ++l;
+    }
+    text[l] = 0;
+    if(!l){
+        active = 0;
+        return;
+    }
+    baseY = Y;
+    curchar = 0;
+    nextchar = text;
+    nextX = SCREEN_WIDTH; // message starts at right edge
+    FillRect(0, Y + 1 - curfont->height + curfont->baseline, SCREEN_WIDTH, curfont->height, 0);
+    active = 1;
+}
+
+void MarqueeStop(){
+    active = 0;
+}
+
+uint8_t MarqueeActive(){
+    return active;
+}
+
+/**
+ * @brief MarqueeStep - scroll text by n pixels
+ * @param n - amount of pixels
+ */
+void MarqueeStep(uint8_t n){
+    if(!active || !n) return;
+    int16_t top = baseY + 1 - curfont->height + curfont->baseline;
+    ScrollH(top, curfont->height, -n, 0);
+    curX -= n;
+    nextX -= n;
+    // draw rest of last char: its left part is the same as already scrolled
+    if(curchar) DrawCharAt(curX, baseY, curchar);
+    while(nextX < SCREEN_WIDTH){
+        uint16_t code = next_char(&nextchar);
+        if(!code){ // end of message: restart after gap
+            nextchar = text;
+            nextX += MARQUEE_GAP;
+            continue;
+        }
+        curchar = code;
+        curX = nextX;
+        nextX += DrawCharAt(curX, baseY, curchar);
+    }
+}
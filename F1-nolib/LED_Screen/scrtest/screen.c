@@ -27,19 +27,118 @@
 // Y coordinate - from top to bottom!
 // (0,0) is top left corner
 
-// all-screen buffer
-static uint8_t screenbuf[SCREENBUF_SZ];
-// buffers for DMA - for each of four parts
-static uint8_t dmabuf[4][SCREENBUF_SZ/4];
+// current screen size
+uint16_t ScreenW = 2*PANEL_WIDTH, ScreenH = PANEL_HEIGHT;
+// panels chain
+static panelchain chain = {.cols = 2, .rows = 1, .serpentine = 0};
+static uint8_t npanels = 2;
+/*
+ * all-screen buffer: bit-planes from LSB to MSB of pixel level,
+ * each plane is SCREEN_HEIGHT rows of SCREEN_WIDTH/8 bytes.
+ * Drawing functions always change it, so it holds the latest image. While screen is
+ * scanned, each row is saved before its first change after UpdateScreen(), and scan
+ * engine shows saved copy instead of changed row: drawn image is shown since the frame
+ * after UpdateScreen(), so frame is never shown half-drawn, and cost of update is
+ * proportional to amount of changed rows.
+ */
+static uint8_t screenbuf[SCREEN_PLANES][SCREENBUF_MAXSZ] __attribute__((aligned(4)));
+/*
+ * Saved rows: savebuf holds two maps (screen row -> slot number + 1, 0 if row isn't saved)
+ * and two pools of slots (screen row number and its data of all bit-planes).
+ * Pool `drawpool` gets rows as they were at the last update; UpdateScreen() passes it to
+ * scan engine, which shows its rows till the beginning of next frame and then frees it,
+ * and drawing goes on with another (empty) pool. So drawing functions and scan interrupt
+ * never change the same pool.
+ */
+static uint8_t savebuf[SCREEN_SAVE_SZ] __attribute__((aligned(4)));
+#define SAVE_MAPSZ          ((SCREEN_HEIGHT + 3) & ~3)
+#define SAVE_SLOTSZ         (4 + SCREEN_PLANES*SCREEN_WIDTH/8)
+#define SAVE_POOLSZ         (((SCREEN_SAVE_SZ - 2*SAVE_MAPSZ) / 2) & ~3)
+#define SAVE_MAP(k)         (&savebuf[(k)*SAVE_MAPSZ])
+#define SAVE_SLOT(k, s)     (&savebuf[2*SAVE_MAPSZ + (k)*SAVE_POOLSZ + (s)*SAVE_SLOTSZ])
+static volatile uint8_t savedn[2];      // amount of used slots in each pool
+static volatile uint8_t lost[2];        // pool overflowed: some changed rows aren't saved
+static volatile uint8_t drawpool = 0;   // pool of drawing functions
+static volatile uint8_t swapreq = 0;    // another pool is passed to scan engine, wait for next frame
+static volatile uint8_t scanning = 0;
+// current drawing level
+static uint8_t color = SCREEN_LEVELS - 1;
+
+/*
+ * Blitter: all primitives clip rectangle once and then work with whole bytes
+ * of screenbuf rows (glyph rows are shifted as 32-bit words).
+ * In screenbuf MSB of byte is the leftmost pixel, so byte order is big-endian.
+ */
+
+/*
+ * apply `data` under `mask` to screen byte `ptr` of all bit-planes
+ * (`ptr` points to plane 0, pixels of `data` are drawn by current color)
+ */
+static inline void applybyte(uint8_t *ptr, uint8_t data, uint8_t mask, blitmode mode){
+    if(mode == BLIT_XOR){ // invert level
+        for(uint8_t p = 0; p < SCREEN_PLANES; ++p, ptr += SCREENBUF_MAXSZ) *ptr ^= data & mask;
+        return;
+    }
+    if(mode == BLIT_OR){ // draw only 1
+        mask &= data;
+        data = 0xff;
+    }
+    for(uint8_t p = 0; p < SCREEN_PLANES; ++p, ptr += SCREENBUF_MAXSZ){
+        uint8_t d = (color & (1 << p)) ? data : 0;
+        if(SCREEN_IS_NEGATIVE) d = ~d;
+        *ptr = (*ptr & ~mask) | (d & mask);
+    }
+}
+
+// free pool k (screen is off or its rows are already shown)
+static void dropsaved(uint8_t k){
+    uint8_t *map = SAVE_MAP(k);
+    for(uint8_t s = 0; s < savedn[k]; ++s) map[*SAVE_SLOT(k, s)] = 0;
+    savedn[k] = 0;
+    lost[k] = 0;
+}
+
+// save rows Y..Y+h-1 (if screen is scanned) before their first change since last update
+static void saverows(int16_t Y, int16_t h){
+    if(!scanning) return;
+    const uint16_t rowsz = SCREEN_WIDTH/8;
+    uint8_t k = drawpool, *map = SAVE_MAP(k);
+    uint16_t nslots = SAVE_POOLSZ / SAVE_SLOTSZ;
+    if(nslots > 255) nslots = 255;
+    for(; h; --h, ++Y){
+        if(map[Y]) continue;
+        uint8_t s = savedn[k];
+        if(s >= nslots){ // no place: screen will be dark till update
+            lost[k] = 1;
+            return;
+        }
+        uint8_t *slot = SAVE_SLOT(k, s);
+        uint32_t *dst = (uint32_t*)(slot + 4);
+        slot[0] = Y;
+        for(uint8_t p = 0; p < SCREEN_PLANES; ++p){
+            const uint32_t *src = (const uint32_t*)&screenbuf[p][Y*rowsz];
+            for(uint16_t i = 0; i < rowsz/4; ++i) *dst++ = src[i];
+        }
+        __sync_synchronize(); // data should be in slot before scan engine sees it
+        map[Y] = s + 1;
+        savedn[k] = s + 1;
+    }
+}
 
 /**
  * @brief FillScreen - fill screen buffer with 0 or 1
  * @param setclear   - !=1 to set & ==0 to reset
  */
 void FillScreen(uint8_t setclear){
-    uint8_t pattern = 0;
-    if(setclear) pattern = 0xff;
-    memset(screenbuf, pattern, SCREENBUF_SZ);
+    saverows(0, SCREEN_HEIGHT);
+    for(uint8_t p = 0; p < SCREEN_PLANES; ++p){
+        uint8_t pattern = 0;
+        if(setclear && (color & (1 << p))) pattern = 0xff;
+        if(SCREEN_IS_NEGATIVE) pattern = ~pattern;
+        for(int i = 0; i < SCREENBUF_SZ; ++i) screenbuf[p][i] = pattern;
+        // memset -> halt
+        //memset(screenbuf[p], pattern, SCREENBUF_SZ);
+    }
 }
 
 /**
@@ -49,67 +148,371 @@ void FillScreen(uint8_t setclear){
  */
 void DrawPix(int16_t X, int16_t Y, uint8_t pix){
     if(X < 0 || X > SCREEN_WIDTH-1 || Y < 0 || Y > SCREEN_HEIGHT-1) return; // outside of screen
+    saverows(Y, 1);
     // now calculate coordinate of pixel
-    uint8_t *ptr = &screenbuf[Y*SCREEN_WIDTH/8 + X/8];
-    if(SCREEN_IS_NEGATIVE)pix = !pix;
-    if(pix) *ptr |= 1 << (7 - (X%8));  // only for little-endian
-    else *ptr &= ~(1 << (7 - (X%8))); // only for little-endian
+    uint8_t *ptr = &screenbuf[0][Y*SCREEN_WIDTH/8 + X/8];
+    applybyte(ptr, pix ? 0xff : 0, 1 << (7 - (X%8)), BLIT_COPY); // only for little-endian
+}
+
+/**
+ * @brief SetColor - set level of pixels for all drawing functions
+ * @param level - 0..SCREEN_LEVELS-1
+ */
+void SetColor(uint8_t level){
+    if(level >= SCREEN_LEVELS) level = SCREEN_LEVELS - 1;
+    color = level;
+}
+
+// source of image rows for blitter: bitmap placed in cell (rows outside of it are empty)
+typedef struct{
+    const uint8_t *bits;    // bitmap data
+    uint16_t pos;           // current bit (raw) or nibble (RLE) of data
+    uint16_t stride;        // length of bitmap row in bits (raw)
+    uint8_t w, h;           // bitmap size
+    uint8_t left, top;      // bitmap position in cell
+    uint8_t row;            // current row of cell
+    uint8_t rle;            // data is RLE-compressed
+    uint8_t color, run, tog;// RLE state: current color, rest of its run, toggle color after run
+} rowsrc;
+
+// next row of cell (MSB is leftmost pixel)
+static uint32_t nextrow(rowsrc *s){
+    uint8_t r = s->row++;
+    if(r < s->top || r - s->top >= s->h || !s->w) return 0;
+    uint32_t row = 0;
+    if(s->rle){ // nibbles: run of n<15 pixels then change color or run of 15 pixels
+        for(uint8_t x = 0; x < s->w;){
+            while(!s->run){
+                if(s->tog) s->color = !s->color;
+                uint8_t n = s->bits[s->pos >> 1];
+                n = (s->pos++ & 1) ? n & 0x0f : n >> 4;
+                s->run = n;
+                s->tog = (n < 15);
+            }
+            uint8_t n = s->w - x;
+            if(n > s->run) n = s->run;
+            if(s->color){
+                uint32_t m = 0xffffffff >> x;
+                if(x + n < 32) m &= ~(0xffffffff >> (x + n));
+                row |= m;
+            }
+            x += n;
+            s->run -= n;
+        }
+    }else{ // bit-packed rows: up to 5 bytes for 32 bits at any bit position
+        const uint8_t *p = &s->bits[s->pos >> 3];
+        uint8_t sh = s->pos & 7, nb = (sh + s->w + 7) >> 3;
+        for(uint8_t i = 0; i < nb && i < 4; ++i) row |= (uint32_t)p[i] << (24 - 8*i);
+        row <<= sh;
+        if(nb > 4) row |= p[4] >> (8 - sh);
+        if(s->w < 32) row &= ~(0xffffffff >> s->w);
+        s->pos += s->stride;
+    }
+    return row >> s->left;
+}
+
+// draw w x h pixels of src @ X,Y
+static void blit(int16_t X, int16_t Y, rowsrc *src, uint8_t w, uint8_t h, blitmode mode){
+    int16_t W = w, H = h, skip = 0;
+    if(W > 32) W = 32;
+    // clip once
+    if(Y + H <= 0 || Y >= SCREEN_HEIGHT) return;
+    for(; Y < 0; ++Y, --H) nextrow(src);
+    if(Y + H > SCREEN_HEIGHT) H = SCREEN_HEIGHT - Y;
+    if(X < 0){ skip = -X; W += X; X = 0; }
+    if(X + W > SCREEN_WIDTH) W = SCREEN_WIDTH - X;
+    if(W <= 0 || H <= 0) return;
+    uint8_t sh = X & 7, nbytes = (sh + W + 7) >> 3;
+    uint32_t mask = (W == 32) ? 0xffffffff : ~(0xffffffff >> W);
+    // mask shifted to screen byte boundary: 32 bits + 8 bits tail
+    uint32_t mhi = mask >> sh;
+    uint8_t mlo = (uint8_t)(mask << (8 - sh));
+    saverows(Y, H);
+    uint8_t *ptr = &screenbuf[0][Y*(SCREEN_WIDTH/8) + X/8];
+    for(; H; --H, ptr += SCREEN_WIDTH/8){
+        uint32_t row = nextrow(src) << skip;
+        uint32_t dhi = row >> sh;
+        for(uint8_t i = 0; i < nbytes; ++i){
+            if(i < 4) applybyte(&ptr[i], (uint8_t)(dhi >> (24 - 8*i)), (uint8_t)(mhi >> (24 - 8*i)), mode);
+            else applybyte(&ptr[i], (uint8_t)(row << (8 - sh)), mlo, mode);
+        }
+    }
+}
+
+/**
+ * @brief BlitBits - draw 1bpp image (MSB is leftmost pixel)
+ * @param X, Y   - coordinates of left upper corner (could be outside of screen)
+ * @param bits   - image data
+ * @param w      - width (px), not more than 32
+ * @param h      - height (px)
+ * @param stride - length of image row in bytes
+ * @param mode   - BLIT_COPY to draw 0 & 1, BLIT_OR to draw only 1, BLIT_XOR to invert under 1
+ */
+void BlitBits(int16_t X, int16_t Y, const uint8_t *bits, uint8_t w, uint8_t h, uint8_t stride, blitmode mode){
+    rowsrc src = {.bits = bits, .stride = stride * 8, .w = w > 32 ? 32 : w, .h = h};
+    blit(X, Y, &src, w, h, mode);
+}
+
+// set/clear/invert rectangle: left and right bytes by mask, middle - whole bytes
+static void rectop(int16_t X, int16_t Y, int16_t w, int16_t h, uint8_t setclear, blitmode mode){
+    if(X < 0){ w += X; X = 0; }
+    if(Y < 0){ h += Y; Y = 0; }
+    if(X + w > SCREEN_WIDTH) w = SCREEN_WIDTH - X;
+    if(Y + h > SCREEN_HEIGHT) h = SCREEN_HEIGHT - Y;
+    if(w <= 0 || h <= 0) return;
+    int16_t x0 = X >> 3, x1 = (X + w - 1) >> 3;
+    uint8_t m0 = 0xff >> (X & 7), m1 = 0xff << (7 - ((X + w - 1) & 7));
+    if(x0 == x1) m0 &= m1;
+    uint8_t data = setclear ? 0xff : 0;
+    saverows(Y, h);
+    uint8_t *ptr = &screenbuf[0][Y*(SCREEN_WIDTH/8)];
+    for(; h; --h, ptr += SCREEN_WIDTH/8){
+        applybyte(&ptr[x0], data, m0, mode);
+        if(x0 == x1) continue;
+        for(int16_t x = x0 + 1; x < x1; ++x) applybyte(&ptr[x], data, 0xff, mode);
+        applybyte(&ptr[x1], data, m1, mode);
+    }
+}
+
+/**
+ * @brief FillRect - set or clear rectangle
+ * @param X, Y - left upper corner
+ * @param w, h - size
+ * @param setclear - !=0 to set & ==0 to reset
+ */
+void FillRect(int16_t X, int16_t Y, int16_t w, int16_t h, uint8_t setclear){
+    rectop(X, Y, w, h, setclear, BLIT_COPY);
+}
+
+/**
+ * @brief XorRect - invert rectangle (e.g. cursor: call twice to restore)
+ * @param X, Y - left upper corner
+ * @param w, h - size
+ */
+void XorRect(int16_t X, int16_t Y, int16_t w, int16_t h){
+    rectop(X, Y, w, h, 1, BLIT_XOR);
+}
+
+/**
+ * @brief ScrollH - scroll rows horizontally
+ * @param Y, h - first row and amount of rows
+ * @param dx - shift (px): >0 - to the right, <0 - to the left
+ * @param setclear - value of freed pixels
+ */
+void ScrollH(int16_t Y, int16_t h, int16_t dx, uint8_t setclear){
+    if(Y < 0){ h += Y; Y = 0; }
+    if(Y + h > SCREEN_HEIGHT) h = SCREEN_HEIGHT - Y;
+    if(h <= 0 || dx == 0) return;
+    if(dx >= SCREEN_WIDTH || dx <= -SCREEN_WIDTH){
+        FillRect(0, Y, SCREEN_WIDTH, h, setclear);
+        return;
+    }
+    const int16_t rowsz = SCREEN_WIDTH/8;
+    int16_t n = dx < 0 ? -dx : dx, nb = n >> 3;
+    uint8_t sh = n & 7;
+    saverows(Y, h);
+    for(uint8_t p = 0; p < SCREEN_PLANES; ++p){
+        uint8_t fill = (setclear && (color & (1 << p))) ? 0xff : 0;
+        if(SCREEN_IS_NEGATIVE) fill = ~fill;
+        uint8_t *ptr = &screenbuf[p][Y*rowsz];
+        for(int16_t r = h; r; --r, ptr += rowsz){
+            if(dx < 0){ // left: pixel x gets pixel x+n
+                for(int16_t i = 0; i < rowsz; ++i){
+                    uint16_t hi = (i + nb < rowsz) ? ptr[i + nb] : fill;
+                    uint16_t lo = (i + nb + 1 < rowsz) ? ptr[i + nb + 1] : fill;
+                    ptr[i] = (uint8_t)((((hi << 8) | lo) << sh) >> 8);
+                }
+            }else{ // right: pixel x gets pixel x-n
+                for(int16_t i = rowsz - 1; i >= 0; --i){
+                    uint16_t hi = (i - nb - 1 >= 0) ? ptr[i - nb - 1] : fill;
+                    uint16_t lo = (i - nb >= 0) ? ptr[i - nb] : fill;
+                    ptr[i] = (uint8_t)(((hi << 8) | lo) >> sh);
+                }
+            }
+        }
+    }
 }
 
 /**
  * @brief DrawCharAt - draws character @ position X,Y (this point is left baseline corner of char!)
+ * Glyph bitmap is decoded directly from font (bit-packed or RLE), the rest of character
+ * cell is cleared.
  * @param X, Y  - started point
-  * @param Char - char to draw
+ * @param code - Unicode code point of char to draw
  * @return char width
  */
-uint8_t DrawCharAt(int16_t X, int16_t Y, uint8_t Char){
-    const uint8_t *curchar = font_char(Char);
-    if(!curchar) return 0;
+uint8_t DrawCharAt(int16_t X, int16_t Y, uint16_t code){
+    const glyph_t *g = font_glyph(code);
+    if(!g) return 0;
     // now change Y coordinate to left upper corner of font
     Y += 1 - curfont->height + curfont->baseline;
-    // height and width of letter in pixels
-    uint8_t h = curfont->height, w = *curchar++; // now curchar is pointer to bits array
-    uint8_t lw = curfont->bytes / h; // width of letter in bytes
-    for(uint8_t row = 0; row <= h; ++row){
-        for(uint8_t col = 0; col < w; ++col){
-            DrawPix(X + col, Y + row, curchar[row*lw + (col/8)] & (1 << (7 - (col%8)))); // only for little-endian
-        }
+    rowsrc src = {.bits = &curfont->bitmaps[g->offset], .stride = g->w, .w = g->w, .h = g->h,
+                  .left = g->left, .top = g->top, .rle = g->flags & GLYPH_RLE};
+    blit(X, Y, &src, g->width, curfont->height, BLIT_COPY);
+    return g->width;
+}
+
+// reverse bits order in byte
+static inline uint8_t rev8(uint8_t b){
+    b = (b >> 4) | (b << 4);
+    b = ((b & 0xCC) >> 2) | ((b & 0x33) << 2);
+    return ((b & 0xAA) >> 1) | ((b & 0x55) << 1);
+}
+
+// row Y of bit-plane P as it should be shown now: saved copy or screenbuf row
+static inline const uint8_t *shownrow(uint16_t Y, uint8_t P){
+    uint8_t k = !drawpool; // first look for rows saved before last update
+    for(uint8_t i = 0; i < 2; ++i, k = !k){
+        uint8_t s = SAVE_MAP(k)[Y];
+        if(s) return SAVE_SLOT(k, s - 1) + 4 + P*(SCREEN_WIDTH/8);
     }
-    return w;
+    return &screenbuf[P][Y*(SCREEN_WIDTH/8)];
 }
 
 /**
- * @brief ConvertScreenBuf - convert scscreenbuf into dmabuf
+ * @brief ScanGather - prepare SPI data of bit-plane P of quarter Q for whole chain
+ * Panels are numbered from the far end of chain: row by row from left upper corner,
+ * in serpentine layout odd rows go from right to left and their panels are upside down.
+ * Data of far panel is sent first, inside panel: by 8px columns from left to right,
+ * each column - rows of quarter from bottom to top.
+ * Plane 0 of quarter 0 begins new frame: image of last UpdateScreen() is shown since it.
+ * @param buf (o) - buffer of SCREEN_MAXPANELS*PANEL_QUARTER_SZ bytes
+ * @param Q - quarter
+ * @param P - bit-plane
+ * @return amount of bytes
  */
-void ConvertScreenBuf(){
-    for(uint8_t partNo = 0; partNo < 4; ++ partNo){ // cycle by strings
-        uint8_t *dmaptr = dmabuf[partNo];
-        for(int X = 0; X < SCREEN_WIDTH/8; ++X){
-            for(int Y = SCREEN_HEIGHT-4+partNo; Y >= 0; Y -= 4){ // and cycle by Y
-                *dmaptr++ = screenbuf[X + Y*(SCREEN_WIDTH/8)];
+uint16_t ScanGather(uint8_t *buf, uint8_t Q, uint8_t P){
+    if(Q == 0 && P == 0 && swapreq){ // new frame: rows saved before update aren't needed
+        dropsaved(!drawpool);
+        swapreq = 0;
+    }
+    uint8_t *ptr = buf;
+    for(uint8_t i = 0; i < npanels; ++i){
+        uint8_t row = i / chain.cols, col = i % chain.cols;
+        uint8_t rot = chain.serpentine && (row & 1);
+        if(rot) col = chain.cols - 1 - col;
+        const uint8_t *prow[PANEL_HEIGHT/4]; // rows of quarter from bottom to top
+        for(int j = 0; j < PANEL_HEIGHT/4; ++j){
+            int Y = PANEL_HEIGHT-4+Q - 4*j;
+            if(rot) Y = PANEL_HEIGHT-1-Y;
+            prow[j] = shownrow(row*PANEL_HEIGHT + Y, P) + col*(PANEL_WIDTH/8);
+        }
+        for(int X = 0; X < PANEL_WIDTH/8; ++X){
+            for(int j = 0; j < PANEL_HEIGHT/4; ++j){
+                if(rot) *ptr++ = rev8(prow[j][PANEL_WIDTH/8-1-X]);
+                else *ptr++ = prow[j][X];
             }
         }
     }
+    return ptr - buf;
+}
+
+/**
+ * @brief SetPanels - change panels chain (screen should be off), clear screen
+ * @param cols - panels in each row
+ * @param rows - rows of panels
+ * @param serpentine - !=0 if chain goes back in odd rows (panels are upside down)
+ * @return 0 if all OK, 1 if too many panels
+ */
+uint8_t SetPanels(uint8_t cols, uint8_t rows, uint8_t serpentine){
+    if(!cols || !rows || cols*rows > SCREEN_MAXPANELS) return 1;
+    UpdateScreen();
+    chain.cols = cols;
+    chain.rows = rows;
+    chain.serpentine = serpentine;
+    npanels = cols * rows;
+    ScreenW = cols * PANEL_WIDTH;
+    ScreenH = rows * PANEL_HEIGHT;
+    // layout of saved rows is changed: clear maps
+    for(int i = 0; i < 2*SAVE_MAPSZ; ++i) savebuf[i] = 0;
+    FillScreen(0);
+    return 0;
 }
 
+/**
+ * @brief GetPanels - get current chain
+ * @return amount of panels
+ */
+uint8_t GetPanels(panelchain *c){
+    if(c) *c = chain;
+    return npanels;
+}
 
 /**
  * @brief PutStringAt - draw text string @ screen
  * @param X, Y - base coordinates
- * @param str  - string to draw
+ * @param str  - string to draw (encoding is set by set_encoding())
  * @return - text width in pixels
  */
-uint8_t PutStringAt(int16_t X, int16_t Y, char *str){
+uint8_t PutStringAt(int16_t X, int16_t Y, const char *str){
     if(!str) return 0;
     int16_t Xold = X;
-    while(*str){
-        X += DrawCharAt(X, Y, *str++);
+    uint16_t code;
+    while((code = next_char(&str))){
+        X += DrawCharAt(X, Y, code);
     }
     return X - Xold;
 }
 
-uint8_t *getScreenBuf(){return screenbuf;}
-uint8_t *getDmaBuf(uint8_t N){
-    if(N > 3) return NULL;
-    return dmabuf[N];
+/**
+ * @brief getScreenBuf - get screen buffer (bit-planes of SCREENBUF_MAXSZ bytes)
+ * Rows changed directly aren't saved, so change them only while screen is off.
+ * @return plane 0
+ */
+uint8_t *getScreenBuf(){return screenbuf[0];}
+
+/**
+ * @brief UpdateScreen - show drawn image since next frame (at once if scan is off)
+ * @return 0 if previous image isn't shown yet (call again later), 1 if OK
+ */
+uint8_t UpdateScreen(){
+    if(!scanning){ // nothing to wait for
+        dropsaved(0);
+        dropsaved(1);
+        swapreq = 0;
+        return 1;
+    }
+    if(swapreq) return 0;
+    drawpool = !drawpool; // new pool is empty: it was freed at frame beginning
+    swapreq = 1;
+    return 1;
+}
+
+/**
+ * @brief ScreenUpdating - check whether drawn image waits for the next frame
+ * @return 1 if last UpdateScreen() isn't shown yet
+ */
+uint8_t ScreenUpdating(){
+    return swapreq && scanning;
+}
+
+/**
+ * @brief ScreenSaved - cost of next update
+ * @return amount of rows saved since last UpdateScreen()
+ */
+uint16_t ScreenSaved(){
+    return savedn[drawpool];
+}
+
+/**
+ * @brief ScanDark - check whether scanned data could be half-drawn
+ * (too many rows were changed between updates), then screen is dark till update is shown
+ * @return 1 if screen should be dark
+ */
+uint8_t ScanDark(){
+    return lost[0] || lost[1];
+}
+
+/*
+ * Scan engine is hardware-dependent (TIM2 & SPI DMA, see ../screen.c), here is only its
+ * state: scan is made by ScanGather() calls
+ */
+void ShowScreen(){
+    UpdateScreen();
+    scanning = 1;
+}
+
+void ScreenOFF(){
+    scanning = 0;
+    UpdateScreen(); // drop saved rows
 }
@@ -22,22 +22,64 @@
 
 #include <stdint.h>
 
-// display size in px
-// PANEL_WIDTH is width of one panel
+// panel size in px
 #define PANEL_WIDTH         32
-// SCREEN_WIDTH is total screen width
-#define SCREEN_WIDTH        64
-#define SCREEN_HEIGHT       16
+#define PANEL_HEIGHT        16
+// max amount of panels in chain
+#define SCREEN_MAXPANELS    16
+#define SCREENBUF_MAXSZ     (SCREEN_MAXPANELS*PANEL_WIDTH*PANEL_HEIGHT/8)
+// bytes of one quarter of panel
+#define PANEL_QUARTER_SZ    (PANEL_WIDTH*PANEL_HEIGHT/32)
+// current screen size, px (depends on panels chain)
+extern uint16_t ScreenW, ScreenH;
+#define SCREEN_WIDTH        ScreenW
+#define SCREEN_HEIGHT       ScreenH
 #define SCREENBUF_SZ        (SCREEN_WIDTH*SCREEN_HEIGHT/8)
 
+// amount of bit-planes: pixel levels 0..SCREEN_LEVELS-1 (binary coded modulation)
+#define SCREEN_PLANES       3
+#define SCREEN_LEVELS       (1 << SCREEN_PLANES)
+// buffer for rows saved while screen is scanned (see screen.c): two pools, each holds
+// whole screen of SCREEN_SAVE_PANELS panels in a row; if more rows are changed between
+// updates, screen is dark till update is shown
+#define SCREEN_SAVE_PANELS  4
+#define SCREEN_SAVE_SZ      (2*PANEL_HEIGHT*(1 + 4 + SCREEN_SAVE_PANELS*SCREEN_PLANES*PANEL_WIDTH/8))
+
 // screen is positive (1->on, 0->off)
 #define SCREEN_IS_NEGATIVE  0
 
+// panels chain: cols*rows panels
+typedef struct{
+    uint8_t cols;       // panels in row
+    uint8_t rows;       // rows of panels
+    uint8_t serpentine; // odd rows of panels go from right to left and are upside down
+} panelchain;
+
+// blitter drawing modes
+typedef enum{
+    BLIT_COPY,  // draw both 0 and 1
+    BLIT_OR,    // draw only 1 (transparent background)
+    BLIT_XOR    // invert pixels under 1
+} blitmode;
+
 void FillScreen(uint8_t setclear);
 void DrawPix(int16_t X, int16_t Y, uint8_t pix);
-uint8_t DrawCharAt(int16_t X, int16_t Y, uint8_t Char);
-void ConvertScreenBuf();
-uint8_t PutStringAt(int16_t X, int16_t Y, char *str);
+void SetColor(uint8_t level);
+void BlitBits(int16_t X, int16_t Y, const uint8_t *bits, uint8_t w, uint8_t h, uint8_t stride, blitmode mode);
+void FillRect(int16_t X, int16_t Y, int16_t w, int16_t h, uint8_t setclear);
+void XorRect(int16_t X, int16_t Y, int16_t w, int16_t h);
+void ScrollH(int16_t Y, int16_t h, int16_t dx, uint8_t setclear);
+uint8_t DrawCharAt(int16_t X, int16_t Y, uint16_t code);
+uint8_t PutStringAt(int16_t X, int16_t Y, const char *str);
 uint8_t *getScreenBuf();
-uint8_t *getDmaBuf(uint8_t N);
+uint16_t ScanGather(uint8_t *buf, uint8_t Q, uint8_t P);
+uint8_t SetPanels(uint8_t cols, uint8_t rows, uint8_t serpentine);
+uint8_t GetPanels(panelchain *c);
+uint8_t UpdateScreen();
+uint8_t ScreenUpdating();
+uint16_t ScreenSaved();
+uint8_t ScanDark();
+void ShowScreen();
+void ScreenOFF();
+
 #endif // SCREEN_H__
@@ -57,7 +57,7 @@ void spi_setup(){
  * @param len - its length
  * @return 0 if all OK
  */
-uint8_t SPI_transmit(const uint8_t *buf, uint8_t len){
+uint8_t SPI_transmit(const uint8_t *buf, uint16_t len){
     if(!buf || !len) return 1; // bad data format
     if(SPI_status != SPI_READY) return 2; // spi not ready to transmit data
     DMA_SPI_Channel->CMAR = (uint32_t)buf;
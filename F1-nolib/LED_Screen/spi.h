@@ -31,6 +31,6 @@ typedef enum{
 extern spiStatus SPI_status;
 
 void spi_setup();
-uint8_t SPI_transmit(const uint8_t *buf, uint8_t len);
+uint8_t SPI_transmit(const uint8_t *buf, uint16_t len);
 
 #endif // SPI_H__
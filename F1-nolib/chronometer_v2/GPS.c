@@ -21,6 +21,7 @@
 
 #include "GPS.h"
 #include "hardware.h"
+#include "nmea.h"
 #include "time.h"
 #include "usart.h"
 #include "str.h"
@@ -36,25 +37,6 @@ static uint8_t hex(uint8_t n){
     return ((n < 10) ? (n+'0') : (n+'A'-10));
 }
 
-/**
- * Check checksum
- */
-static int checksum_true(const char *buf){
-    char *eol;
-    uint8_t checksum = 0, cs[3];
-    if(*buf != '$' || !(eol = getchr(buf, '*'))){
-        return 0;
-    }
-    while(++buf != eol)
-        checksum ^= (uint8_t)*buf;
-    ++buf;
-    cs[0] = hex(checksum >> 4);
-    cs[1] = hex(checksum & 0x0f);
-    if(buf[0] == cs[0] && buf[1] == cs[1])
-        return 1;
-    return 0;
-}
-
 static void send_chksum(uint8_t chs){
     usart_putchar(GPS_USART, hex(chs >> 4));
     usart_putchar(GPS_USART, hex(chs & 0x0f));
@@ -128,52 +110,35 @@ void GPS_send_FullColdStart(){
 }
 
 /**
- * Parse answer from GPS module
- *
- * Recommended minimum specific GPS/Transit data
+ * Parse answer from GPS module: NMEA string is given to streaming parser (nmea.c),
+ * time is set by each RMC sentence with right checksum
  * $GPRMC,hhmmss.sss,status,latitude,N,longitude,E,spd,cog,ddmmyy,mv,mvE,mode*cs
- * 1    = UTC of position fix
- * 2    = Data status (V=valid, A=invalid)
- * 3    = Latitude (ddmm.mmmm)
- * 4    = N or S
- * 5    = Longitude (dddmm.mmmm)
- * 6    = E or W
- * 7    = Speed over ground in knots
- * 8    = Cource over ground in degrees
- * 9    = UT date (ddmmyy)
- * 10   = Magnetic variation degrees (Easterly var. subtracts from true course)
- * 11   = E or W
- * 12   = Mode: N(bad), E(approx), A(auto), D(diff)
- * 213457.00,A,4340.59415,N,04127.47560,E,2.494,,290615,,,A*7B
+ * status: A - valid, V - navigation receiver warning
  */
 void GPS_parse_answer(const char *buf){
-    char *ptr;
-    if(buf[1] == 'P') return; // answers to proprietary messages
-    if(cmpstr(buf+3, "RMC", 3)){ // not RMC message
-        //need2startseq = 1;
-        return;
-    }
-    if(!checksum_true(buf)){
-        return; // wrong checksum
-    }
+    const char *str = buf;
+    nmea_fix fix;
+    char tm[6];
+    uint8_t types = 0;
+    while(*buf) types |= nmea_putc((uint8_t)*buf++);
+    if(!(types & NMEA_RMC)) return; // not RMC message or wrong checksum
     if(showGPSstr){
         showGPSstr = 0;
-        sendstring(buf);
+        sendstring(str);
     }
-    buf += 7; // skip header
-    if(*buf == ','){ // time unknown
+    nmea_get(&fix);
+    if(!fix.timeok){ // time unknown
         GPS_status = GPS_WAIT;
         return;
     }
-    ptr = getchr(buf, ',');
-    if(!ptr ) return;
-    *ptr++ = 0;
-    if(*ptr == 'A'){
+    tm[0] = '0' + fix.H / 10; tm[1] = '0' + fix.H % 10;
+    tm[2] = '0' + fix.M / 10; tm[3] = '0' + fix.M % 10;
+    tm[4] = '0' + fix.S / 10; tm[5] = '0' + fix.S % 10;
+    if(fix.valid){
         GPS_status = GPS_VALID;
-        set_time(buf);
+        set_time(tm);
     }else{
-        uint8_t goth = (buf[0]-'0')*10 + buf[1]-'0';
-        if(current_time.H != goth) set_time(buf); // set time once per hour even if it's not valid
+        if(current_time.H != fix.H) set_time(tm); // set time once per hour even if it's not valid
         GPS_status = GPS_NOT_VALID;
     }
 }
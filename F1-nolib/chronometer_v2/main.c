@@ -24,6 +24,7 @@
 #include "flash.h"
 #include "hardware.h"
 #include "lidar.h"
+#include "nmea.h"
 #include "str.h"
 #include "time.h"
 #include "usart.h"
@@ -40,6 +41,7 @@ volatile uint32_t Tms = 0;
 /* Called when systick fires */
 void sys_tick_handler(void){
     ++Tms; // increment pseudo-milliseconds counter
+    systick_reload(); // set next (dithered) period
     if(++Timer == 1000){ // increment milliseconds counter
         time_increment();
     }
@@ -259,6 +261,7 @@ int main(void){
 #endif
     RCC->CSR |= RCC_CSR_RMVF; // remove reset flags
     usarts_setup(); // setup usarts after reading configuration
+    nmea_init();
     iwdg_setup();
 
     while (1){
@@ -289,25 +292,24 @@ int main(void){
             transmit_tbuf(GPS_USART);
             transmit_tbuf(LIDAR_USART);
 #ifdef EBUG
-            static int32_t oldctr = 0;
-            if(timecntr && timecntr != oldctr){
-                oldctr = timecntr;
-                SEND("ticksdiff=");
-                if(ticksdiff < 0){
+            static uint32_t oldcorr = 0;
+            if(last_corr_time != oldcorr){ // new PPS
+                int32_t phase, ppb;
+                oldcorr = last_corr_time;
+                SEND("clock=");
+                printu(1, get_clock(&phase, &ppb));
+                SEND(", phase=");
+                if(phase < 0){
                     SEND("-");
-                    printu(1, -ticksdiff);
-                }else printu(1, ticksdiff);
-                SEND(", timecntr=");
-                printu(1, timecntr);
-                SEND("\nlast_corr_time=");
-                printu(1, last_corr_time);
-                SEND(", Tms=");
-                printu(1, Tms1);
-                SEND("\nTimer=");
-                printu(1, timerval);
+                    printu(1, -phase);
+                }else printu(1, phase);
+                SEND(", ppb=");
+                if(ppb < 0){
+                    SEND("-");
+                    printu(1, -ppb);
+                }else printu(1, ppb);
                 SEND(", LOAD=");
                 printu(1, SysTick->LOAD);
-                usart_putchar(1, '\n');
                 newline(1);
             }
 #endif
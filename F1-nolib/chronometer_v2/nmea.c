@@ -0,0 +1,325 @@
+/*
+ * nmea.c - streaming NMEA parser
+ *
+ * Copyright 2015 Edward V. Emelianov <eddy@sao.ru, edward.emelianoff@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/*
+ * Sentences are parsed byte by byte (from UART interrupt, DMA buffer or text line)
+ * without any buffering except current field: checksum is calculated on the fly
+ * and fields are converted into fixed point values of pending fix, which is
+ * published only when checksum is right. Reader gets consistent copy of last fix
+ * by nmea_get() (sequence lock, so it could be called while parser works in ISR).
+ * Any talker (GP, GN, GL, ...) is accepted, proprietary sentences are ignored.
+ */
+
+#include <string.h>
+#include "nmea.h"
+
+// max sentence length (82 by standard)
+#define NMEA_MAX_LEN  (100)
+
+typedef enum{
+    ST_IDLE,    // wait for '$'
+    ST_DATA,    // sentence data
+    ST_CS1,     // first symbol of checksum
+    ST_CS2      // second symbol
+} nmea_state;
+
+static nmea_state state = ST_IDLE;
+static uint8_t csum, rxsum;           // calculated & received checksum
+static char field[NMEA_FIELD_LEN + 1];
+static uint8_t flen, fidx;            // length & number of current field
+static uint8_t type;                  // type of sentence (0 - skip it)
+static uint8_t slen;                  // sentence length
+static nmea_fix pend;                 // fix being filled
+static nmea_fix pub;                  // published fix
+static volatile uint32_t pubseq = 0;  // odd while `pub` is changing
+static nmea_stat stat;
+
+/**
+ * Parse decimal number with ndec digits after point: "12.3456" -> 123456 for ndec=4
+ * extra digits are truncated
+ */
+static int32_t fixedp(const char *s, uint8_t ndec){
+    int32_t v = 0;
+    int8_t d = -1; // digits after point (-1 - there was no point)
+    uint8_t neg = 0;
+    if(*s == '-'){
+        neg = 1;
+        ++s;
+    }
+    for(; *s; ++s){
+        if(*s == '.'){
+            d = 0;
+            continue;
+        }
+        if(*s < '0' || *s > '9') break;
+        if(d > -1){
+            if(d == ndec) continue;
+            ++d;
+        }
+        v = v * 10 + (*s - '0');
+    }
+    if(d < 0) d = 0;
+    while(d++ < ndec) v *= 10;
+    return neg ? -v : v;
+}
+
+static uint8_t dig2(const char *s){
+    return (s[0] - '0') * 10 + s[1] - '0';
+}
+
+// hhmmss.sss
+static void parse_time(const char *s){
+    uint8_t H, M, S;
+    if(strlen(s) < 6){
+        pend.timeok = 0;
+        return;
+    }
+    pend.timeok = 1;
+    H = dig2(s); M = dig2(s + 2); S = dig2(s + 4);
+    if(H != pend.H || M != pend.M || S != pend.S){ // new epoch
+        pend.updated = 0;
+        pend.H = H; pend.M = M; pend.S = S;
+    }
+    pend.ms = (s[6] == '.') ? fixedp(s + 6, 3) : 0;
+}
+
+// ddmm.mmmmm or dddmm.mmmmm -> 1e-7 degrees
+static void parse_coord(const char *s, uint8_t degdigits, int32_t *val){
+    int32_t deg = 0, min;
+    uint8_t i;
+    if(strlen(s) < (size_t)(degdigits + 2)) return;
+    for(i = 0; i < degdigits; ++i) deg = deg * 10 + s[i] - '0';
+    min = fixedp(s + degdigits, 5); // 1e-5 minutes
+    *val = deg * 10000000 + (min * 10 + 3) / 6;
+}
+
+// hemisphere goes after coordinate
+static void parse_hemi(const char *s, int32_t *val){
+    if((*s == 'S' || *s == 'W') && *val > 0) *val = -*val;
+    else if((*s == 'N' || *s == 'E') && *val < 0) *val = -*val;
+}
+
+/*
+ * $xxRMC,hhmmss.ss,status,ddmm.mm,N,dddmm.mm,E,spd(knots),cog,ddmmyy,mv,mvE,mode*cs
+ */
+static void rmc(uint8_t idx, const char *f){
+    switch(idx){
+        case 1: parse_time(f); break;
+        case 2: pend.valid = (*f == 'A'); break;
+        case 3: parse_coord(f, 2, &pend.lat); break;
+        case 4: parse_hemi(f, &pend.lat); break;
+        case 5: parse_coord(f, 3, &pend.lon); break;
+        case 6: parse_hemi(f, &pend.lon); break;
+        case 7: // knots -> mm/s: 1852/3.6 = 514.444 = 463/900 * 1000
+            if(*f) pend.speed = (fixedp(f, 3) * 463 + 450) / 900;
+        break;
+        case 8: if(*f) pend.course = fixedp(f, 2); break;
+        case 9:
+            if(strlen(f) < 6) break;
+            pend.day = dig2(f); pend.month = dig2(f + 2); pend.year = 2000 + dig2(f + 4);
+        break;
+    }
+}
+
+/*
+ * $xxGGA,hhmmss.ss,ddmm.mm,N,dddmm.mm,E,quality,sats,hdop,alt,M,geoid,M,age,station*cs
+ */
+static void gga(uint8_t idx, const char *f){
+    switch(idx){
+        case 1: parse_time(f); break;
+        case 2: parse_coord(f, 2, &pend.lat); break;
+        case 3: parse_hemi(f, &pend.lat); break;
+        case 4: parse_coord(f, 3, &pend.lon); break;
+        case 5: parse_hemi(f, &pend.lon); break;
+        case 6: pend.quality = fixedp(f, 0); break;
+        case 7: pend.sats = fixedp(f, 0); break;
+        case 8: if(*f) pend.hdop = fixedp(f, 2); break;
+        case 9: if(*f) pend.alt = fixedp(f, 2); break;
+    }
+}
+
+/*
+ * $xxGSA,mode,fixtype,sat1,...,sat12,pdop,hdop,vdop*cs
+ */
+static void gsa(uint8_t idx, const char *f){
+    switch(idx){
+        case 2: pend.fixtype = fixedp(f, 0); break;
+        case 15: if(*f) pend.pdop = fixedp(f, 2); break;
+        case 16: if(*f) pend.hdop = fixedp(f, 2); break;
+        case 17: if(*f) pend.vdop = fixedp(f, 2); break;
+    }
+}
+
+/*
+ * $xxZDA,hhmmss.ss,dd,mm,yyyy,tzh,tzm*cs
+ */
+static void zda(uint8_t idx, const char *f){
+    if(idx > 1 && !*f) return;
+    switch(idx){
+        case 1: parse_time(f); break;
+        case 2: pend.day = fixedp(f, 0); break;
+        case 3: pend.month = fixedp(f, 0); break;
+        case 4: pend.year = fixedp(f, 0); break;
+    }
+}
+
+// process current field
+static void end_field(){
+    field[flen] = 0;
+    if(fidx == 0){ // address: talker + type
+        type = 0;
+        if(flen == 5 && field[0] != 'P'){
+            const char *t = field + 2;
+            if(!strcmp(t, "RMC")) type = NMEA_RMC;
+            else if(!strcmp(t, "GGA")) type = NMEA_GGA;
+            else if(!strcmp(t, "GSA")) type = NMEA_GSA;
+            else if(!strcmp(t, "ZDA")) type = NMEA_ZDA;
+        }
+    }else switch(type){
+        case NMEA_RMC: rmc(fidx, field); break;
+        case NMEA_GGA: gga(fidx, field); break;
+        case NMEA_GSA: gsa(fidx, field); break;
+        case NMEA_ZDA: zda(fidx, field); break;
+    }
+    ++fidx;
+    flen = 0;
+}
+
+// make fix f visible for readers
+static void publish(nmea_fix *f){
+    f->seq = pub.seq + 1;
+    ++pubseq;
+    __sync_synchronize();
+    pub = *f;
+    __sync_synchronize();
+    ++pubseq;
+}
+
+static int8_t hexval(uint8_t c){
+    if(c >= '0' && c <= '9') return c - '0';
+    if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+/**
+ * Clear parser state & published fix
+ */
+void nmea_init(){
+    state = ST_IDLE;
+    memset(&pend, 0, sizeof(pend));
+    ++pubseq;
+    memset(&pub, 0, sizeof(pub));
+    ++pubseq;
+    memset(&stat, 0, sizeof(stat));
+}
+
+/**
+ * Process next symbol of NMEA stream
+ * @return type of sentence (NMEA_RMC etc) if it was parsed & published, 0 otherwise
+ */
+uint8_t nmea_putc(uint8_t c){
+    int8_t h;
+    if(c == '$'){ // start of sentence (even if previous isn't over)
+        if(state != ST_IDLE) ++stat.broken;
+        state = ST_DATA;
+        csum = 0;
+        flen = fidx = slen = 0;
+        type = 0;
+        pend = pub;
+        return 0;
+    }
+    switch(state){
+        case ST_IDLE:
+        break;
+        case ST_DATA:
+            if(++slen > NMEA_MAX_LEN || c == '\r' || c == '\n'){
+                ++stat.broken;
+                state = ST_IDLE;
+            }else if(c == '*'){
+                end_field();
+                state = ST_CS1;
+            }else{
+                csum ^= c;
+                if(c == ',') end_field();
+                else if(flen < NMEA_FIELD_LEN) field[flen++] = c;
+            }
+        break;
+        case ST_CS1:
+        case ST_CS2:
+            h = hexval(c);
+            if(h < 0){
+                ++stat.broken;
+                state = ST_IDLE;
+                break;
+            }
+            if(state == ST_CS1){
+                rxsum = h << 4;
+                state = ST_CS2;
+                break;
+            }
+            state = ST_IDLE;
+            if((rxsum | h) != csum){
+                ++stat.badsum;
+                break;
+            }
+            ++stat.good;
+            if(type){
+                pend.updated |= type;
+                publish(&pend);
+                return type;
+            }
+        break;
+    }
+    return 0;
+}
+
+/**
+ * Process len bytes of NMEA stream
+ * @return types of all sentences published
+ */
+uint8_t nmea_feed(const uint8_t *buf, int len){
+    uint8_t t = 0;
+    while(len-- > 0) t |= nmea_putc(*buf++);
+    return t;
+}
+
+/**
+ * Get copy of last published fix
+ * @return its sequence number (changes on each published sentence)
+ */
+uint32_t nmea_get(nmea_fix *fix){
+    uint32_t s;
+    do{
+        s = pubseq;
+        __sync_synchronize();
+        *fix = pub;
+        __sync_synchronize();
+    }while((s & 1) || s != pubseq);
+    return fix->seq;
+}
+
+/**
+ * Get parser statistics
+ */
+void nmea_getstat(nmea_stat *st){
+    *st = stat;
+}
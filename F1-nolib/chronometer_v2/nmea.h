@@ -0,0 +1,76 @@
+/*
+ * nmea.h - streaming NMEA parser
+ *
+ * Copyright 2015 Edward V. Emelianov <eddy@sao.ru, edward.emelianoff@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#pragma once
+#ifndef __NMEA_H__
+#define __NMEA_H__
+
+#include <stdint.h>
+
+// max length of one field (longer fields are truncated)
+#define NMEA_FIELD_LEN   (16)
+
+// sentences types (bits of nmea_fix.updated)
+#define NMEA_RMC  (1 << 0)
+#define NMEA_GGA  (1 << 1)
+#define NMEA_GSA  (1 << 2)
+#define NMEA_ZDA  (1 << 3)
+
+/*
+ * All values are fixed point:
+ *   lat, lon - 1e-7 degrees (negative for S/W)
+ *   alt      - cm above mean sea level
+ *   speed    - mm/s
+ *   course   - 0.01 degree
+ *   ?dop     - 0.01
+ */
+typedef struct{
+    uint8_t valid;      // RMC status is 'A'
+    uint8_t quality;    // GGA fix quality (0 - no fix)
+    uint8_t fixtype;    // GSA: 1 - no fix, 2 - 2D, 3 - 3D
+    uint8_t sats;       // satellites used
+    uint8_t timeok;     // time field of last sentence wasn't empty
+    uint8_t H, M, S;    // UTC time
+    uint16_t ms;
+    uint8_t day, month; // UTC date
+    uint16_t year;
+    int32_t lat, lon;
+    int32_t alt;
+    uint32_t speed;
+    uint16_t course;
+    uint16_t pdop, hdop, vdop;
+    uint8_t updated;    // sentences received for current time
+    uint32_t seq;       // number of snapshot
+} nmea_fix;
+
+typedef struct{
+    uint32_t good;      // sentences with right checksum
+    uint32_t badsum;    // sentences with wrong checksum
+    uint32_t broken;    // too long or without checksum
+} nmea_stat;
+
+void nmea_init();
+uint8_t nmea_putc(uint8_t c);
+uint8_t nmea_feed(const uint8_t *buf, int len);
+uint32_t nmea_get(nmea_fix *fix);
+void nmea_getstat(nmea_stat *st);
+
+#endif // __NMEA_H__
@@ -0,0 +1,107 @@
+/*
+ * This file is part of the chronometer project.
+ * Copyright 2019 Edward V. Emelianov <edward.emelianoff@gmail.com>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * PPS frequency servo (no hardware here, so it could be tested on host).
+ * SysTick period is SERVO_NOMINAL + df/SERVO_DIV ticks: fractional part of
+ * offset is accumulated in `rem`, so periods are dithered between two integer
+ * values and mean frequency has resolution of 2^-16 ticks per second.
+ * On each PPS phase error (ticks between local and GPS second) feeds PI loop:
+ *      drift += Ki*phase; df = drift + Kp*phase
+ * so `drift` learns crystal offset and is used alone in holdover.
+ */
+
+#include "servo.h"
+
+static int32_t clamp(int32_t v, int32_t lim){
+    if(v > lim) return lim;
+    if(v < -lim) return -lim;
+    return v;
+}
+
+/**
+ * @brief servo_init - reset servo to nominal frequency
+ */
+void servo_init(servo_t *s){
+    s->state = CLK_FREE;
+    s->df = s->drift = s->rem = s->phase = 0;
+    s->good = s->npps = 0;
+    s->stepped = 0;
+}
+
+/**
+ * @brief servo_period - length of next SysTick period
+ * @return period in ticks
+ */
+uint32_t servo_period(servo_t *s){
+    int32_t extra;
+    s->rem += s->df;
+    extra = s->rem / SERVO_DIV;
+    s->rem -= extra * SERVO_DIV;
+    return (uint32_t)(SERVO_NOMINAL + extra);
+}
+
+/**
+ * @brief servo_pps - process phase error measured on PPS
+ * @param phase - ticks from local second beginning to PPS (negative if PPS came earlier)
+ * @return 1 if clock should be stepped to PPS (phase error is too large)
+ */
+int servo_pps(servo_t *s, int32_t phase){
+    const int32_t maxdf = SERVO_MAX_DF << SERVO_FRAC;
+    ++s->npps;
+    s->phase = phase;
+    if(phase > SERVO_STEP_LIMIT || phase < -SERVO_STEP_LIMIT){
+        s->state = CLK_ACQUIRE;
+        s->good = 0;
+        s->df = s->drift;
+        s->stepped = 1;
+        return 1;
+    }
+    if(s->stepped){ // phase was zero a second ago, so now it is pure frequency error
+        s->drift = clamp(s->df + clamp(phase, SERVO_MAX_DF) * (1 << SERVO_FRAC), maxdf);
+        s->stepped = 0;
+    }else
+        s->drift = clamp(s->drift + phase * (1 << (SERVO_FRAC - SERVO_KI_SHIFT)), maxdf);
+    s->df = clamp(s->drift + phase * (1 << (SERVO_FRAC - SERVO_KP_SHIFT)), maxdf);
+    if(phase < SERVO_LOCK_PHASE && phase > -SERVO_LOCK_PHASE){
+        if(++s->good >= SERVO_LOCK_CNT) s->state = CLK_LOCKED;
+        else if(s->state != CLK_LOCKED) s->state = CLK_ACQUIRE;
+    }else{
+        s->good = 0;
+        s->state = CLK_ACQUIRE;
+    }
+    return 0;
+}
+
+/**
+ * @brief servo_lost - there's no PPS: go to holdover with learned drift
+ */
+void servo_lost(servo_t *s){
+    if(s->state == CLK_FREE || s->state == CLK_HOLDOVER) return;
+    s->state = CLK_HOLDOVER;
+    s->df = s->drift;
+    s->good = 0;
+}
+
+/**
+ * @brief servo_ppb - convert frequency offset into ppb of nominal
+ */
+int32_t servo_ppb(int32_t df){
+    // ticks/s * 1e9 / 72e6 = ticks/s * 125 / 9
+    return (df / (1 << 8)) * 125 / (9 << (SERVO_FRAC - 8));
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of the chronometer project.
+ * Copyright 2019 Edward V. Emelianov <edward.emelianoff@gmail.com>.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+#ifndef SERVO_H__
+#define SERVO_H__
+
+#include <stdint.h>
+
+// nominal SysTick period: ticks (72MHz) per millisecond
+#define SERVO_NOMINAL       (72000)
+// fractional bits of frequency offset
+#define SERVO_FRAC          (16)
+// frequency offset: ticks per second << SERVO_FRAC; one SysTick period is
+// SERVO_NOMINAL + offset/SERVO_DIV ticks
+#define SERVO_DIV           (1000 << SERVO_FRAC)
+// max frequency offset: 200ppm of 72MHz (ticks per second)
+#define SERVO_MAX_DF        (14400)
+// phase error (ticks) over which clock is stepped instead of slewing: 0.5ms
+#define SERVO_STEP_LIMIT    (36000)
+// PI gains (per second): Kp = 2^-SERVO_KP_SHIFT, Ki = 2^-SERVO_KI_SHIFT
+#define SERVO_KP_SHIFT      (2)
+#define SERVO_KI_SHIFT      (4)
+// ticks from PPS edge till reading of SysTick->VAL (exception entry & prologue)
+#define SERVO_PPS_LATENCY   (16)
+// clock is locked after SERVO_LOCK_CNT pulses with phase error less than SERVO_LOCK_PHASE ticks (1us)
+#define SERVO_LOCK_PHASE    (72)
+#define SERVO_LOCK_CNT      (8)
+
+typedef enum{
+    CLK_FREE,       // never synchronized: nominal frequency
+    CLK_ACQUIRE,    // PPS present, servo converges
+    CLK_LOCKED,     // phase error is small
+    CLK_HOLDOVER    // PPS lost: running with learned drift
+} clk_state;
+
+typedef struct{
+    clk_state state;
+    int32_t df;         // current frequency offset (ticks per second << SERVO_FRAC)
+    int32_t drift;      // integral term: learned crystal offset, the same units
+    int32_t rem;        // dithering remainder
+    int32_t phase;      // last phase error, ticks (>0 - local clock is ahead)
+    uint32_t good;      // amount of pulses with small phase error in a row
+    uint32_t npps;      // amount of processed pulses
+    uint8_t stepped;    // clock was stepped on previous pulse
+} servo_t;
+
+void servo_init(servo_t *s);
+uint32_t servo_period(servo_t *s);
+int servo_pps(servo_t *s, int32_t phase);
+void servo_lost(servo_t *s);
+int32_t servo_ppb(int32_t df);
+
+#endif // SERVO_H__
@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "servo.h"
+
+/*
+ * Model of time.c: CPU cycles are counted from 0, SysTick periods are given by
+ * servo_period(), PPS interrupt reads local time with latency of
+ * SERVO_PPS_LATENCY +-3 ticks.
+ * Real crystal frequency is SERVO_NOMINAL*1000*(1 + ppm*1e-6), ppm changes
+ * linearly by `ramp` ppm per second; PPS edges have gaussian jitter.
+ */
+
+typedef struct{
+    const char *name;
+    double ppm;         // crystal offset
+    double ramp;        // ppm per second
+    double jitter;      // PPS jitter (RMS), ns
+    double start;       // phase of local clock start, s
+    int len;            // length of run, s
+    int lost0, lost1;   // there's no PPS between these seconds
+    int settle;         // check errors after this second
+    double maxerr;      // max time error after settle, ns
+    double maxrms;      // RMS time error after settle, ns
+    double maxhold;     // max error in holdover, ns
+} scenario;
+
+static scenario scenarios[] = {
+    {"crystal +40ppm, jitter 20ns", 40., 0., 20., 0.3, 300, 0, 0, 60, 200., 50., 0.},
+    {"crystal -60ppm, 0.02ppm/s ramp, jitter 50ns", -60., 0.02, 50., 0.7, 300, 0, 0, 60, 600., 400., 0.},
+    {"crystal +25ppm, 100s holdover", 25., 0., 20., 0.1, 400, 150, 250, 60, 200., 50., 1000.},
+    {"crystal +150ppm, 30s holdover with 0.005ppm/s ramp", 150., 0.005, 30., 0.5, 300, 120, 150, 60, 400., 150., 5000.},
+};
+
+static int verbose = 0;
+
+// simple reproducible PRNG & gaussian noise without libm
+static uint64_t rnd = 88172645463325252ULL;
+static double urand(){
+    rnd ^= rnd << 13; rnd ^= rnd >> 7; rnd ^= rnd << 17;
+    return (rnd >> 11) * (1. / 9007199254740992.);
+}
+static double grand(){
+    double s = 0.;
+    for(int i = 0; i < 12; ++i) s += urand();
+    return s - 6.;
+}
+
+static double dsqrt(double x){
+    double r = x > 1. ? x : 1.;
+    if(x <= 0.) return 0.;
+    for(int i = 0; i < 60; ++i) r = (r + x / r) / 2.;
+    return r;
+}
+
+// local clock: the same as in time.c
+static servo_t servo;
+static double cur;              // cycle of current period start
+static uint32_t curlen, nextlen, secticks, Timer, Tms, last_corr;
+
+static void local_init(double start){
+    servo_init(&servo);
+    cur = start;
+    curlen = nextlen = SERVO_NOMINAL;
+    secticks = Timer = 0;
+    Tms = 1; last_corr = 0;
+}
+
+// run SysTick interrupts till cycle `c`
+static void advance(double c){
+    while(cur + curlen <= c){
+        cur += curlen;
+        ++Tms;
+        secticks += curlen;
+        curlen = nextlen;
+        nextlen = servo_period(&servo);
+        if(++Timer == 1000){
+            Timer = 0;
+            secticks = 0;
+            if(Tms - last_corr > 1500) servo_lost(&servo);
+        }
+    }
+}
+
+// phase of local clock at cycle `c` (c is in current period)
+static int32_t phase_at(double c){
+    int32_t phase = (int32_t)(secticks + (uint32_t)(c - cur)) - SERVO_PPS_LATENCY;
+    if(Timer > 499) phase -= (int32_t)(SERVO_NOMINAL * 1000) + servo.df / (1 << SERVO_FRAC);
+    return phase;
+}
+
+// PPS interrupt at cycle `c`, @return 1 if clock was stepped
+static int pps(double c){
+    advance(c);
+    last_corr = Tms;
+    if(!servo_pps(&servo, phase_at(c))) return 0;
+    cur = c;
+    curlen = nextlen = servo_period(&servo);
+    Timer = secticks = 0;
+    return 1;
+}
+
+static const char *states[] = {"free", "acquire", "locked", "holdover"};
+
+static int run(const scenario *S){
+    double C = 0., F, ppm = S->ppm, sum2 = 0., maxerr = 0., maxhold = 0.;
+    int n = 0, steps = 0, bad = 0;
+    local_init(S->start * SERVO_NOMINAL * 1000.);
+    printf("%s\n", S->name);
+    for(int k = 1; k <= S->len; ++k){
+        F = SERVO_NOMINAL * 1000. * (1. + ppm * 1e-6);
+        C += F; // true second k
+        ppm += S->ramp;
+        double jit = grand() * S->jitter * 1e-9 * F, lat = SERVO_PPS_LATENCY - 3 + (rnd % 7);
+        // time error: local second boundary relative to true second
+        advance(C);
+        double err = (phase_at(C) + SERVO_PPS_LATENCY) / F * 1e9; // ns
+        int lost = (k >= S->lost0 && k < S->lost1);
+        if(!lost) steps += pps(C + jit + lat);
+        if(verbose)
+            printf("%4d %-8s phase=%7d err=%10.1fns drift=%6dppb (true %6.0f)\n", k, states[servo.state],
+                servo.phase, err, servo_ppb(servo.drift), ppm * 1e3);
+        if(k < S->settle) continue;
+        if(lost){
+            if(err > maxhold) maxhold = err;
+            else if(-err > maxhold) maxhold = -err;
+            continue;
+        }
+        if(k < S->lost1 + S->settle && k >= S->lost1) continue; // relock after holdover
+        sum2 += err * err;
+        ++n;
+        if(err > maxerr) maxerr = err;
+        else if(-err > maxerr) maxerr = -err;
+    }
+    double rms = dsqrt(sum2 / n);
+    printf("\tsteps: %d, state: %s, max error: %.0fns, RMS: %.0fns", steps, states[servo.state], maxerr, rms);
+    if(S->lost1) printf(", holdover max error: %.0fns", maxhold);
+    printf("\n\tdrift: %dppb, true %.0fppb\n", servo_ppb(servo.drift), (ppm - S->ramp) * 1e3);
+    if(servo.state != CLK_LOCKED){ printf("\tnot locked!\n"); ++bad; }
+    if(maxerr > S->maxerr){ printf("\tmax error > %.0fns\n", S->maxerr); ++bad; }
+    if(rms > S->maxrms){ printf("\tRMS > %.0fns\n", S->maxrms); ++bad; }
+    if(S->lost1 && maxhold > S->maxhold){ printf("\tholdover error > %.0fns\n", S->maxhold); ++bad; }
+    if(steps != 1){ printf("\tclock was stepped %d times (should be only on first PPS)\n", steps); ++bad; }
+    return bad;
+}
+
+static void bench(int N){
+    struct timespec t0, t1;
+    uint64_t sum = 0;
+    servo_init(&servo);
+    servo.df = 12345 << SERVO_FRAC;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for(int i = 0; i < N; ++i) sum += servo_period(&servo);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double t = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    printf("%d periods, %.1f ns per period, mean period %.5f ticks\n", N, t * 1e9 / N, (double)sum / N);
+}
+
+int main(int argc, char **argv){
+    int bad = 0;
+    if(argc > 1 && !strcmp(argv[1], "-b")){
+        bench(argc > 2 ? atoi(argv[2]) : 100000000);
+        return 0;
+    }
+    if(argc > 1 && !strcmp(argv[1], "-v")) verbose = 1;
+    for(size_t i = 0; i < sizeof(scenarios)/sizeof(scenarios[0]); ++i)
+        bad += run(&scenarios[i]);
+    if(bad) printf("%d errors\n", bad);
+    else printf("All OK\n");
+    return bad ? 1 : 0;
+}
@@ -21,6 +21,7 @@
 #include "adc.h"
 #include "GPS.h"
 #include "lidar.h"
+#include "nmea.h"
 #include "str.h"
 #include "time.h"
 #include "usart.h"
@@ -65,14 +66,13 @@ char *getchr(const char *str, char symbol){
 
 #define sendu(x) do{sendstring(u2str(x));}while(0)
 
-/*
 static void sendi(int32_t I){
     if(I < 0){
         sendchar('-');
         I = -I;
     }
     sendstring(u2str((uint32_t)I));
-}*/
+}
 
 // echo '1' if true or '0' if false
 static void checkflag(uint8_t f){
@@ -281,6 +281,21 @@ void parse_CMD(char *cmd){
             sendstring(", PPS working\n");
         else
             sendstring(", no PPS\n");
+        nmea_stat st;
+        nmea_getstat(&st);
+        sendstring("NMEA: good "); sendu(st.good);
+        sendstring(", bad checksum "); sendu(st.badsum);
+        sendstring(", broken "); sendu(st.broken);
+        sendstring("\n");
+        int32_t phase, ppb;
+        const char *clk[] = {"free", "acquire", "locked", "holdover"};
+        sendstring("Clock: ");
+        sendstring(clk[get_clock(&phase, &ppb)]);
+        sendstring(", phase error (ticks): ");
+        sendi(phase);
+        sendstring(", drift (ppb): ");
+        sendi(ppb);
+        sendstring("\n");
     }else if(CMP(cmd, CMD_USARTSPD) == 0){ // USART speed
         GETNUM(CMD_USARTSPD);
         if(N < 400 || N > 3000000) goto bad_number;
@@ -22,6 +22,7 @@
 #include "usart.h"
 #endif
 #include "usb.h"
+#include "servo.h"
 #include <string.h>
 
 volatile uint32_t Timer; // milliseconds counter
@@ -51,20 +52,102 @@ void set_time(const char *buf){
 */
 }
 
+static servo_t servo;
+// lengths of current & next SysTick periods (next is already in SysTick->LOAD)
+static volatile uint32_t curlen = SYSTICK_DEFCONF, nextlen = SYSTICK_DEFCONF;
+static volatile uint32_t secticks = 0; // ticks of finished periods in current second
+
+static void inc_time(curtime *T){
+    if(T->H == 25) return; // Time not initialized
+    if(++T->S == 60){
+        T->S = 0;
+        if(++T->M == 60){
+            T->M = 0;
+            if(++T->H == 24)
+                T->H = 0;
+        }
+    }
+}
+
 /**
  * @brief time_increment - increment system timer by systick
  */
 void time_increment(){
     Timer = 0;
-    if(current_time.H == 25) return; // Time not initialized
-    if(++current_time.S == 60){
-        current_time.S = 0;
-        if(++current_time.M == 60){
-            current_time.M = 0;
-            if(++current_time.H == 24)
-                current_time.H = 0;
+    secticks = 0;
+    // no PPS for a long time: go to holdover
+    if(Tms - last_corr_time > 1500) servo_lost(&servo);
+    inc_time(&current_time);
+}
+
+/**
+ * @brief systick_reload - count ticks of finished period & set length of next one
+ * Should be called from sys_tick_handler: new LOAD value will be used after next reload
+ */
+void systick_reload(){
+    secticks += curlen;
+    curlen = nextlen;
+    nextlen = servo_period(&servo);
+    SysTick->LOAD = nextlen - 1;
+}
+
+typedef struct{
+    uint32_t ms;    // milliseconds from second beginning
+    uint32_t ticks; // ticks from millisecond beginning
+    uint32_t len;   // length of current millisecond
+    uint32_t sec;   // ticks from second beginning
+    uint8_t wrap;   // new second began, but SysTick interrupt isn't processed yet
+} tickstamp;
+
+// get current local time in ticks; should be called with SysTick interrupt blocked
+static void get_stamp(tickstamp *t){
+    uint32_t val = SysTick->VAL;
+    t->ms = Timer;
+    t->len = curlen;
+    t->sec = secticks;
+    t->wrap = 0;
+    // counter was reloaded, but interrupt is pending (we are in ISR or interrupts are disabled)
+    if((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) && val > (nextlen >> 1)){
+        t->sec += t->len;
+        t->len = nextlen;
+        if(++t->ms == 1000){
+            t->ms = 0;
+            t->sec = 0;
+            t->wrap = 1;
         }
     }
+    t->ticks = t->len - 1 - val;
+    t->sec += t->ticks;
+}
+
+/**
+ * @brief get_micros - get current time with microsecond resolution
+ * @param T (o) - current time (could be NULL)
+ * @return microseconds from beginning of current second
+ */
+uint32_t get_micros(curtime *T){
+    tickstamp t;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    get_stamp(&t);
+    if(T){
+        *T = current_time;
+        if(t.wrap) inc_time(T);
+    }
+    __set_PRIMASK(primask);
+    return t.ms * 1000 + t.ticks * 1000 / t.len;
+}
+
+/**
+ * @brief get_clock - get state of clock servo
+ * @param phase (o) - last phase error, ticks
+ * @param ppb   (o) - current frequency correction, ppb
+ * @return servo state
+ */
+clk_state get_clock(int32_t *phase, int32_t *ppb){
+    if(phase) *phase = servo.phase;
+    if(ppb) *ppb = servo_ppb(servo.drift);
+    return servo.state;
 }
 
 static char *puttwo(uint8_t N, char *buf){
@@ -131,64 +214,33 @@ char *get_time(const curtime *Tm, uint32_t T){
 }
 
 
-#ifdef EBUG
-uint32_t timerval, Tms1;
-int32_t timecntr=0, ticksdiff=0;
-#else
-static int32_t timecntr=0, ticksdiff=0;
-#endif
 uint32_t last_corr_time = 0;
 
 /**
- * @brief systick_correction
- * Makes correction of system timer
- * The default frequency of timer is 1kHz - 72000 clocks per interrupt
- * So we check how much ticks there was for last one second - between PPS interrupts
- * Their amount equal to M = `Timer` value x (SysTick->LOAD+1) + (SysTick->LOAD+1 - SysTick->VAL)
- *    if `Timer` is very small, add 1000 to its value.
- * We need 1000xN ticks instead of M
- * if L = LOAD+1, then
- * M = Timer*L + L - VAL; newL = L + D = M/1000
- * 1000*D = M - 1000*L = L(Timer+1-1000) - VAL ->
- * D = [L*(Timer-999) - VAL]/1000
- * So correction equal to
- *      [ (SysTick->LOAD + 1) * (Timer - 999) - SysTick->VAL ] / 1000
+ * @brief systick_correction - process PPS signal
+ * Phase error is amount of ticks from beginning of local second till PPS
+ * (negative if PPS came before local second ends). It feeds frequency servo,
+ * which sets mean length of SysTick periods; if error is too large (first
+ * PPS or after long holdover), clock is stepped: new second starts right now.
  */
 void systick_correction(){
-    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk; // stop systick for a while
-    int32_t systick_val = (int32_t)SysTick->VAL, L = (int32_t)SysTick->LOAD + 1;
-    uint32_t timer_val = Timer;
-#ifdef EBUG
-    timerval = Timer;
-    Tms1 = Tms;
-#endif
-    Timer = 0;
-    SysTick->VAL = SysTick->LOAD;
-    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk; // start it again
-//    if(systick_val != SysTick->LOAD) ++Tms;
-    if(timer_val > 500) time_increment(); // counter greater than 500 -> need to increment time
-    if(last_corr_time){
-        uint32_t Tdiff = Tms - last_corr_time;
-        if(Tdiff < 1500 && Tdiff > 700){ // there was perevious PPS signal ~1s ago
-            int32_t D = L * ((int32_t)(Tms - 1000 - last_corr_time)) + ((int32_t)SysTick->LOAD - systick_val); // amount of spare ticks
-            ++timecntr;
-            ticksdiff += D;
-            uint32_t ticksabs = (ticksdiff < 0) ? (uint32_t)-ticksdiff : (uint32_t)ticksdiff;
-            // 30000 == 30 seconds * 1000 interrupts per second
-            if(ticksabs > 30000 && timecntr > 10){ // need correction (not more often than each 10s)
-                ticksdiff /= timecntr * 1000; // correction per one interrupt
-                SysTick->LOAD = (uint32_t)(ticksdiff + (int32_t)SysTick->LOAD);
-                timecntr = 0;
-                ticksdiff = 0;
-#ifdef EBUG
-                SEND("Correction\n");
-#endif
-            }
-        }else{
-            timecntr = 0;
-            ticksdiff = 0;
-        }
-    }
+    tickstamp t;
+    get_stamp(&t);
+    int32_t phase = (int32_t)t.sec - SERVO_PPS_LATENCY;
     last_corr_time = Tms;
+    if(t.ms > 499) // PPS came before local second end
+        phase -= (int32_t)(SERVO_NOMINAL * 1000) + servo.df / (1 << SERVO_FRAC);
+    if(servo_pps(&servo, phase)){ // step
+        uint32_t len = servo_period(&servo);
+        SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+        SysTick->LOAD = len - 1;
+        SysTick->VAL = 0;
+        curlen = nextlen = len;
+        SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk; // forget about reload before step
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+        if(t.ms > 499) time_increment(); // counter greater than 500 -> need to increment time
+        else if(t.wrap) inc_time(&current_time); // second changed, but wasn't processed
+        Timer = 0;
+        secticks = 0;
+    }
 }
-
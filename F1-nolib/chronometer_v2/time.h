@@ -20,6 +20,7 @@
 #define TIME_H__
 
 #include <stm32f1.h>
+#include "servo.h"
 
 // default value for systick_config
 #define SYSTICK_DEFCONF         (72000)
@@ -43,10 +44,6 @@ typedef struct{
     uint8_t S;
 } curtime;
 
-#ifdef EBUG
-extern int32_t ticksdiff, timecntr;
-extern uint32_t timerval, Tms1;
-#endif
 extern volatile uint32_t Tms;
 extern volatile uint32_t Timer;
 extern curtime current_time;
@@ -61,5 +58,8 @@ char *get_time(const curtime *T, uint32_t m);
 void set_time(const char *buf);
 void time_increment();
 void systick_correction();
+void systick_reload();
+uint32_t get_micros(curtime *T);
+clk_state get_clock(int32_t *phase, int32_t *ppb);
 
 #endif // TIME_H__
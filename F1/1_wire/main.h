@@ -32,6 +32,7 @@
 #include <libopencm3/usb/cdc.h>
 #include <libopencm3/usb/usbd.h>
 #include <libopencm3/cm3/systick.h>
+#include <libopencm3/stm32/flash.h>
 #include <libopencm3/stm32/rcc.h>
 #include <libopencm3/stm32/adc.h>
 #include <libopencm3/stm32/dma.h>
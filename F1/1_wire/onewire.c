@@ -19,8 +19,12 @@
 #include "onewire.h"
 #include "user_proto.h"
 
-OW_ID id_array[OW_MAX_NUM]; // 1-wire devices ID buffer (not more than eight)
+OW_ID id_array[OW_MAX_NUM]; // 1-wire devices ID buffer
 uint8_t dev_amount = 0;   // amount of 1-wire devices
+uint32_t ow_alarms = 0;   // bit i set if device i answered to last Alarm Search
+uint8_t ow_searching = 0; // ROM search is in progress
+OW_meas ow_meas[OW_MAX_NUM]; // measurements table, the same indexes as id_array
+uint8_t ow_batch = 0;     // batch measurement is in progress
 
 
 // states of 1-wire processing queue
@@ -35,84 +39,145 @@ volatile OW_States OW_State = OW_OFF_STATE; // 1-wire state, 0-not runned
 void (*ow_process_resdata)() = NULL;
 void wait_reading();
 
+/*
+ * Transaction is a list of operations: bits to send or bits to read into
+ * caller's buffer. Encoder converts them into CCR4 values (pulse lengths) on
+ * the fly, filling halves of small DMA ring from half transfer/transfer complete
+ * interrupts; decoder converts captured CCR3 values back into bits. So RAM
+ * needed doesn't depend on transaction length.
+ * After the end of data encoder gives zeros: empty slots without pulses,
+ * which aren't captured.
+ */
+static OW_op ops[OW_MAX_OPS];
+static uint8_t ops_amount = 0;
+static uint32_t total_slots = 0;  // total amount of bits in transaction
+static uint8_t enc_op, dec_op;    // current operation of encoder & decoder
+static uint16_t enc_bit, dec_bit; // current bit in operation
+static uint16_t rx_pos;           // next index of tim2_inbuff to decode
+static uint8_t halfreal[2];       // half of tim2_buff have real slots
+static uint8_t ring_mode;         // transaction is longer than ring
+static uint8_t retries = 0;       // amount of retries of current transaction
+
 uint16_t tim2_buff[TIM2_DMABUFF_SIZE];
 uint16_t tim2_inbuff[TIM2_DMABUFF_SIZE];
-int tum2buff_ctr = 0;
 uint8_t ow_done = 1;
 uint8_t ow_measurements_done = 0;
 
+/**
+ * clear transaction
+ */
+void OW_reset_buffer(){
+	ops_amount = 0;
+	total_slots = 0;
+	retries = 0;
+}
+
+static uint8_t add_op(uint8_t *buf, uint16_t nbits, uint8_t bits, uint8_t read){
+	if(ops_amount == OW_MAX_OPS){
+		ERR("Too many 1-wire operations");
+		return 0;
+	}
+	OW_op *o = &ops[ops_amount++];
+	o->buf = buf;
+	o->nbits = nbits;
+	o->bits = bits;
+	o->read = read;
+	total_slots += nbits;
+	return 1;
+}
+
 /**
  * this function sends bits of ow_byte (LSB first) to 1-wire line
  * @param ow_byte - byte to convert
- * @param Nbits   - number of bits to send
- * @param ini     - 1 to zero counter
  */
 uint8_t OW_add_byte(uint8_t ow_byte){
-	uint8_t i, byte;
-	for(i = 0; i < 8; i++){
-		if(ow_byte & 0x01){
-			byte = BIT_ONE_P;
-		}else{
-			byte = BIT_ZERO_P;
-		}
-		if(tum2buff_ctr == TIM2_DMABUFF_SIZE){
-			ERR("Tim2 buffer overflow");
-			return 0; // avoid buffer overflow
-		}
-		tim2_buff[tum2buff_ctr++] = byte;
-		ow_byte >>= 1;
-	}
-//	INT(tum2buff_ctr);
-//	DBG(" bytes in send buffer\n");
-	return 1;
+	return OW_add_bits(ow_byte, 8);
 }
 
+/**
+ * add Nbits (up to 8) lower bits of ow_bits (LSB first) to transaction
+ */
+uint8_t OW_add_bits(uint8_t ow_bits, uint8_t Nbits){
+	return add_op(NULL, Nbits, ow_bits, 0);
+}
 
+/**
+ * add Nbytes of data (sent from buffer without copying, so it should live until
+ * transaction ends)
+ */
+uint8_t OW_add_data(uint8_t *data, uint16_t Nbytes){
+	return add_op(data, Nbytes * 8, 0, 0);
+}
 
 /**
- * Adds Nbytes bytes 0xff  for reading sequence
+ * add reading of Nbytes into buf
  */
-uint8_t OW_add_read_seq(uint8_t Nbytes){
-	uint8_t i;
+uint8_t OW_add_read(uint8_t *buf, uint16_t Nbytes){
 	if(Nbytes == 0) return 0;
-	Nbytes *= 8; // 8 bits for each byte
-	for(i = 0; i < Nbytes; i++){
-		if(tum2buff_ctr == TIM2_DMABUFF_SIZE){
-			ERR("Tim2 buffer overflow");
-			return 0;
-		}
-		tim2_buff[tum2buff_ctr++] = BIT_READ_P;
-	}
-//	INT(tum2buff_ctr);
-//	DBG(" bytes in send buffer\n");
-	return 1;
+	return OW_add_read_bits(buf, Nbytes * 8); // 8 bits for each byte
 }
 
 /**
- * Fill output buffer with data from 1-wire
- * @param start_idx - index from which to start (byte number)
- * @param N         - data length (in **bytes**)
- * @outbuf          - where to place data
+ * add reading of Nbits into buf (LSB first)
  */
-void read_from_OWbuf(uint8_t start_idx, uint8_t N, uint8_t *outbuf){
-	start_idx *= 8;
-	uint8_t i, j, last = start_idx + N * 8, byte;
-	if(last >= TIM2_DMABUFF_SIZE) last = TIM2_DMABUFF_SIZE;
-	for(i = start_idx; i < last;){
-		byte = 0;
-		for(j = 0; j < 8; j++){
-			byte >>= 1;
-//			INT(tim2_inbuff[i]);
-//			DBG(" ");
-			if(tim2_inbuff[i++] < ONE_ZERO_BARRIER)
-				byte |= 0x80;
+uint8_t OW_add_read_bits(uint8_t *buf, uint16_t Nbits){
+	return add_op(buf, Nbits, 0, 1);
+}
+
+// next CCR4 value of transaction or 0
+static uint16_t enc_next(){
+	while(enc_op < ops_amount){
+		OW_op *o = &ops[enc_op];
+		if(enc_bit < o->nbits){
+			uint16_t b = enc_bit++;
+			if(o->read) return BIT_READ_P;
+			if(o->buf) b = o->buf[b >> 3] >> (b & 7);
+			else b = o->bits >> b;
+			return (b & 1) ? BIT_ONE_P : BIT_ZERO_P;
+		}
+		++enc_op;
+		enc_bit = 0;
+	}
+	return 0;
+}
+
+// process next captured value
+static void dec_put(uint16_t capt){
+	while(dec_op < ops_amount){
+		OW_op *o = &ops[dec_op];
+		if(dec_bit < o->nbits){
+			if(o->read){
+				uint8_t mask = 1 << (dec_bit & 7);
+				if(capt < ONE_ZERO_BARRIER) o->buf[dec_bit >> 3] |= mask;
+				else o->buf[dec_bit >> 3] &= ~mask;
+			}
+			++dec_bit;
+			return;
 		}
-		*outbuf++ = byte;
-//		DBG("readed \n");
+		++dec_op;
+		dec_bit = 0;
+	}
+}
+
+// fill n values of tim2_buff from idx, return 1 if there was real slots
+static uint8_t tx_fill(uint16_t idx, uint16_t n){
+	uint8_t real = 0;
+	while(n--){
+		if((tim2_buff[idx++] = enc_next())) real = 1;
+	}
+	return real;
+}
+
+// decode all captured values in ring mode
+static void rx_decode(){
+	uint16_t pos = TIM2_DMABUFF_SIZE - DMA1_CNDTR1;
+	if(pos == TIM2_DMABUFF_SIZE) pos = 0;
+	while(rx_pos != pos){
+		dec_put(tim2_inbuff[rx_pos]);
+		if(++rx_pos == TIM2_DMABUFF_SIZE) rx_pos = 0;
 	}
-//	print_hex(outbuf-N, N);
-//	DBG(" readed\n");
 }
+
 // there's a mistake in opencm3, so redefine this if needed (TIM_CCMR2_CC3S_IN_TI1 -> TIM_CCMR2_CC3S_IN_TI4)
 #ifndef TIM_CCMR2_CC3S_IN_TI4
 #define TIM_CCMR2_CC3S_IN_TI4		(2)
@@ -141,9 +206,10 @@ void init_ow_dmatimer(){ // tim2_ch4 - PA3, no remap
 	// TIM2_CH4 - DMA1, channel 7
 	dma_channel_reset(DMA1, DMA_CHANNEL7);
 	DMA1_CCR7 = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_PSIZE_16BIT | DMA_CCR_MSIZE_16BIT
-			| DMA_CCR_TEIE | DMA_CCR_TCIE | DMA_CCR_PL_HIGH;
+			| DMA_CCR_CIRC | DMA_CCR_TEIE | DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_PL_HIGH;
 	nvic_enable_irq(NVIC_DMA1_CHANNEL7_IRQ); // enable dma1_channel7_isr
-	tum2buff_ctr = 0;
+	OW_reset_buffer();
+	OW_load_IDs();
 	DBG("OW INITED\n");
 #ifdef EBUG
 	gpio_set(GPIOC, GPIO10);
@@ -151,32 +217,47 @@ void init_ow_dmatimer(){ // tim2_ch4 - PA3, no remap
 }
 
 void run_dmatimer(){
+	uint16_t first;
 	ow_done = 0;
 	TIM2_CR1 = 0;
 	adc_disable_dma(ADC1); // turn off DMA & ADC
 	adc_off(ADC1);
+	enc_op = dec_op = 0;
+	enc_bit = dec_bit = 0;
+	rx_pos = 0;
+	first = enc_next(); // we should manually set first bit to avoid zero in tim2_inbuff[0]
+	halfreal[0] = tx_fill(0, TIM2_DMABUFF_SIZE/2);
+	halfreal[1] = tx_fill(TIM2_DMABUFF_SIZE/2, TIM2_DMABUFF_SIZE/2);
+	ring_mode = (total_slots > TIM2_DMABUFF_SIZE);
 	// TIM2_CH4 - DMA1, channel 7
 	DMA1_IFCR = DMA_ISR_TEIF7|DMA_ISR_HTIF7|DMA_ISR_TCIF7|DMA_ISR_GIF7 |
 		DMA_ISR_TEIF1|DMA_ISR_HTIF1|DMA_ISR_TCIF1|DMA_ISR_GIF1; // clear flags
 	DMA1_CCR7 &= ~DMA_CCR_EN; // disable (what if it's enabled?) to set address
 	DMA1_CPAR7 = (uint32_t) &(TIM_CCR4(TIM2)); // dma_set_peripheral_address(DMA1, DMA_CHANNEL7, (uint32_t) &(TIM_CCR4(TIM2)));
-	DMA1_CMAR7 = (uint32_t) &tim2_buff[1]; // dma_set_memory_address(DMA1, DMA_CHANNEL7, (uint32_t)tim2_buff);
-	DMA1_CNDTR7 = tum2buff_ctr-1;//dma_set_number_of_data(DMA1, DMA_CHANNEL7, tum2buff_ctr);
+	DMA1_CMAR7 = (uint32_t) tim2_buff; // dma_set_memory_address(DMA1, DMA_CHANNEL7, (uint32_t)tim2_buff);
+	DMA1_CNDTR7 = TIM2_DMABUFF_SIZE;//dma_set_number_of_data(DMA1, DMA_CHANNEL7, tum2buff_ctr);
 	// TIM2_CH3 - DMA1, channel 1
 	dma_channel_reset(DMA1, DMA_CHANNEL1);
-	DMA1_CCR1 = DMA_CCR_MINC | DMA_CCR_PSIZE_16BIT | DMA_CCR_MSIZE_16BIT
-			| DMA_CCR_TEIE | DMA_CCR_TCIE | DMA_CCR_PL_HIGH;
 	DMA1_CPAR1 = (uint32_t) &(TIM_CCR3(TIM2)); //dma_set_peripheral_address(DMA1, DMA_CHANNEL1, (uint32_t) &(TIM_CCR3(TIM2)));
 	DMA1_CMAR1 = (uint32_t) tim2_inbuff; //dma_set_memory_address(DMA1, DMA_CHANNEL1, (uint32_t) tim2_inbuff);
-	DMA1_CNDTR1 = tum2buff_ctr; //dma_set_number_of_data(DMA1, DMA_CHANNEL1, tum2buff_ctr);
+	if(ring_mode){ // captures are decoded from DMA1_7 interrupts, end is found by empty half
+		DMA1_CCR1 = DMA_CCR_MINC | DMA_CCR_PSIZE_16BIT | DMA_CCR_MSIZE_16BIT
+			| DMA_CCR_CIRC | DMA_CCR_TEIE | DMA_CCR_PL_HIGH;
+		DMA1_CNDTR1 = TIM2_DMABUFF_SIZE;
+	}else{ // short transaction: stop after last capture
+		DMA1_CCR1 = DMA_CCR_MINC | DMA_CCR_PSIZE_16BIT | DMA_CCR_MSIZE_16BIT
+			| DMA_CCR_TEIE | DMA_CCR_TCIE | DMA_CCR_PL_HIGH;
+		DMA1_CNDTR1 = total_slots; //dma_set_number_of_data(DMA1, DMA_CHANNEL1, tum2buff_ctr);
+	}
 	nvic_enable_irq(NVIC_DMA1_CHANNEL1_IRQ);
+	nvic_enable_irq(NVIC_DMA1_CHANNEL7_IRQ);
 
 	DMA1_CCR7 |= DMA_CCR_EN; //dma_enable_channel(DMA1, DMA_CHANNEL7);
 	DMA1_CCR1 |= DMA_CCR_EN; //dma_enable_channel(DMA1, DMA_CHANNEL1);
 
 	TIM2_SR = 0; // clear all flags
 	TIM2_ARR = BIT_LEN; // bit length
-	TIM2_CCR4 = tim2_buff[0]; // we should manually set first bit to avoid zero in tim2_inbuff[0]
+	TIM2_CCR4 = first;
 	TIM2_EGR = TIM_EGR_UG; // update value of ARR
 	TIM2_CR1 = TIM_CR1_ARPE; // bufferize ARR/CCR
 
@@ -187,9 +268,24 @@ void run_dmatimer(){
 #ifdef EBUG
 	gpio_clear(GPIOC, GPIO10);
 #endif
-/*	DBG("RUN transfer of ");
-	INT(tum2buff_ctr);
-	DBG(" bits\n");*/
+}
+
+// all slots are sent: stop timer & DMA, decode the rest
+static void stop_dmatimer(){
+	uint32_t i;
+	TIM2_CR1 &= ~TIM_CR1_CEN;    // timer_disable_counter(TIM2);
+	DMA1_CCR1 &= ~DMA_CCR_EN; // disable DMA1 channel 1
+	DMA1_CCR7 &= ~DMA_CCR_EN; // disable DMA1 channel 7
+	TIM2_CCR4 = 0; // line is free
+	DMA1_IFCR = DMA_ISR_GIF1 | DMA_ISR_GIF7;
+	nvic_disable_irq(NVIC_DMA1_CHANNEL1_IRQ);
+	nvic_disable_irq(NVIC_DMA1_CHANNEL7_IRQ);
+	if(ring_mode) rx_decode();
+	else for(i = 0; i < total_slots; ++i) dec_put(tim2_inbuff[i]);
+#ifdef EBUG
+	gpio_set(GPIOC, GPIO10);
+#endif
+	ow_done = 1;
 }
 
 uint16_t rstat = 0, lastcc3 = 3;
@@ -237,41 +333,46 @@ void tim2_isr(){
 }
 
 /**
- * DMA interrupt in 1-wire mode
+ * DMA interrupt in 1-wire mode: last capture of short transaction
  */
 void dma1_channel1_isr(){
-		//	int i;
 	if(DMA1_ISR & DMA_ISR_TCIF1){
-#ifdef EBUG
-		gpio_set(GPIOC, GPIO10);
-#endif
 		DMA1_IFCR = DMA_IFCR_CTCIF1;
-		TIM2_CR1 &= ~TIM_CR1_CEN;    // timer_disable_counter(TIM2);
-		DMA1_CCR1 &= ~DMA_CCR_EN; // disable DMA1 channel 1
-		nvic_disable_irq(NVIC_DMA1_CHANNEL1_IRQ);
-		ow_done = 1;
-/*			for(i = 0; i < tum2buff_ctr; i++){
-				print_int(tim2_inbuff[i]);
-				P(" ");
-			}
-			P("\n");*/
+		stop_dmatimer();
 	}else if(DMA1_ISR & DMA_ISR_TEIF1){
 		DMA1_IFCR = DMA_IFCR_CTEIF1;
 		DBG("DMA in transfer error\n");
 	}
 }
 
+/**
+ * half of output ring is loaded into timer: refill it & decode captured data
+ */
 void dma1_channel7_isr(){
-	if(DMA1_ISR & DMA_ISR_TCIF7){
-		DMA1_IFCR = DMA_IFCR_CTCIF7; // clear flag
-		DMA1_CCR7 &= ~DMA_CCR_EN; // disable DMA1 channel 7
-	}else if(DMA1_ISR & DMA_ISR_TEIF7){
+	uint8_t half;
+	if(DMA1_ISR & DMA_ISR_TEIF7){
 		DMA1_IFCR = DMA_IFCR_CTEIF7;
 		DBG("DMA out transfer error\n");
+		return;
+	}
+	if(DMA1_ISR & DMA_ISR_HTIF7){
+		DMA1_IFCR = DMA_IFCR_CHTIF7;
+		half = 0;
+	}else if(DMA1_ISR & DMA_ISR_TCIF7){
+		DMA1_IFCR = DMA_IFCR_CTCIF7;
+		half = 1;
+	}else return;
+	if(ring_mode){
+		rx_decode();
+		// empty half is loaded, so all real slots are captured
+		if(!halfreal[half]){
+			stop_dmatimer();
+			return;
+		}
 	}
+	halfreal[half] = tx_fill(half * TIM2_DMABUFF_SIZE/2, TIM2_DMABUFF_SIZE/2);
 }
 
-
 uint8_t OW_get_reset_status(){
 	if(rstat < RESET_BARRIER) return 0; // no devices
 	return 1;
@@ -304,6 +405,8 @@ void OW_process(){
 					DBG("\n");
 					ow_was_reseting = 0;
 					OW_State = OW_OFF_STATE;
+					ow_process_resdata = NULL;
+					ow_searching = 0;
 					return;
 				}
 			}
@@ -318,21 +421,43 @@ void OW_process(){
 		//	adc_dma_on(); // return DMA1_1 to ADC at end of data transmitting
 			if(ow_process_resdata)
 				ow_process_resdata();
-			ow_data_ready = 1;
+			// callback could start next transaction or retry
+			if(OW_State == OW_OFF_STATE) ow_data_ready = 1;
 			//DBG("OW read\n");
 		break;
 	}
 }
 
 
+/**
+ * repeat current transaction (with bus reset) if there was less than OW_MAX_RETRIES tries
+ * @return 0 if all tries are over
+ */
+static uint8_t OW_retry(){
+	if(++retries > OW_MAX_RETRIES){
+		retries = 0;
+		return 0;
+	}
+	DBG("Bad CRC, retry\n");
+	OW_State = OW_RESET_STATE;
+	return 1;
+}
+
 uint8_t *read_buf = NULL;    // buffer for storing readed data
 /**
  * fill ID buffer with readed data
  */
 void fill_buff_with_data(){
-	ow_process_resdata = NULL;
 	if(!read_buf) return;
-	read_from_OWbuf(1, 8, read_buf);
+	// zeros have right CRC too
+	if(OW_crc8(read_buf, 8) || !read_buf[0]){
+		if(OW_retry()) return;
+		ERR("Can't read ID");
+		ow_process_resdata = NULL;
+		read_buf = NULL;
+		return;
+	}
+	ow_process_resdata = NULL;
 	int i, j;
 	P("Readed ID: ");
 	for(i = 0; i < 8; ++i){
@@ -368,17 +493,229 @@ void OW_fill_next_ID(){
 	OW_State = OW_RESET_STATE;
 	OW_reset_buffer();
 	OW_add_byte(OW_READ_ROM);
-	OW_add_read_seq(8); // wait for 8 bytes
 	read_buf = id_array[dev_amount].bytes;
+	OW_add_read(read_buf, 8); // wait for 8 bytes
 	ow_process_resdata = fill_buff_with_data;
 	DBG("wait for ID\n");
 }
 
+/*
+ * ROM search (Maxim AN187): on each bit all devices send bit of their ID and its
+ * complement, master selects direction & sends it, so devices with other bit value
+ * go off. Each step is one DMA run of "triplet": direction of previous bit & two
+ * read slots of next; the ID found on each pass is checked by CRC. Directions of
+ * last discrepancy (0 taken before, now 1) give next ID on following pass.
+ * Bits are numbered 1..64 as in AN187.
+ */
+static uint8_t search_cmd;      // OW_SEARCH_ROM or OW_ALARM_SEARCH
+static uint8_t search_family;   // family code to find or 0
+static uint8_t search_ROM[8];   // ID of current pass
+static uint8_t search_bitno;    // number of bit being read
+static uint8_t last_discrepancy;// bit of last discrepancy where 0 was taken on previous pass
+static uint8_t last_zero;       // the same for current pass
+static uint8_t last_device;     // all IDs found
+static uint8_t search_found;    // amount of IDs found
+static uint8_t search_bits;     // bit of ID & its complement
+static uint8_t search_retries;  // passes with bad CRC in a row
+static void search_step();
+static void search_passdone();
+static void search_pass();
+
+// Dallas CRC8 (x^8 + x^5 + x^4 + 1, reflected) of all bytes
+static const uint8_t crc8_table[256] = {
+	0x00, 0x5e, 0xbc, 0xe2, 0x61, 0x3f, 0xdd, 0x83, 0xc2, 0x9c, 0x7e, 0x20, 0xa3, 0xfd, 0x1f, 0x41,
+	0x9d, 0xc3, 0x21, 0x7f, 0xfc, 0xa2, 0x40, 0x1e, 0x5f, 0x01, 0xe3, 0xbd, 0x3e, 0x60, 0x82, 0xdc,
+	0x23, 0x7d, 0x9f, 0xc1, 0x42, 0x1c, 0xfe, 0xa0, 0xe1, 0xbf, 0x5d, 0x03, 0x80, 0xde, 0x3c, 0x62,
+	0xbe, 0xe0, 0x02, 0x5c, 0xdf, 0x81, 0x63, 0x3d, 0x7c, 0x22, 0xc0, 0x9e, 0x1d, 0x43, 0xa1, 0xff,
+	0x46, 0x18, 0xfa, 0xa4, 0x27, 0x79, 0x9b, 0xc5, 0x84, 0xda, 0x38, 0x66, 0xe5, 0xbb, 0x59, 0x07,
+	0xdb, 0x85, 0x67, 0x39, 0xba, 0xe4, 0x06, 0x58, 0x19, 0x47, 0xa5, 0xfb, 0x78, 0x26, 0xc4, 0x9a,
+	0x65, 0x3b, 0xd9, 0x87, 0x04, 0x5a, 0xb8, 0xe6, 0xa7, 0xf9, 0x1b, 0x45, 0xc6, 0x98, 0x7a, 0x24,
+	0xf8, 0xa6, 0x44, 0x1a, 0x99, 0xc7, 0x25, 0x7b, 0x3a, 0x64, 0x86, 0xd8, 0x5b, 0x05, 0xe7, 0xb9,
+	0x8c, 0xd2, 0x30, 0x6e, 0xed, 0xb3, 0x51, 0x0f, 0x4e, 0x10, 0xf2, 0xac, 0x2f, 0x71, 0x93, 0xcd,
+	0x11, 0x4f, 0xad, 0xf3, 0x70, 0x2e, 0xcc, 0x92, 0xd3, 0x8d, 0x6f, 0x31, 0xb2, 0xec, 0x0e, 0x50,
+	0xaf, 0xf1, 0x13, 0x4d, 0xce, 0x90, 0x72, 0x2c, 0x6d, 0x33, 0xd1, 0x8f, 0x0c, 0x52, 0xb0, 0xee,
+	0x32, 0x6c, 0x8e, 0xd0, 0x53, 0x0d, 0xef, 0xb1, 0xf0, 0xae, 0x4c, 0x12, 0x91, 0xcf, 0x2d, 0x73,
+	0xca, 0x94, 0x76, 0x28, 0xab, 0xf5, 0x17, 0x49, 0x08, 0x56, 0xb4, 0xea, 0x69, 0x37, 0xd5, 0x8b,
+	0x57, 0x09, 0xeb, 0xb5, 0x36, 0x68, 0x8a, 0xd4, 0x95, 0xcb, 0x29, 0x77, 0xf4, 0xaa, 0x48, 0x16,
+	0xe9, 0xb7, 0x55, 0x0b, 0x88, 0xd6, 0x34, 0x6a, 0x2b, 0x75, 0x97, 0xc9, 0x4a, 0x14, 0xf6, 0xa8,
+	0x74, 0x2a, 0xc8, 0x96, 0x15, 0x4b, 0xa9, 0xf7, 0xb6, 0xe8, 0x0a, 0x54, 0xd7, 0x89, 0x6b, 0x35
+};
+
+/**
+ * Calculate Dallas CRC8
+ * @return CRC of N bytes of buf (0 for buffer with its CRC in last byte)
+ */
+uint8_t OW_crc8(const uint8_t *buf, uint8_t N){
+	uint8_t crc = 0;
+	while(N--) crc = crc8_table[crc ^ *buf++];
+	return crc;
+}
+
+// find index of ID in id_array or -1
+static int find_ID(const uint8_t *ROM){
+	int i, j;
+	for(i = 0; i < dev_amount; ++i){
+		for(j = 0; j < 8; j++)
+			if(id_array[i].bytes[j] != ROM[j]) break;
+		if(j == 8) return i;
+	}
+	return -1;
+}
+
+// end of search: show results & store IDs
+static void search_finish(){
+	ow_searching = 0;
+	ow_process_resdata = NULL;
+	P("Found ");
+	print_int(search_found);
+	P(" devices\n");
+	if(search_cmd == OW_SEARCH_ROM && search_found) OW_store_IDs();
+}
+
+// start new search pass: reset, command & first two read slots
+static void search_pass(){
+	if(last_device){
+		search_finish();
+		return;
+	}
+	OW_State = OW_RESET_STATE;
+	OW_reset_buffer();
+	OW_add_byte(search_cmd);
+	OW_add_read_bits(&search_bits, 2);
+	search_bitno = 1;
+	last_zero = 0;
+	ow_process_resdata = search_step;
+}
+
+// two bits of search_bitno are read
+static void search_step(){
+	uint8_t id_bit = search_bits & 1;
+	uint8_t cmp_bit = (search_bits >> 1) & 1;
+	uint8_t dir, byte = (search_bitno - 1) / 8, mask = 1 << ((search_bitno - 1) % 8);
+	if(id_bit && cmp_bit){ // no devices answered
+		search_finish();
+		return;
+	}
+	if(id_bit != cmp_bit) dir = id_bit; // all devices have the same bit
+	else{ // discrepancy
+		if(search_bitno < last_discrepancy) dir = (search_ROM[byte] & mask) ? 1 : 0;
+		else dir = (search_bitno == last_discrepancy);
+		if(!dir) last_zero = search_bitno;
+	}
+	if(dir) search_ROM[byte] |= mask;
+	else search_ROM[byte] &= ~mask;
+	OW_State = OW_SEND_STATE;
+	OW_reset_buffer();
+	OW_add_bits(dir, 1);
+	if(search_bitno == 64){
+		ow_process_resdata = search_passdone;
+		return;
+	}
+	++search_bitno;
+	OW_add_read_bits(&search_bits, 2);
+}
+
+// all 64 bits of ID are read
+static void search_passdone(){
+	int idx;
+	ow_process_resdata = NULL;
+	if(OW_crc8(search_ROM, 8)){
+		if(++search_retries > OW_MAX_RETRIES){
+			ERR("Bad CRC, search stopped");
+			search_finish();
+			return;
+		}
+		ERR("Bad CRC, repeat pass");
+		search_pass();
+		return;
+	}
+	search_retries = 0;
+	if(search_family && search_ROM[0] != search_family){ // no more devices of this family
+		search_finish();
+		return;
+	}
+	last_discrepancy = last_zero;
+	if(!last_discrepancy) last_device = 1;
+	idx = find_ID(search_ROM);
+	if(search_cmd == OW_ALARM_SEARCH){
+		if(idx > -1) ow_alarms |= 1UL << idx;
+	}else if(idx < 0){
+		if(dev_amount == OW_MAX_NUM){
+			ERR("No memory left for new device");
+			search_finish();
+			return;
+		}
+		memcpy(id_array[dev_amount++].bytes, search_ROM, 8);
+	}
+	++search_found;
+	P("Found ID: ");
+	OW_printID(search_ROM);
+	search_pass();
+}
+
+/**
+ * Start search of devices on the bus, all of them (or all of given family)
+ * will be added into id_array & stored in flash; Alarm Search only sets ow_alarms
+ * @param cmd    - OW_SEARCH_ROM or OW_ALARM_SEARCH
+ * @param family - family code (e.g. 0x28 for DS18B20) or 0 for all devices
+ * @return 0 if bus is busy (transaction or batch measurement in progress)
+ */
+uint8_t OW_search(uint8_t cmd, uint8_t family){
+	if(OW_State != OW_OFF_STATE || ow_batch) return 0;
+	ow_data_ready = 0;
+	ow_searching = 1;
+	search_cmd = cmd;
+	search_family = family;
+	search_found = 0;
+	search_retries = 0;
+	last_device = 0;
+	last_discrepancy = 0;
+	memset(search_ROM, 0, 8);
+	if(family){ // start from given family: first 8 bits are known
+		search_ROM[0] = family;
+		last_discrepancy = 64;
+	}
+	if(cmd == OW_ALARM_SEARCH) ow_alarms = 0;
+	search_pass();
+	return 1;
+}
+
+/**
+ * Store id_array into last flash page
+ */
+void OW_store_IDs(){
+	uint32_t addr = OW_FLASH_ADDR;
+	int i, j;
+	flash_unlock();
+	flash_erase_page(OW_FLASH_ADDR);
+	flash_program_half_word(addr, OW_FLASH_MAGIC);
+	flash_program_half_word(addr + 2, dev_amount);
+	addr += 4;
+	for(i = 0; i < dev_amount; ++i){
+		uint8_t *ROM = id_array[i].bytes;
+		for(j = 0; j < 8; j += 2, addr += 2)
+			flash_program_half_word(addr, ROM[j] | (ROM[j+1] << 8));
+	}
+	flash_lock();
+}
+
+/**
+ * Load IDs stored in flash
+ * @return amount of IDs
+ */
+uint8_t OW_load_IDs(){
+	const uint16_t *hdr = (const uint16_t*) OW_FLASH_ADDR;
+	if(hdr[0] != OW_FLASH_MAGIC || hdr[1] > OW_MAX_NUM) return 0;
+	dev_amount = hdr[1];
+	memcpy(id_array, (const void*)(OW_FLASH_ADDR + 4), dev_amount * sizeof(OW_ID));
+	return dev_amount;
+}
+
 /**
  * Procedure of 1-wire communications
  * variables:
  * @param sendReset - send RESET before transmission
- * @param command - bytes sent to the bus (if we want to read, send OW_READ_SLOT)
+ * @param command - bytes sent to the bus (used without copying!)
  * @param cLen - command buffer length (how many bytes to send)
  * @return 1 if succeed, 0 if failure
  */
@@ -390,10 +727,7 @@ uint8_t OW_Send(uint8_t sendReset, uint8_t *command, uint8_t cLen){
 	else
 		OW_State = OW_SEND_STATE;
 	OW_reset_buffer();
-	while(cLen-- > 0){
-		if(!OW_add_byte(*command++)) return 0;
-	}
-	return 1;
+	return OW_add_data(command, cLen);
 }
 
 /**
@@ -418,6 +752,8 @@ int32_t gettemp(uint8_t *scratchpad){
 	int8_t v;
 	if(scratchpad[7] == 0xff) // 0xff can be only if there's no such device or some other error
 		return ERR_TEMP_VAL;
+	if(scratchpad[7] == 0) // line is shorted: zeros have right CRC
+		return ERR_TEMP_VAL;
 	m = scratchpad[1];
 	l = scratchpad[0];
 	if(scratchpad[4] == 0xff){ // DS18S20
@@ -425,6 +761,8 @@ int32_t gettemp(uint8_t *scratchpad){
 		t = ((int32_t)v) * 10L;
 		if(l&1) t += 5L; // decimal 0.5
 	}else{ // DS18B20
+		// lower bits are undefined for resolution less than 12 bits
+		l &= ~((1 << (3 - ((scratchpad[4] >> 5) & 3))) - 1);
 		v = l>>4 | ((m & 7)<<4) | (m & 0x80);
 		t = ((int32_t)v) * 10L;
 		m = (l & 0x0f) >> 1; // add decimal
@@ -439,18 +777,17 @@ int32_t gettemp(uint8_t *scratchpad){
 
 int32_t temperature = ERR_TEMP_VAL;
 int8_t Ncur = 0;
+static uint8_t scratchpad[9];
 /**
  * get temperature from buffer
  */
 void convert_next_temp(){
-	uint8_t scratchpad[9];
+	if(OW_crc8(scratchpad, 9)){
+		if(OW_retry()) return;
+		ERR("Bad scratchpad CRC");
+		temperature = ERR_TEMP_VAL;
+	}else temperature = gettemp(scratchpad);
 	ow_process_resdata = NULL;
-	if(dev_amount < 2){
-		read_from_OWbuf(2, 9, scratchpad);
-	}else{
-		read_from_OWbuf(10, 9, scratchpad);
-	}
-	temperature = gettemp(scratchpad);
 	DBG("Readed temperature: ");
 	INT(temperature);
 	DBG("/10 degrC\n");
@@ -463,26 +800,22 @@ void OW_read_next_temp(){
 	ow_data_ready = 0;
 	OW_State = OW_RESET_STATE;
 	OW_reset_buffer();
-	int i;
 	if(dev_amount < 2){
 		Ncur = -1;
 		OW_add_byte(OW_SKIP_ROM);
 	}else{
 		if(++Ncur >= dev_amount) Ncur = 0;
 		OW_add_byte(OW_MATCH_ROM);
-		uint8_t *ROM = id_array[Ncur].bytes;
-		for(i = 0; i < 8; ++i)
-			OW_add_byte(ROM[i]);
+		OW_add_data(id_array[Ncur].bytes, 8);
 	}
 	OW_add_byte(OW_READ_SCRATCHPAD);
-	OW_add_read_seq(9); // wait for 9 bytes - ROM
+	OW_add_read(scratchpad, 9); // wait for 9 bytes - ROM
 	ow_process_resdata = convert_next_temp;
 }
 
+static uint8_t convbyte;
 void wait_reading(){
-	uint8_t bt;
-	read_from_OWbuf(0, 1, &bt);
-	if(bt == 0xff){ // the conversion is done!
+	if(convbyte == 0xff){ // the conversion is done!
 		ow_measurements_done = 1;
 		ow_process_resdata = NULL;
 		DBG("Measurements done!\n");
@@ -490,7 +823,7 @@ void wait_reading(){
 		OW_State = OW_SEND_STATE;
 		OW_reset_buffer();
 		ow_data_ready = 0;
-		OW_add_read_seq(1); // send read seq waiting for end of conversion
+		OW_add_read(&convbyte, 1); // send read seq waiting for end of conversion
 	}
 }
 
@@ -501,9 +834,161 @@ void OW_send_read_seq(){
 	OW_reset_buffer();
 	OW_add_byte(OW_SKIP_ROM);
 	OW_add_byte(OW_CONVERT_T);
-	OW_add_read_seq(1); // send read seq waiting for end of conversion
+	OW_add_read(&convbyte, 1); // send read seq waiting for end of conversion
 	ow_process_resdata = wait_reading;
 }
+/*
+ * Batch measurement: configuration of sensors with changed resolution, one
+ * Skip ROM Convert T for the whole bus, polling of read slots (answer is 1 only
+ * when all sensors are ready), then scratchpads of all known sensors are read
+ * one by one via Match ROM, each next transaction is started from completion
+ * callback of previous. So refresh period is the time of slowest conversion
+ * plus ~16ms per sensor.
+ */
+static uint8_t batch_idx;      // current sensor
+static uint32_t batch_time;    // time of conversion end
+static void batch_config();
+static void batch_convert();
+static void batch_wait();
+static void batch_read();
+static void batch_readdone();
+
+// resolution (9..12) -> configuration register
+#define RES2CFG(r)  ((uint8_t)((((r) - 9) << 5) | 0x1f))
+
+// start configuration of next sensor which needs it or conversion
+static void batch_config(){
+	OW_meas *m;
+	// thresholds of sensor are unknown until its first reading, configure it after
+	while(batch_idx < dev_amount && (!ow_meas[batch_idx].cfgneed || !ow_meas[batch_idx].bits))
+		++batch_idx;
+	if(batch_idx == dev_amount){
+		batch_convert();
+		return;
+	}
+	m = &ow_meas[batch_idx];
+	m->cfgneed = 0;
+	OW_State = OW_RESET_STATE;
+	OW_reset_buffer();
+	OW_add_byte(OW_MATCH_ROM);
+	OW_add_data(id_array[batch_idx].bytes, 8);
+	OW_add_byte(OW_SCRATCHPAD);
+	// TH, TL and configuration are written together, so keep last readed thresholds
+	m->cfg[0] = m->th;
+	m->cfg[1] = m->tl;
+	m->cfg[2] = RES2CFG(m->resolution);
+	OW_add_data(m->cfg, 3);
+	++batch_idx;
+	ow_process_resdata = batch_config;
+}
+
+// conversion on all sensors at once
+static void batch_convert(){
+	OW_State = OW_RESET_STATE;
+	OW_reset_buffer();
+	OW_add_byte(OW_SKIP_ROM);
+	OW_add_byte(OW_CONVERT_T);
+	OW_add_read(&convbyte, 1);
+	ow_process_resdata = batch_wait;
+}
+
+// poll read slots until all sensors are ready
+static void batch_wait(){
+	if(convbyte != 0xff){
+		OW_State = OW_SEND_STATE;
+		OW_reset_buffer();
+		OW_add_read(&convbyte, 1);
+		return;
+	}
+	batch_time = Timer;
+	batch_idx = 0;
+	batch_read();
+}
+
+// read scratchpad of current sensor
+static void batch_read(){
+	OW_State = OW_RESET_STATE;
+	OW_reset_buffer();
+	OW_add_byte(OW_MATCH_ROM);
+	OW_add_data(id_array[batch_idx].bytes, 8);
+	OW_add_byte(OW_READ_SCRATCHPAD);
+	OW_add_read(scratchpad, 9);
+	ow_process_resdata = batch_readdone;
+}
+
+// scratchpad is readed: store result & go to next sensor
+static void batch_readdone(){
+	OW_meas *m = &ow_meas[batch_idx];
+	if(OW_crc8(scratchpad, 9)){
+		if(OW_retry()) return;
+		m->T = ERR_TEMP_VAL;
+	}else{
+		m->T = gettemp(scratchpad);
+		m->th = scratchpad[2];
+		m->tl = scratchpad[3];
+		if(id_array[batch_idx].bytes[0] == OW_DS18B20_FAMILY){
+			m->bits = ((scratchpad[4] >> 5) & 3) + 9;
+			// sensor could lose configuration after power loss
+			if(m->resolution && m->resolution != m->bits) m->cfgneed = 1;
+		}else m->bits = 9;
+	}
+	m->time = batch_time;
+	if(++batch_idx < dev_amount){
+		batch_read();
+		return;
+	}
+	ow_process_resdata = NULL;
+	ow_batch = 0;
+	ow_measurements_done = 1;
+	DBG("Batch done\n");
+}
+
+/**
+ * Start measurement of all known sensors, results will be in ow_meas
+ * @return 0 if there's no known sensors or bus is busy
+ */
+uint8_t OW_measure_all(){
+	if(!dev_amount){
+		ERR("No known IDs, run search first");
+		return 0;
+	}
+	if(OW_State != OW_OFF_STATE) return 0;
+	ow_data_ready = 0;
+	ow_measurements_done = 0;
+	ow_batch = 1;
+	batch_idx = 0;
+	batch_config();
+	return 1;
+}
+
+/**
+ * Set resolution of DS18B20, it will be written before next batch measurement
+ * @param idx  - index of sensor in id_array or -1 for all
+ * @param bits - resolution: 9..12 bits
+ * @return 0 if arguments are wrong
+ */
+uint8_t OW_set_resolution(int idx, uint8_t bits){
+	int i;
+	if(bits < 9 || bits > 12 || idx >= dev_amount) return 0;
+	for(i = 0; i < dev_amount; ++i){
+		if(idx > -1 && i != idx) continue;
+		if(id_array[i].bytes[0] != OW_DS18B20_FAMILY) continue;
+		ow_meas[i].resolution = bits;
+		ow_meas[i].cfgneed = 1;
+	}
+	return 1;
+}
+
+/**
+ * Forget all IDs & measurements
+ */
+void OW_clear_IDs(){
+	dev_amount = 0;
+	ow_alarms = 0;
+	memset(ow_meas, 0, sizeof(ow_meas));
+	OW_store_IDs();
+}
+
 /*
  * scan 1-wire bus
  * WARNING! The procedure works in real-time, so it is VERY LONG
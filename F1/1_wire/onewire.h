@@ -24,8 +24,15 @@
 #include "main.h"
 #include "hardware_ini.h"
 
-// 20 bytes x 8bits
-#define TIM2_DMABUFF_SIZE 160
+// DMA rings size (slots): two halves of 2 bytes each
+#define TIM2_DMABUFF_SIZE 32
+// max amount of operations in one transaction
+#define OW_MAX_OPS        8
+// max amount of retries of transaction (or search pass) with bad CRC
+#define OW_MAX_RETRIES    3
+
+// family code of DS18B20
+#define OW_DS18B20_FAMILY   (0x28)
 
 // freq = 1MHz
 // ARR values: 1000 for reset, 100 for data in/out
@@ -46,9 +53,37 @@ typedef struct{
 	uint8_t bytes[8];
 } OW_ID;
 
+// operation of transaction
+typedef struct{
+	uint8_t *buf;     // data to send/buffer for reading; NULL - send `bits`
+	uint16_t nbits;   // amount of bits
+	uint8_t bits;     // data to send when buf is NULL (up to 8 bits)
+	uint8_t read;     // 1 - read slots
+} OW_op;
+
+// result of batch measurement
+typedef struct{
+	int32_t T;          // temperature (1/10 degrC) or ERR_TEMP_VAL
+	uint32_t time;      // Timer value at the end of conversion
+	uint8_t resolution; // wanted resolution (9..12) or 0 to leave it as is
+	uint8_t bits;       // current resolution
+	uint8_t th, tl;     // alarm thresholds from last reading
+	uint8_t cfgneed;    // configuration should be written
+	uint8_t cfg[3];     // TH, TL & config for Write Scratchpad
+} OW_meas;
+
 extern OW_ID id_array[];
+extern OW_meas ow_meas[];
+extern uint8_t ow_batch;
+extern uint8_t dev_amount;
+extern uint32_t ow_alarms;
+extern uint8_t ow_searching;
+
+#define OW_MAX_NUM 32
 
-#define OW_MAX_NUM 8
+// IDs are stored in last 1K page of 128K flash
+#define OW_FLASH_ADDR   ((uint32_t)0x0801fc00)
+#define OW_FLASH_MAGIC  ((uint16_t)0x1dd5)
 
 void init_ow_dmatimer();
 void run_dmatimer();
@@ -56,13 +91,14 @@ extern uint8_t ow_done;
 #define OW_READY()  (ow_done)
 void ow_dma_on();
 uint8_t OW_add_byte(uint8_t ow_byte);
-uint8_t OW_add_read_seq(uint8_t Nbytes);
-void read_from_OWbuf(uint8_t start_idx, uint8_t N, uint8_t *outbuf);
+uint8_t OW_add_bits(uint8_t ow_bits, uint8_t Nbits);
+uint8_t OW_add_data(uint8_t *data, uint16_t Nbytes);
+uint8_t OW_add_read(uint8_t *buf, uint16_t Nbytes);
+uint8_t OW_add_read_bits(uint8_t *buf, uint16_t Nbits);
 void ow_reset();
 uint8_t OW_get_reset_status();
 
-extern int tum2buff_ctr;
-#define OW_reset_buffer()   do{tum2buff_ctr = 0;}while(0)
+void OW_reset_buffer();
 
 extern uint8_t ow_data_ready;
 extern uint8_t ow_measurements_done;
@@ -73,7 +109,14 @@ extern uint8_t ow_measurements_done;
 
 void OW_process();
 void OW_fill_next_ID();
+uint8_t OW_crc8(const uint8_t *buf, uint8_t N);
+uint8_t OW_search(uint8_t cmd, uint8_t family);
+void OW_store_IDs();
+uint8_t OW_load_IDs();
 void OW_send_read_seq();
+uint8_t OW_measure_all();
+uint8_t OW_set_resolution(int idx, uint8_t bits);
+void OW_clear_IDs();
 uint8_t OW_Send(uint8_t sendReset, uint8_t *command, uint8_t cLen);
 
 extern int32_t temperature;
@@ -48,6 +48,58 @@ void help(){
 	P("R\tstart reading temperature\n");
 	P("P\tread DS18 ID\n");
 	P("Q\tget temperature\n");
+	P("S\tsearch all devices on the bus\n");
+	P("D\tsearch DS18B20 only\n");
+	P("A\talarm search\n");
+	P("L\tlist known IDs\n");
+	P("C\tclear list of IDs\n");
+	P("M\tmeasure all known sensors\n");
+	P("W\tshow measurements table\n");
+	P("E\tset resolution: bits (all sensors) or (N+1)*100+bits (Nth sensor)\n");
+}
+
+/**
+ * show known IDs
+ */
+static void list_IDs(){
+	int i;
+	newline();
+	for(i = 0; i < dev_amount; ++i){
+		print_int(i);
+		P(": ");
+		if(ow_alarms & (1UL << i)) P("(alarm) ");
+		OW_printID(id_array[i].bytes);
+	}
+}
+
+/**
+ * show measurements table: N, T (1/10 degrC), resolution, time of measurement
+ */
+static void show_table(){
+	int i;
+	newline();
+	for(i = 0; i < dev_amount; ++i){
+		OW_meas *m = &ow_meas[i];
+		print_int(i);
+		usb_send('\t');
+		if(m->T == ERR_TEMP_VAL) P("err");
+		else print_int(m->T);
+		usb_send('\t');
+		print_int(m->bits);
+		usb_send('\t');
+		print_int(m->time);
+		newline();
+	}
+}
+
+/**
+ * set resolution from entered value
+ */
+static uint8_t set_res(int32_t v){
+	newline();
+	if(v < 0 || !OW_set_resolution(v < 100 ? -1 : v/100 - 1, v % 100))
+		P("Wrong value\n");
+	return 0;
 }
 
 /**
@@ -111,6 +163,31 @@ int parse_incoming_buf(char *buf, int len){
 			case 'R':
 				OW_send_read_seq();
 			break;
+			case 'S':
+				if(!OW_search(OW_SEARCH_ROM, 0)) P("Bus is busy\n");
+			break;
+			case 'D':
+				if(!OW_search(OW_SEARCH_ROM, OW_DS18B20_FAMILY)) P("Bus is busy\n");
+			break;
+			case 'A':
+				if(!OW_search(OW_ALARM_SEARCH, 0)) P("Bus is busy\n");
+			break;
+			case 'L':
+				list_IDs();
+			break;
+			case 'C':
+				OW_clear_IDs();
+			break;
+			case 'M':
+				if(!OW_measure_all()) P("Can't start\n");
+			break;
+			case 'W':
+				show_table();
+			break;
+			case 'E':
+				I = set_res;
+				READINT();
+			break;
 			case '\n': // show newline, space and tab as is
 			case '\r':
 			case ' ':
@@ -225,7 +302,7 @@ void print_int(int32_t N){
 	}else usb_send('0');
 }
 
-void OW_printID(uint8_t N){
+void OW_printID(uint8_t *b){
 	void putc(uint8_t c){
 		if(c < 10)
 			usb_send(c + '0');
@@ -233,7 +310,6 @@ void OW_printID(uint8_t N){
 			usb_send(c + 'a' - 10);
 	}
 	int i;
-	uint8_t *b = id_array[N].bytes;
 	usb_send('0'); usb_send('x'); // prefix 0x
 	for(i = 0; i < 8; i++){
 		putc(b[i] >> 4);
@@ -46,6 +46,6 @@ void print_int(int32_t N);
 void print_hex(uint8_t *buff, uint8_t l);
 
 int parse_incoming_buf(char *buf, int len);
-void OW_printID(uint8_t N);
+void OW_printID(uint8_t *b);
 
 #endif // __USER_PROTO_H__
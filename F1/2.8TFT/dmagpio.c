@@ -19,56 +19,148 @@
  * MA 02110-1301, USA.
  */
 
+/*
+ * 8-bit bus driven by DMA. TIM2 runs with period of DMAGPIO_PERIOD ticks, each period:
+ *  update event (DMA1 ch2) - next byte to bus,
+ *  CC3 event (DMA1 ch1) - strobe low,
+ *  CC1 event (DMA1 ch5) - strobe high (data is latched by rising edge).
+ * Data is read directly from user buffer (it shouldn't be changed till the end of
+ * transfer) or repeated from 2-byte pattern for fills. DMA counter is 16-bit, so long
+ * transfers are sent by chunks of DMAGPIO_CHUNK bytes: end of chunk interrupt starts next.
+ */
+
 #include "dmagpio.h"
 #include "user_proto.h"
 
-int transfer_complete = 0;
-static uint16_t gpiobuff[128] = {0};
+volatile int transfer_complete = 0;
+static volatile uint8_t busy = 0;
+static const uint8_t *nextdata = NULL;	// data of next chunk or NULL for fill pattern
+static volatile uint32_t rest = 0;		// bytes left after current chunk
+static uint8_t pattern[2];				// fill pattern: high & low bytes of word
+// values for strobe pin BSRR
+static const uint32_t strobe_low = DMAGPIO_STROBE_PIN << 16, strobe_high = DMAGPIO_STROBE_PIN;
 
 void dmagpio_init(){
-	// init TIM2 & DMA1ch2 (TIM2UP)
+	// init TIM2 & DMA1 ch1 (TIM2CH3), ch2 (TIM2UP), ch5 (TIM2CH1)
 	rcc_periph_clock_enable(RCC_TIM2);
 	rcc_periph_clock_enable(RCC_DMA1);
 	timer_reset(TIM2);
-	// timer have frequency of 1MHz
 	timer_set_mode(TIM2, TIM_CR1_CKD_CK_INT, TIM_CR1_CMS_EDGE, TIM_CR1_DIR_UP);
-	// 72MHz div 18 = 4MHz
-	TIM2_PSC = 0; // prescaler is (div - 1)
-	TIM2_ARR = 1; // 36MHz (6.25)
-	TIM2_DIER = TIM_DIER_UDE;// | TIM_DIER_UIE;
+	TIM2_PSC = 0; // 72MHz
+	TIM2_ARR = DMAGPIO_PERIOD - 1;
+	TIM2_CCR3 = DMAGPIO_STROBE_LOW;
+	TIM2_CCR1 = DMAGPIO_STROBE_HIGH;
+	// CC channels are frozen outputs: only events for DMA
+	TIM2_DIER = TIM_DIER_UDE | TIM_DIER_CC1DE | TIM_DIER_CC3DE;
+	dma_channel_reset(DMA1, DMA_CHANNEL1);
 	dma_channel_reset(DMA1, DMA_CHANNEL2);
-	// mem2mem, medium prio, 8bits, memory increment, read from mem, transfer complete en
-	DMA1_CCR2 = DMA_CCR_PL_MEDIUM | DMA_CCR_MSIZE_16BIT |
-		DMA_CCR_PSIZE_16BIT | DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_TCIE | DMA_CCR_TEIE ;
-	nvic_enable_irq(NVIC_DMA1_CHANNEL2_IRQ);
-	// target address:
+	dma_channel_reset(DMA1, DMA_CHANNEL5);
+	// data: very high prio, 8bit memory -> 16bit ODR, memory increment
+	DMA1_CCR2 = DMA_CCR_PL_VERY_HIGH | DMA_CCR_MSIZE_8BIT | DMA_CCR_PSIZE_16BIT |
+		DMA_CCR_MINC | DMA_CCR_DIR;
 	DMA1_CPAR2 = DMAGPIO_TARGADDR;
-	DMA1_CMAR2 = (uint32_t) gpiobuff;
+	// strobes: the same 32bit value to BSRR
+	DMA1_CCR1 = DMA_CCR_PL_HIGH | DMA_CCR_MSIZE_32BIT | DMA_CCR_PSIZE_32BIT | DMA_CCR_DIR;
+	DMA1_CPAR1 = DMAGPIO_STROBEADDR;
+	DMA1_CMAR1 = (uint32_t) &strobe_low;
+	// strobe high is the last in period: its transfer complete means end of chunk
+	DMA1_CCR5 = DMA_CCR_PL_HIGH | DMA_CCR_MSIZE_32BIT | DMA_CCR_PSIZE_32BIT | DMA_CCR_DIR |
+		DMA_CCR_TCIE | DMA_CCR_TEIE;
+	DMA1_CPAR5 = DMAGPIO_STROBEADDR;
+	DMA1_CMAR5 = (uint32_t) &strobe_high;
+	nvic_enable_irq(NVIC_DMA1_CHANNEL5_IRQ);
 }
 
-void dmagpio_transfer(uint8_t *databuf, uint32_t length){
-	while(DMA1_CCR2 & DMA_CCR_EN);
-	transfer_complete = 0;
-	DMA1_IFCR = 0xff00; // clear all flags for ch2
-	// buffer length
-	DMA1_CNDTR2 = length;
-	uint32_t i;
-	for(i = 0; i < length; ++i) gpiobuff[i] = databuf[i];
-	TIM2_CR1 |= TIM_CR1_CEN; // run timer
+// run next chunk of `rest` bytes
+static void start_chunk(){
+	uint32_t n = (rest > DMAGPIO_CHUNK) ? DMAGPIO_CHUNK : rest;
+	rest -= n;
+	DMA1_IFCR = DMA_IFCR_CGIF1 | DMA_IFCR_CGIF2 | DMA_IFCR_CGIF5;
+	if(nextdata){
+		DMA1_CCR2 &= ~DMA_CCR_CIRC;
+		DMA1_CMAR2 = (uint32_t) nextdata;
+		DMA1_CNDTR2 = n;
+		nextdata += n;
+	}else{ // chunk length is even, so pattern always starts from high byte
+		DMA1_CCR2 |= DMA_CCR_CIRC;
+		DMA1_CMAR2 = (uint32_t) pattern;
+		DMA1_CNDTR2 = 2;
+	}
+	DMA1_CNDTR1 = n;
+	DMA1_CNDTR5 = n;
 	DMA1_CCR2 |= DMA_CCR_EN;
+	DMA1_CCR1 |= DMA_CCR_EN;
+	DMA1_CCR5 |= DMA_CCR_EN;
+	TIM2_EGR = TIM_EGR_UG; // clear counter & put first byte to bus
+	TIM2_CR1 |= TIM_CR1_CEN;
+}
+
+/**
+ * send data buffer to bus (without copying)
+ * @param databuf - data (shouldn't be changed till the end of transfer)
+ * @param length - its length (any)
+ */
+void dmagpio_transfer(const uint8_t *databuf, uint32_t length){
+	dmagpio_wait();
+	if(!length) return;
+	transfer_complete = 0;
+	busy = 1;
+	nextdata = databuf;
+	rest = length;
+	start_chunk();
+}
+
+/**
+ * send `amount` copies of 16bit word (high byte first), e.g. fill of LCD window
+ */
+void dmagpio_fill(uint16_t word, uint32_t amount){
+	dmagpio_wait();
+	if(!amount) return;
+	transfer_complete = 0;
+	busy = 1;
+	pattern[0] = word >> 8;
+	pattern[1] = word & 0xff;
+	nextdata = NULL;
+	rest = amount * 2;
+	start_chunk();
+}
+
+/**
+ * return 1 if transfer is in progress
+ */
+uint8_t dmagpio_busy(){
+	return busy;
+}
+
+/**
+ * wait for end of current transfer
+ */
+void dmagpio_wait(){
+	while(busy);
+}
+
+// stop timer & turn off DMA
+static void stop_chunk(){
+	TIM2_CR1 &= ~TIM_CR1_CEN;
+	DMA1_CCR1 &= ~DMA_CCR_EN;
+	DMA1_CCR2 &= ~DMA_CCR_EN;
+	DMA1_CCR5 &= ~DMA_CCR_EN;
 }
 
-void dma1_channel2_isr(){
-	if(DMA1_ISR & DMA_ISR_TCIF2){
-		transfer_complete = 1;
-		// stop timer & turn off DMA
-		TIM2_CR1 &= ~TIM_CR1_CEN;
-		DMA1_CCR2 &= ~DMA_CCR_EN;
-		DMA1_IFCR = DMA_IFCR_CTCIF2; // clear flag
-	}else if(DMA1_ISR & DMA_ISR_TEIF2){
+void dma1_channel5_isr(){
+	if(DMA1_ISR & DMA_ISR_TCIF5){
+		stop_chunk();
+		DMA1_IFCR = DMA_IFCR_CTCIF5; // clear flag
+		if(rest) start_chunk();
+		else{
+			busy = 0;
+			transfer_complete = 1;
+		}
+	}else if(DMA1_ISR & DMA_ISR_TEIF5){
 		P("Error\n");
-		DMA1_IFCR = DMA_IFCR_CTEIF2;
-		TIM2_CR1 &= ~TIM_CR1_CEN;
-		DMA1_CCR2 &= ~DMA_CCR_EN;
+		DMA1_IFCR = DMA_IFCR_CTEIF5;
+		stop_chunk();
+		rest = 0;
+		busy = 0;
 	}
 }
@@ -25,8 +25,18 @@
 #include "main.h"
 #include "hardware_ini.h"
 
+// TIM2 ticks (72MHz): byte period (250ns) and strobe edges inside it
+#define DMAGPIO_PERIOD		18
+#define DMAGPIO_STROBE_LOW	6
+#define DMAGPIO_STROBE_HIGH	12
+// max length of one DMA transfer (should be even)
+#define DMAGPIO_CHUNK		65534
+
 void dmagpio_init();
-void dmagpio_transfer(uint8_t *databuf, uint32_t length);
-extern int transfer_complete;
+void dmagpio_transfer(const uint8_t *databuf, uint32_t length);
+void dmagpio_fill(uint16_t word, uint32_t amount);
+uint8_t dmagpio_busy();
+void dmagpio_wait();
+extern volatile int transfer_complete;
 
 #endif // __DMAGPIO_H__
@@ -34,10 +34,14 @@ void SysTick_init();
 
 /*
  * DMA to GPIO port & pins (mask) - PA0..PA7
+ * (DMA writes the whole ODR, so PA8..PA15 could be used only as inputs or AF)
  */
 #define DMAGPIO_PORT		GPIOA
 #define DMAGPIO_PINS		0xff
 #define DMAGPIO_TARGADDR	((uint32_t)&(GPIOA_ODR))
+// write strobe: data is latched by its rising edge
+#define DMAGPIO_STROBE_PIN	LCD_WR_PIN
+#define DMAGPIO_STROBEADDR	((uint32_t)&(GPIO_BSRR(LCD_CONTROL_PORT)))
 
 #define LCD_write()		do{gpio_set_mode(DMAGPIO_PORT, GPIO_MODE_OUTPUT_50_MHZ, GPIO_CNF_OUTPUT_PUSHPULL, DMAGPIO_PINS);}while(0)
 //#define LCD_read()		do{gpio_set_mode(DMAGPIO_PORT, GPIO_MODE_INPUT, GPIO_CNF_INPUT_FLOAT, DMAGPIO_PINS);}while(0)
@@ -24,6 +24,7 @@
 #include "hardware_ini.h"
 #include "dmagpio.h"
 #include "registers.h"
+#include "font.h"
 
 static uint16_t LCD_id = 0;
 #define nop() __asm__("nop")
@@ -58,6 +59,7 @@ void writereg(uint16_t r){
 
 uint16_t read_reg(uint16_t reg){
 	uint32_t dat = 0;
+	dmagpio_wait();
 	CS_clear; // active
 	writereg(reg);
 	LCD_read();
@@ -69,11 +71,12 @@ uint16_t read_reg(uint16_t reg){
 }
 
 void write_reg(uint16_t reg, uint16_t dat){
+	dmagpio_wait();
 	CS_clear; // active
 	writereg(reg);
 	RS_set;  // data
 	writebyte(dat >> 8);
-	writebyte(dat && 0xff);
+	writebyte(dat & 0xff);
 	CS_set;
 }
 
@@ -165,6 +168,7 @@ uint32_t read16_reg_var(uint16_t reg, uint8_t len){
 
 uint16_t LCD_status_read(){
 	uint16_t dat;
+	dmagpio_wait();
 	LCD_read();
 	CS_clear;
 	RS_clear;
@@ -412,18 +416,14 @@ uint16_t LCD_init(){
  * put point to current position incrementing coordinates
  */
 void putpoint(uint16_t colr){
-	int i;
 	if(LCD_id == 0) return;
+	dmagpio_wait();
 	LCD_write(); // dir: out
 	CS_clear; // active
 	writereg(ILI932X_RW_GRAM);
-	for(i = 0; i < 500; ++i){
-		writebyte(colr >> 8);
-		writebyte(colr && 0xff);
-	}
+	writebyte(colr >> 8);
+	writebyte(colr & 0xff);
 	CS_set;
-	//if(LCD_id == 0x9320){
-	//}
 }
 
 void setpix(uint16_t x, uint16_t y, uint16_t colr){
@@ -431,3 +431,115 @@ void setpix(uint16_t x, uint16_t y, uint16_t colr){
 	write_reg(ILI932X_GRAM_VER_AD, y);
 	write_reg(ILI932X_RW_GRAM, colr);
 }
+
+/*
+ * Graphics: GRAM window is set once for each primitive, then pixels are streamed
+ * by DMA (see dmagpio.c); GRAM address auto-increments inside window. CS stays
+ * active till the end of transfer, next register access waits for it.
+ */
+
+/**
+ * clip rectangle by screen
+ * @return 0 if nothing left
+ */
+static uint8_t clip(int16_t *x, int16_t *y, int16_t *w, int16_t *h){
+	if(*x < 0){ *w += *x; *x = 0; }
+	if(*y < 0){ *h += *y; *y = 0; }
+	if(*x + *w > TFTWIDTH) *w = TFTWIDTH - *x;
+	if(*y + *h > TFTHEIGHT) *h = TFTHEIGHT - *y;
+	return (*w > 0 && *h > 0);
+}
+
+/**
+ * set GRAM window & address to its left upper corner, start GRAM write
+ */
+static void start_window(int16_t x, int16_t y, int16_t w, int16_t h){
+	write_reg(ILI932X_HOR_START_AD, x);
+	write_reg(ILI932X_HOR_END_AD, x + w - 1);
+	write_reg(ILI932X_VER_START_AD, y);
+	write_reg(ILI932X_VER_END_AD, y + h - 1);
+	write_reg(ILI932X_GRAM_HOR_AD, x);
+	write_reg(ILI932X_GRAM_VER_AD, y);
+	CS_clear;
+	writereg(ILI932X_RW_GRAM); // RS is set after it: data
+}
+
+/**
+ * wait for end of DMA transfer
+ */
+void LCD_wait(){
+	dmagpio_wait();
+	CS_set;
+}
+
+/**
+ * fill rectangle by one DMA transfer (function returns before it ends)
+ * @param x, y - left upper corner (could be outside of screen)
+ * @param w, h - size
+ * @param colr - RGB565 color
+ */
+void LCD_fillrect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t colr){
+	if(LCD_id == 0 || !clip(&x, &y, &w, &h)) return;
+	start_window(x, y, w, h);
+	dmagpio_fill(colr, (uint32_t)w * h);
+}
+
+/**
+ * clear the whole screen
+ */
+void LCD_clear(uint16_t colr){
+	LCD_fillrect(0, 0, TFTWIDTH, TFTHEIGHT, colr);
+}
+
+/**
+ * draw image (function returns before the end of transfer, so data shouldn't be changed)
+ * @param x, y - left upper corner (could be outside of screen)
+ * @param w, h - size
+ * @param data - RGB565 pixels, big-endian (high byte first) - as they go to bus
+ */
+void LCD_blit(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *data){
+	int16_t x0 = x, y0 = y, W = w;
+	if(LCD_id == 0 || !clip(&x, &y, &w, &h)) return;
+	data += ((y - y0) * W + x - x0) * 2;
+	start_window(x, y, w, h);
+	if(w == W){ // whole rows: one transfer
+		dmagpio_transfer(data, (uint32_t)w * h * 2);
+		return;
+	}
+	for(; h; --h, data += W * 2) // GRAM write continues through row transfers
+		dmagpio_transfer(data, w * 2);
+}
+
+/**
+ * draw text by font 6x8 (KOI8-R) scaled `scale` times: each string row is expanded into
+ * one of two line buffers while the other is being sent
+ * @param x, y - left upper corner
+ * @param str - text (cut by right screen edge)
+ * @param fg, bg - foreground & background colors
+ * @param scale - 1..LCD_MAXSCALE
+ * @return text width
+ */
+int16_t LCD_puts(int16_t x, int16_t y, const char *str, uint16_t fg, uint16_t bg, uint8_t scale){
+	static uint8_t linebuf[2][TFTWIDTH * 2];
+	int16_t len = strlen(str), w, h, r0 = 0, c0 = 0;
+	if(scale < 1) scale = 1;
+	if(scale > LCD_MAXSCALE) scale = LCD_MAXSCALE;
+	w = len * LTR_WIDTH * scale;
+	h = 8 * scale;
+	int16_t x0 = x, y0 = y, W = w;
+	if(LCD_id == 0 || !clip(&x, &y, &w, &h)) return W;
+	c0 = x - x0; // first visible column & row of text
+	r0 = y - y0;
+	start_window(x, y, w, h);
+	for(int16_t r = 0; r < h; ++r){
+		uint8_t *ptr = linebuf[r & 1], bit = 1 << ((r + r0) / scale);
+		for(int16_t c = c0; c < c0 + w; ++c){
+			int16_t col = c / scale;
+			uint16_t colr = (letter((uint8_t)str[col / LTR_WIDTH])[col % LTR_WIDTH] & bit) ? fg : bg;
+			*ptr++ = colr >> 8;
+			*ptr++ = colr & 0xff;
+		}
+		dmagpio_transfer(linebuf[r & 1], w * 2); // waits for previous line
+	}
+	return W;
+}
@@ -25,6 +25,11 @@
 
 #define TFTWIDTH   240
 #define TFTHEIGHT  320
+// max scale of text
+#define LCD_MAXSCALE  8
+
+// RGB565 color from 8-bit components
+#define RGB565(r, g, b)  ((uint16_t)((((r) & 0xf8) << 8) | (((g) & 0xfc) << 3) | ((b) >> 3)))
 
 #define    DWT_CYCCNT    *(volatile uint32_t *)0xE0001004
 #define    DWT_CONTROL   *(volatile uint32_t *)0xE0001000
@@ -62,6 +67,11 @@ void LCD_reset();
 uint16_t LCD_init();
 void putpoint(uint16_t colr);
 void setpix(uint16_t x, uint16_t y, uint16_t colr);
+void LCD_wait();
+void LCD_fillrect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t colr);
+void LCD_clear(uint16_t colr);
+void LCD_blit(int16_t x, int16_t y, int16_t w, int16_t h, const uint8_t *data);
+int16_t LCD_puts(int16_t x, int16_t y, const char *str, uint16_t fg, uint16_t bg, uint8_t scale);
 
 
 
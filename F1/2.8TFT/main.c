@@ -29,6 +29,18 @@
 volatile uint32_t Timer = 0; // global timer (milliseconds)
 usbd_device *usbd_dev;
 
+// unsigned integer to string
+static char *u2str(uint32_t val){
+	static char buf[11];
+	char *p = &buf[10];
+	*p = 0;
+	do{
+		*--p = val % 10 + '0';
+		val /= 10;
+	}while(val);
+	return p;
+}
+
 int main(){
 	uint32_t Old_timer = 0;
 
@@ -54,6 +66,7 @@ int main(){
 	int oldusblen = 0, x = 0, y = 0;
 	int id = LCD_init();
 	if(!id) P("failed to init LCD\n");
+	else LCD_clear(0);
 	uint16_t colr = 0;
 	while(1){
 		usbd_poll(usbd_dev);
@@ -66,9 +79,6 @@ int main(){
 			P("transfered\n");
 			transfer_complete = 0;
 		}
-		setpix(x++, y++, colr);
-		if(x > 200) x = 0;
-		if(y > 200) y = 0;
 		if(Timer - Old_timer > 999){ // one-second cycle
 			Old_timer += 1000;
 			P("Display id: ");
@@ -90,8 +100,12 @@ int main(){
 					r = read_reg(i); print_hex((uint8_t*)&r, 2);
 					newline();
 				}
-				putpoint(colr);
-				colr += 32;
+				LCD_fillrect(x, y, 40, 40, colr);
+				x += 40; if(x > TFTWIDTH - 40){ x = 0; y += 40; }
+				if(y > TFTHEIGHT - 80) y = 0;
+				LCD_puts(0, TFTHEIGHT - 32, "Time:", RGB565(255, 255, 0), 0, 2);
+				LCD_puts(60, TFTHEIGHT - 32, u2str(Timer / 1000), RGB565(255, 255, 255), colr, 2);
+				colr += 0x0841;
 			}else{
 				LCD_reset();
 				id = LCD_init();
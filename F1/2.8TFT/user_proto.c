@@ -36,6 +36,7 @@ void parse_incoming_buf(uint8_t *buf, int *len){
 		usb_send(cmd);
 		if(cmd == '\n'){
 			dmagpio_transfer(buf, *len);
+			dmagpio_wait(); // buffer is sent without copying
 			*len = 0;
 			lastidx = 0;
 			return;
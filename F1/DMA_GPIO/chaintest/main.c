@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "dmachain.h"
+
+/*
+ * Model of dmagpio.c for ../dmachain.c: each timer update DMA writes next word
+ * into port, CNDTR counts down; in circular mode HT/TC interrupts are served
+ * before next update (period is longer than interrupt latency). When interrupt
+ * turns on one-pulse mode the last update before timer stop makes one more DMA
+ * request, so one extra word of ring goes to port: it should be idle word
+ * (copy of last data word in ODR mode, 0 in BSRR mode).
+ * Single buffer is sent by chunks, pause between chunks doesn't write anything.
+ */
+
+#define MAXOUT	(1<<20)
+
+static uint32_t out[MAXOUT];	// words written into port
+static uint32_t nout;
+static int errors = 0;
+
+static uint64_t rnd = 88172645463325252ULL;
+static uint32_t urand(){
+	rnd ^= rnd << 13; rnd ^= rnd >> 7; rnd ^= rnd << 17;
+	return (uint32_t)(rnd >> 32);
+}
+
+static uint32_t portword(const uint8_t *p, uint8_t wordsz){
+	if(wordsz == 2) return *(const uint16_t*)p;
+	return *(const uint32_t*)p;
+}
+
+// data word number i
+static uint32_t dataword(uint32_t i, uint8_t wordsz){
+	uint32_t w = i * 2654435761u + 1;
+	if(wordsz == 2) w &= 0xffff;
+	if(!w) w = 1; // don't mix with BSRR idle word
+	return w;
+}
+
+static int single(uint32_t n, uint8_t wordsz){
+	static uint8_t buf[MAXOUT * 4];
+	dmachain c;
+	const uint8_t *addr;
+	uint32_t len, nchunks = 0, bad = 0;
+	const uint8_t *expect = buf;
+	printf("single buffer of %u %d-byte words\n", n, wordsz);
+	for(uint32_t i = 0; i < n; ++i){
+		uint32_t w = dataword(i, wordsz);
+		if(wordsz == 2) ((uint16_t*)buf)[i] = (uint16_t)w;
+		else ((uint32_t*)buf)[i] = w;
+	}
+	nout = 0;
+	chain_init(&c, wordsz, wordsz == 2);
+	chunk_start(&c, buf, n);
+	while((len = chunk_next(&c, &addr))){ // run(): DMA from addr, TC -> next chunk
+		++nchunks;
+		if(len > DMACHAIN_MAXCHUNK){ printf("\tchunk of %u words\n", len); ++bad; }
+		if(addr != expect){ printf("\tchunk %u starts at offset %ld\n", nchunks, (long)(addr - buf)); ++bad; }
+		for(uint32_t i = 0; i < len; ++i) out[nout++] = portword(addr + i*wordsz, wordsz);
+		expect = addr + len*wordsz;
+	}
+	if(nout != n){ printf("\t%u words sent\n", nout); ++bad; }
+	if(c.words != n){ printf("\t%u words counted\n", c.words); ++bad; }
+	for(uint32_t i = 0; i < nout && i < n; ++i) if(out[i] != dataword(i, wordsz)){
+		printf("\tword %u is 0x%x, should be 0x%x\n", i, out[i], dataword(i, wordsz));
+		++bad;
+		break;
+	}
+	uint32_t need = (n + DMACHAIN_MAXCHUNK - 1) / DMACHAIN_MAXCHUNK;
+	if(nchunks != need){ printf("\t%u chunks, should be %u\n", nchunks, need); ++bad; }
+	return bad;
+}
+
+// stream producer: `total` words of dataword() by portions
+static uint32_t total, produced, calls;
+static uint8_t curwordsz;
+static uint32_t producer(void *buf, uint32_t n){
+	uint32_t i;
+	++calls;
+	for(i = 0; i < n && produced < total; ++i, ++produced){
+		uint32_t w = dataword(produced, curwordsz);
+		if(curwordsz == 2) ((uint16_t*)buf)[i] = (uint16_t)w;
+		else ((uint32_t*)buf)[i] = w;
+	}
+	return i;
+}
+
+static int stream(uint32_t n, uint32_t half, uint8_t wordsz){
+	static uint8_t ring[2 * 1024 * 4];
+	dmachain c;
+	uint32_t bad = 0, pos = 0, idle;
+	int stop = 0;
+	printf("stream of %u %d-byte words, ring of 2x%u\n", n, wordsz, half);
+	total = n; produced = 0; calls = 0; curwordsz = wordsz;
+	nout = 0;
+	memset(ring, 0xa5, sizeof(ring)); // garbage
+	chain_init(&c, wordsz, wordsz == 2);
+	if(!ring_start(&c, ring, half, producer)){
+		if(n){ printf("\tring_start() failed\n"); ++bad; }
+		return bad;
+	}
+	if(!n){
+		printf("\tempty stream started\n");
+		return bad + 1;
+	}
+	while(1){ // timer update: DMA request
+		out[nout++] = portword(ring + pos*wordsz, wordsz);
+		if(nout >= MAXOUT){ printf("\tstream never ends\n"); return bad + 1; }
+		if(stop) break; // last request before timer stop
+		++pos;
+		if(pos == half && ring_halfdone(&c, 0)) stop = 1;	// HT
+		if(pos == 2*half){									// TC, circular
+			pos = 0;
+			if(ring_halfdone(&c, 1)) stop = 1;
+		}
+	}
+	if(c.words != n){ printf("\t%u words counted\n", c.words); ++bad; }
+	if(nout < n + 1){ printf("\tonly %u words sent\n", nout); return bad + 1; }
+	for(uint32_t i = 0; i < n; ++i) if(out[i] != dataword(i, wordsz)){
+		printf("\tword %u is 0x%x, should be 0x%x\n", i, out[i], dataword(i, wordsz));
+		++bad;
+		break;
+	}
+	idle = (wordsz == 2) ? dataword(n - 1, wordsz) : 0;
+	for(uint32_t i = n; i < nout; ++i) if(out[i] != idle){
+		printf("\tword %u after end of data is 0x%x, should be 0x%x\n", i, out[i], idle);
+		++bad;
+		break;
+	}
+	// after end of data port gets only the rest of its half and one extra word
+	uint32_t tail = (half - n % half) % half + 1;
+	if(nout - n != tail){ printf("\t%u idle words after end of data, should be %u\n", nout - n, tail); ++bad; }
+	return bad;
+}
+
+int main(){
+	uint32_t singles[] = {1, 2, 1000, DMACHAIN_MAXCHUNK - 1, DMACHAIN_MAXCHUNK, DMACHAIN_MAXCHUNK + 1,
+		3*DMACHAIN_MAXCHUNK, 200000};
+	for(size_t i = 0; i < sizeof(singles)/sizeof(singles[0]); ++i){
+		errors += single(singles[i], 2);
+		errors += single(singles[i], 4);
+	}
+	uint32_t halves[] = {1, 2, 64, 1000};
+	for(size_t h = 0; h < sizeof(halves)/sizeof(halves[0]); ++h){
+		uint32_t H = halves[h];
+		uint32_t lens[] = {0, 1, H - 1, H, H + 1, 2*H - 1, 2*H, 2*H + 1, 3*H, 4*H, 10*H + 3, 5000 + urand() % 5000};
+		for(size_t i = 0; i < sizeof(lens)/sizeof(lens[0]); ++i){
+			if(i && !lens[i]) continue; // H-1 for H=1
+			errors += stream(lens[i], H, 2);
+			errors += stream(lens[i], H, 4);
+		}
+	}
+	if(errors) printf("%d errors\n", errors);
+	else printf("All OK\n");
+	return errors ? 1 : 0;
+}
@@ -0,0 +1,123 @@
+/*
+ * dmachain.c
+ *
+ * Copyright 2016 Edward V. Emelianov <eddy@sao.ru, edward.emelianoff@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "dmachain.h"
+
+/**
+ * Init chain for new transfer
+ * @param wordsz   - size of DMA word (2 for ODR, 4 for BSRR)
+ * @param keeplast - pad stream tail with last data word instead of zeros
+ */
+void chain_init(dmachain *c, uint8_t wordsz, uint8_t keeplast){
+	c->next = 0;
+	c->rest = 0;
+	c->ring = 0;
+	c->half = 0;
+	c->fill = 0;
+	c->last = -1;
+	c->idle = 0;
+	c->wordsz = wordsz;
+	c->keeplast = keeplast;
+	c->words = 0;
+}
+
+/**
+ * Prepare single buffer of any length for chunked transfer
+ * @param buf - data (used in place)
+ * @param n   - its length in words
+ */
+void chunk_start(dmachain *c, const void *buf, uint32_t n){
+	c->next = (const uint8_t*) buf;
+	c->rest = n;
+}
+
+/**
+ * Get next chunk of single buffer
+ * @param addr (o) - chunk address
+ * @return amount of words in chunk (0 if all sent)
+ */
+uint32_t chunk_next(dmachain *c, const uint8_t **addr){
+	uint32_t n = c->rest;
+	if(!n) return 0;
+	if(n > DMACHAIN_MAXCHUNK) n = DMACHAIN_MAXCHUNK;
+	*addr = c->next;
+	c->next += n * c->wordsz;
+	c->rest -= n;
+	c->words += n;
+	return n;
+}
+
+// get/put word `i` of ring
+static uint32_t getword(dmachain *c, uint32_t i){
+	if(c->wordsz == 2) return ((uint16_t*)c->ring)[i];
+	return ((uint32_t*)c->ring)[i];
+}
+static void putword(dmachain *c, uint32_t i, uint32_t w){
+	if(c->wordsz == 2) ((uint16_t*)c->ring)[i] = (uint16_t) w;
+	else ((uint32_t*)c->ring)[i] = w;
+}
+
+/*
+ * Refill half `idx` of ring; the tail after end of data is padded by idle words
+ * @return 1 if stream is over
+ */
+static int refill(dmachain *c, uint8_t idx){
+	uint32_t start = idx * c->half, n = 0, i;
+	if(c->last < 0){
+		n = c->fill(c->ring + start * c->wordsz, c->half);
+		if(n > c->half) n = c->half;
+		c->words += n;
+		if(n && c->keeplast) c->idle = getword(c, start + n - 1);
+		if(n < c->half){
+			// data ends in this half or ended at the end of previous one
+			c->last = n ? (int8_t)idx : (int8_t)!idx;
+		}
+	}
+	for(i = n; i < c->half; ++i) putword(c, start + i, c->idle);
+	return (n == 0);
+}
+
+/**
+ * Start ping-pong stream: both halves are filled by producer
+ * @param ring - buffer for 2*half words
+ * @param half - half of ring size (words)
+ * @param fill - data producer
+ * @return 0 if there's no data at all
+ */
+int ring_start(dmachain *c, void *ring, uint32_t half, dmachain_producer fill){
+	c->ring = (uint8_t*) ring;
+	c->half = half;
+	c->fill = fill;
+	c->last = -1;
+	if(refill(c, 0)) return 0;
+	refill(c, 1);
+	return 1;
+}
+
+/**
+ * Half `idx` of ring is sent (0 - by half transfer, 1 - by transfer complete event)
+ * @return 1 if all data is out and DMA should be stopped
+ */
+int ring_halfdone(dmachain *c, uint8_t idx){
+	if(c->last == (int8_t)idx) return 1;
+	refill(c, idx);
+	return 0;
+}
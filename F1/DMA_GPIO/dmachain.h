@@ -0,0 +1,64 @@
+/*
+ * dmachain.h
+ *
+ * Copyright 2016 Edward V. Emelianov <eddy@sao.ru, edward.emelianoff@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+#pragma once
+#ifndef __DMACHAIN_H__
+#define __DMACHAIN_H__
+
+/*
+ * Hardware-independent part of DMA engine: splitting of long buffers into
+ * chunks & ping-pong ring refilling. Don't include here any MCU headers:
+ * this file can be built on host together with DMA model.
+ */
+
+#include <stdint.h>
+
+// max amount of words in one DMA run (CNDTR is 16-bit)
+#define DMACHAIN_MAXCHUNK	(65535)
+
+/*
+ * Stream producer: put up to `n` words into `buf` (just in DMA ring - no copying),
+ * return amount of words put; value less than `n` means end of stream
+ */
+typedef uint32_t (*dmachain_producer)(void *buf, uint32_t n);
+
+typedef struct{
+	// single buffer
+	const uint8_t *next;	// start of next chunk
+	uint32_t rest;			// words left
+	// ping-pong ring
+	uint8_t *ring;			// two halves of `half` words each
+	uint32_t half;
+	dmachain_producer fill;
+	int8_t last;			// index of half with the end of data or -1
+	uint32_t idle;			// word to pad the last half
+	// common
+	uint8_t wordsz;			// size of word: 2 or 4 bytes
+	uint8_t keeplast;		// idle word is a copy of last data word (ODR) or 0 (BSRR)
+	uint32_t words;			// amount of data words given to DMA
+} dmachain;
+
+void chain_init(dmachain *c, uint8_t wordsz, uint8_t keeplast);
+void chunk_start(dmachain *c, const void *buf, uint32_t n);
+uint32_t chunk_next(dmachain *c, const uint8_t **addr);
+int ring_start(dmachain *c, void *ring, uint32_t half, dmachain_producer fill);
+int ring_halfdone(dmachain *c, uint8_t idx);
+
+#endif // __DMACHAIN_H__
@@ -19,79 +19,217 @@
  * MA 02110-1301, USA.
  */
 
+/*
+ * Parallel output engine: TIM2 update events request DMA1 channel 2, which
+ * writes next word of caller's buffer into port ODR (16-bit words) or BSRR
+ * (32-bit set/reset words for masked pins). Buffers are never copied.
+ * Strobe is PWM on TIM2_CH3 (PB10, partial remap 2): it goes active `delay`
+ * ticks after data update and becomes inactive with next update.
+ * Single buffer of any length is sent by chunks of DMACHAIN_MAXCHUNK words
+ * (with short pause between them); stream is sent without pauses by
+ * half-transfer ping-pong in circular ring refilled by producer.
+ * At the end TC interrupt turns on one-pulse mode, so timer stops just after
+ * last word's strobe (if period is longer than interrupt latency);
+ * dmagpio_process() in main loop waits for this stop, turns off DMA and runs
+ * next chunk or finishes transfer.
+ */
+
+#include <libopencm3/cm3/dwt.h>
+#include <libopencm3/cm3/scs.h>
 #include "dmagpio.h"
 #include "user_proto.h"
 
-int transfer_complete = 0;
-static uint16_t gpiobuff[128] = {0};
+volatile int transfer_complete = 0;
+
+static dmachain chain;
+static dmagpio_mode curmode = DMAGPIO_ODR;
+static volatile uint8_t busy = 0, ringmode = 0;
+static volatile uint8_t stopping = 0; // timer stops after current word
+static volatile uint32_t tstart = 0, tcycles = 0; // DWT cycles of last transfer
 
 void dmagpio_init(){
 	// init TIM2 & DMA1ch2 (TIM2UP)
 	rcc_periph_clock_enable(RCC_TIM2);
 	rcc_periph_clock_enable(RCC_DMA1);
+	rcc_periph_clock_enable(RCC_AFIO);
+	// TIM2_CH3 -> PB10
+	gpio_primary_remap(AFIO_MAPR_SWJ_CFG_FULL_SWJ, AFIO_MAPR_TIM2_REMAP_PARTIAL_REMAP2);
+	gpio_set_mode(DMAGPIO_STROBE_PORT, GPIO_MODE_OUTPUT_50_MHZ,
+		GPIO_CNF_OUTPUT_ALTFN_PUSHPULL, DMAGPIO_STROBE_PIN);
 	timer_reset(TIM2);
-	// timer have frequency of 1MHz
 	timer_set_mode(TIM2, TIM_CR1_CKD_CK_INT, TIM_CR1_CMS_EDGE, TIM_CR1_DIR_UP);
-	// 72MHz div 18 = 4MHz
-	TIM2_PSC = 0; // prescaler is (div - 1)
-	TIM2_ARR = 1; // 36MHz (6.25)
-	TIM2_DIER = TIM_DIER_UDE;// | TIM_DIER_UIE;
-//nvic_enable_irq(NVIC_TIM2_IRQ);
-
+	TIM2_PSC = 0; // 72MHz ticks
+	// PWM mode 2: inactive while CNT < CCR3
+	TIM2_CCMR2 = TIM_CCMR2_OC3M_PWM2;
+	TIM2_DIER = TIM_DIER_UDE;
 	dma_channel_reset(DMA1, DMA_CHANNEL2);
-	// mem2mem, medium prio, 8bits, memory increment, read from mem, transfer complete en
-	//DMA1_CCR2 = DMA_CCR_MEM2MEM | DMA_CCR_PL_MEDIUM | DMA_CCR_MSIZE_16BIT |
-	DMA1_CCR2 = DMA_CCR_PL_MEDIUM | DMA_CCR_MSIZE_16BIT |
-		DMA_CCR_PSIZE_16BIT | DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_TCIE | DMA_CCR_TEIE ;
 	nvic_enable_irq(NVIC_DMA1_CHANNEL2_IRQ);
-	// target address:
-	DMA1_CPAR2 = DMAGPIO_TARGADDR;
-	DMA1_CMAR2 = (uint32_t) gpiobuff;
+	// cycles counter for throughput measurement
+	SCS_DEMCR |= SCS_DEMCR_TRCENA;
+	DWT_CYCCNT = 0;
+	DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+	dmagpio_setup(DMAGPIO_ODR, DMAGPIO_DEFPERIOD, DMAGPIO_DEFDELAY);
 }
-/*
-void tim2_isr(){
-	if(TIM2_SR & TIM_SR_UIF){ // update interrupt
-		++cntr;
-		GPIOA_ODR = gpiobuff[curidx];
-		if(++curidx >= len){
-			TIM2_CR1 &= ~TIM_CR1_CEN;
-			transfer_complete = 1;
-		}
-		TIM2_SR = 0;
+
+/**
+ * Setup output mode & timing
+ * @param mode   - DMAGPIO_ODR or DMAGPIO_BSRR
+ * @param period - word period in 72MHz ticks (>= DMAGPIO_MINPERIOD)
+ * @param delay  - strobe delay after data update (ticks), 0 - no strobe
+ * @return 0 if all OK
+ */
+int dmagpio_setup(dmagpio_mode mode, uint16_t period, uint16_t delay){
+	if(busy || period < DMAGPIO_MINPERIOD || delay >= period) return 1;
+	curmode = mode;
+	TIM2_ARR = period - 1;
+	TIM2_CCR3 = delay;
+	if(delay) TIM2_CCER |= TIM_CCER_CC3E;
+	else TIM2_CCER &= ~TIM_CCER_CC3E;
+	if(mode == DMAGPIO_ODR){
+		DMA1_CCR2 = DMA_CCR_PL_HIGH | DMA_CCR_MSIZE_16BIT | DMA_CCR_PSIZE_16BIT |
+			DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_TEIE;
+		DMA1_CPAR2 = DMAGPIO_ODRADDR;
+	}else{
+		DMA1_CCR2 = DMA_CCR_PL_HIGH | DMA_CCR_MSIZE_32BIT | DMA_CCR_PSIZE_32BIT |
+			DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_TEIE;
+		DMA1_CPAR2 = DMAGPIO_BSRRADDR;
 	}
+	return 0;
 }
-*/
 
-void dmagpio_transfer(uint8_t *databuf, uint32_t length){
-	while(DMA1_CCR2 & DMA_CCR_EN);
-	transfer_complete = 0;
-	DMA1_IFCR = 0xff00; // clear all flags for ch2
-	// memory address
-	//DMA1_CMAR2 = (uint32_t) databuf;
-	// buffer length
-//	DMA1_CPAR2 = DMAGPIO_TARGADDR;
-//	DMA1_CMAR2 = (uint32_t) gpiobuff;
-	DMA1_CNDTR2 = length;
-	uint32_t i;
-	for(i = 0; i < length; ++i) gpiobuff[i] = databuf[i];
-	TIM2_CR1 |= TIM_CR1_CEN; // run timer
+/**
+ * Change output mode keeping current timing
+ */
+int dmagpio_setmode(dmagpio_mode mode){
+	return dmagpio_setup(mode, TIM2_ARR + 1, TIM2_CCR3);
+}
+
+// run DMA & timer from the start
+static void run(const void *addr, uint32_t n){
+	DMA1_IFCR = DMA_IFCR_CGIF2;
+	DMA1_CMAR2 = (uint32_t) addr;
+	DMA1_CNDTR2 = n;
 	DMA1_CCR2 |= DMA_CCR_EN;
+	TIM2_CR1 &= ~TIM_CR1_OPM;
+	TIM2_EGR = TIM_EGR_UG; // send first word & clear counter
+	TIM2_CR1 |= TIM_CR1_CEN;
+}
+
+// prepare new transfer
+static void prepare(){
+	busy = 1;
+	transfer_complete = 0;
+	chain_init(&chain, (curmode == DMAGPIO_ODR) ? 2 : 4, (curmode == DMAGPIO_ODR));
+	tstart = DWT_CYCCNT;
+}
+
+/**
+ * Send buffer of any length without copying
+ * @param buf - data: uint16_t port words (ODR mode) or uint32_t BSRR words
+ * @param n   - amount of words
+ * @return 0 if transfer started
+ */
+int dmagpio_transfer(const void *buf, uint32_t n){
+	const uint8_t *addr;
+	if(busy || !n) return 1;
+	prepare();
+	ringmode = 0;
+	DMA1_CCR2 &= ~(DMA_CCR_CIRC | DMA_CCR_HTIE);
+	DMA1_CCR2 |= DMA_CCR_TCIE;
+	chunk_start(&chain, buf, n);
+	n = chunk_next(&chain, &addr);
+	run(addr, n);
+	return 0;
+}
+
+/**
+ * Send stream of unknown length by ping-pong: when one half of `ring` is sent,
+ * `fill` is called (in interrupt!) to put next data into it
+ * @param ring - buffer for 2*`half` words
+ * @param half - amount of words in each half (2*half <= DMACHAIN_MAXCHUNK)
+ * @param fill - data producer
+ * @return 0 if transfer started
+ */
+int dmagpio_stream(void *ring, uint32_t half, dmachain_producer fill){
+	if(busy || !half || 2*half > DMACHAIN_MAXCHUNK) return 1;
+	prepare();
+	if(!ring_start(&chain, ring, half, fill)){
+		busy = 0;
+		return 1;
+	}
+	ringmode = 1;
+	DMA1_CCR2 |= DMA_CCR_CIRC | DMA_CCR_HTIE | DMA_CCR_TCIE;
+	run(ring, 2*half);
+	return 0;
+}
+
+uint8_t dmagpio_busy(){
+	return busy;
+}
+
+void dmagpio_wait(){
+	while(busy) dmagpio_process();
+}
+
+/**
+ * Throughput of last finished transfer
+ * @param words (o) - amount of data words sent (if not NULL)
+ * @return words per second
+ */
+uint32_t dmagpio_throughput(uint32_t *words){
+	uint32_t w = chain.words, c = tcycles;
+	if(words) *words = w;
+	if(!c) return 0;
+	return (uint32_t)((uint64_t)w * DMAGPIO_CLOCK / c);
+}
+
+// stop timer after current word (dmagpio_process() will wait for it)
+static void halt(){
+	TIM2_CR1 |= TIM_CR1_OPM;
+	stopping = 1;
+}
+
+static void finish(){
+	tcycles = DWT_CYCCNT - tstart;
+	busy = 0;
+	transfer_complete = 1;
+}
+
+/**
+ * Finish transfer or chain next chunk when timer stops, should be called from main loop
+ */
+void dmagpio_process(){
+	const uint8_t *addr;
+	uint32_t n;
+	if(!stopping || (TIM2_CR1 & TIM_CR1_CEN)) return;
+	stopping = 0;
+	DMA1_CCR2 &= ~DMA_CCR_EN;
+	if(!ringmode && (n = chunk_next(&chain, &addr))) run(addr, n); // chain next chunk
+	else finish();
 }
 
 void dma1_channel2_isr(){
-	if(DMA1_ISR & DMA_ISR_TCIF2){
-		transfer_complete = 1;
-		// stop timer & turn off DMA
+	uint32_t isr = DMA1_ISR;
+	if(isr & DMA_ISR_TEIF2){
+		DMA1_IFCR = DMA_IFCR_CGIF2;
 		TIM2_CR1 &= ~TIM_CR1_CEN;
 		DMA1_CCR2 &= ~DMA_CCR_EN;
-		DMA1_IFCR = DMA_IFCR_CTCIF2; // clear flag
-	/*	uint32_t arr = TIM2_ARR;
-		if(arr == 1) TIM2_ARR = 71;
-		else TIM2_ARR = arr - 1;*/
-	}else if(DMA1_ISR & DMA_ISR_TEIF2){
+		stopping = 0;
+		busy = 0;
 		P("Error\n");
-		DMA1_IFCR = DMA_IFCR_CTEIF2;
-		TIM2_CR1 &= ~TIM_CR1_CEN;
-		DMA1_CCR2 &= ~DMA_CCR_EN;
+		return;
+	}
+	if(ringmode){
+		if(isr & DMA_ISR_HTIF2){
+			DMA1_IFCR = DMA_IFCR_CHTIF2;
+			if(ring_halfdone(&chain, 0)) halt();
+		}
+		if(isr & DMA_ISR_TCIF2){
+			DMA1_IFCR = DMA_IFCR_CTCIF2;
+			if(ring_halfdone(&chain, 1)) halt();
+		}
+	}else if(isr & DMA_ISR_TCIF2){
+		DMA1_IFCR = DMA_IFCR_CTCIF2;
+		halt();
 	}
 }
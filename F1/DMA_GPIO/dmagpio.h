@@ -24,9 +24,29 @@
 
 #include "main.h"
 #include "hardware_ini.h"
+#include "dmachain.h"
+
+// TIM2 ticks (1/72us): minimal word period, default period & strobe delay
+#define DMAGPIO_MINPERIOD	(8)
+#define DMAGPIO_DEFPERIOD	(72)
+#define DMAGPIO_DEFDELAY	(36)
+// core (DWT) & TIM2 clock, Hz: rcc_clock_setup_in_hse_8mhz_out_72mhz()
+#define DMAGPIO_CLOCK		(72000000)
+
+typedef enum{
+	DMAGPIO_ODR,	// uint16_t words written into port ODR
+	DMAGPIO_BSRR	// uint32_t set/reset words written into port BSRR
+} dmagpio_mode;
 
 void dmagpio_init();
-void dmagpio_transfer(uint8_t *databuf, uint32_t length);
-extern int transfer_complete;
+int dmagpio_setup(dmagpio_mode mode, uint16_t period, uint16_t delay);
+int dmagpio_setmode(dmagpio_mode mode);
+int dmagpio_transfer(const void *buf, uint32_t n);
+int dmagpio_stream(void *ring, uint32_t half, dmachain_producer fill);
+void dmagpio_process();
+uint8_t dmagpio_busy();
+void dmagpio_wait();
+uint32_t dmagpio_throughput(uint32_t *words);
+extern volatile int transfer_complete;
 
 #endif // __DMAGPIO_H__
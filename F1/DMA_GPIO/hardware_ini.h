@@ -26,6 +26,7 @@
 /*
  * Timers:
  * SysTick - system time
+ * TIM2 - DMA requests & strobe
  */
 
 
@@ -37,7 +38,11 @@ void SysTick_init();
  */
 #define DMAGPIO_PORT		GPIOA
 #define DMAGPIO_PINS		0xff
-#define DMAGPIO_TARGADDR	((uint32_t)&(GPIOA_ODR))
+#define DMAGPIO_ODRADDR		((uint32_t)&(GPIOA_ODR))
+#define DMAGPIO_BSRRADDR	((uint32_t)&(GPIOA_BSRR))
+// strobe: TIM2_CH3 (partial remap 2)
+#define DMAGPIO_STROBE_PORT	GPIOB
+#define DMAGPIO_STROBE_PIN	GPIO10
 
 /*
  * USB interface
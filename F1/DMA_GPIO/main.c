@@ -53,9 +53,15 @@ int main(){
 			parse_incoming_buf(usbdatabuf, &usbdatalen);
 			oldusblen = usbdatalen;
 		}
+		dmagpio_process();
 		if(transfer_complete){
-			P("transfered\n");
+			uint32_t words, speed = dmagpio_throughput(&words);
 			transfer_complete = 0;
+			P("transfered ");
+			print_int(words);
+			P(" words, ");
+			print_int(speed);
+			P(" words/s\n");
 		}
 		if(Timer - Old_timer > 999){ // one-second cycle
 			Old_timer += 1000;
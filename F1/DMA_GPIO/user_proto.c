@@ -24,6 +24,106 @@
 #include "hardware_ini.h"
 #include "dmagpio.h"
 
+// ring for streaming (big enough for BSRR words)
+#define RINGHALF	(128)
+static uint32_t ring[2*RINGHALF];
+static uint8_t bsrrmode = 0;
+// stream source: text line or (if NULL) counter
+static const uint8_t *srcline = NULL;
+static uint32_t srcrest = 0;
+static uint8_t srccntr = 0;
+
+// make port word from byte
+static uint32_t mkword(uint8_t b){
+	if(!bsrrmode) return b;
+	return ((uint32_t)(~b & DMAGPIO_PINS) << 16) | (b & DMAGPIO_PINS);
+}
+
+// producer: format data right in DMA ring
+static uint32_t fill(void *buf, uint32_t n){
+	uint32_t i;
+	if(n > srcrest) n = srcrest;
+	for(i = 0; i < n; ++i){
+		uint8_t b = srcline ? *srcline++ : srccntr++;
+		if(bsrrmode) ((uint32_t*)buf)[i] = mkword(b);
+		else ((uint16_t*)buf)[i] = mkword(b);
+	}
+	srcrest -= n;
+	return n;
+}
+
+// read unsigned integer, return pointer to next symbol or NULL if there's no number
+static uint8_t *getnum(uint8_t *buf, uint32_t *N){
+	uint32_t n = 0;
+	while(*buf == ' ') ++buf;
+	if(*buf < '0' || *buf > '9') return NULL;
+	while(*buf >= '0' && *buf <= '9') n = n*10 + *buf++ - '0';
+	*N = n;
+	return buf;
+}
+
+// check whether line is a command: letter & numbers only
+static int iscommand(uint8_t *buf){
+	++buf;
+	while(*buf != '\n'){
+		if(*buf != ' ' && (*buf < '0' || *buf > '9')) return 0;
+		++buf;
+	}
+	return 1;
+}
+
+/*
+ * Commands:
+ *   O - output 16-bit words to ODR
+ *   B - output set/reset words to BSRR (for DMAGPIO_PINS only)
+ *   S period delay - set word period & strobe delay (72MHz ticks)
+ *   T amount - stream `amount` words of counter
+ * any other line is sent byte by byte
+ */
+static void command(uint8_t *buf){
+	uint32_t N, D;
+	uint8_t *nxt;
+	if(dmagpio_busy()){
+		P("Busy\n");
+		return;
+	}
+	switch(*buf){
+		case 'O':
+			bsrrmode = 0;
+			dmagpio_setmode(DMAGPIO_ODR);
+			P("ODR mode\n");
+		break;
+		case 'B':
+			bsrrmode = 1;
+			dmagpio_setmode(DMAGPIO_BSRR);
+			P("BSRR mode\n");
+		break;
+		case 'S':
+			if(!(nxt = getnum(buf+1, &N)) || !getnum(nxt, &D)){
+				P("Need period & delay\n");
+				return;
+			}
+			if(N > 0xffff || dmagpio_setup(bsrrmode ? DMAGPIO_BSRR : DMAGPIO_ODR, N, D)){
+				P("Bad timing\n");
+				return;
+			}
+			P("OK\n");
+		break;
+		case 'T':
+			if(!getnum(buf+1, &N) || !N){
+				P("Need amount\n");
+				return;
+			}
+			srcline = NULL;
+			srcrest = N;
+			srccntr = 0;
+			if(dmagpio_stream(ring, RINGHALF, fill)) P("Can't start\n");
+		break;
+		default:
+			P("Unknown command\n");
+	}
+}
+
 /**
  * parse command buffer buf with length len
  * return 0 if buffer processed or len if there's not enough data in buffer
@@ -35,7 +135,13 @@ void parse_incoming_buf(uint8_t *buf, int *len){
 		uint8_t cmd = buf[lastidx];
 		usb_send(cmd);
 		if(cmd == '\n'){
-			dmagpio_transfer(buf, *len);
+			if(lastidx && buf[0] >= 'A' && buf[0] <= 'Z' && iscommand(buf)) command(buf);
+			else{
+				srcline = buf;
+				srcrest = lastidx + 1;
+				// USB buffer will be reused after return, so wait for transfer end
+				if(!dmagpio_stream(ring, RINGHALF, fill)) dmagpio_wait();
+			}
 			*len = 0;
 			lastidx = 0;
 			return;
@@ -21,12 +21,16 @@
 
 #include "main.h"
 #include "GPS.h"
+#include "nmea.h"
+#include "ubx.h"
 #include "uart.h"
 
 #define GPS_endline() do{GPS_send_string((uint8_t*)"\r\n");}while(0)
 #define U(arg)  ((uint8_t*)arg)
 
 gps_status GPS_status = GPS_WAIT;
+uint8_t GPS_echo = 1; // send NMEA sentences to USB
+static uint8_t rmc_off = 0; // RMC was turned off by CFG-MSG
 
 void GPS_send_string(uint8_t *str){
 	while(*str)
@@ -103,31 +107,32 @@ void write_with_checksum(uint8_t *buf){
 	GPS_endline();
 }
 
-/**
- * set rate for given NMEA field
- * @param field - name of NMEA field
- * @param rate  - rate in seconds (0 disables field)
- * @return -1 if fails, rate if OK
- */
-void block_field(const uint8_t *field){
-	uint8_t buf[22];
-	memcpy(buf, U("$PUBX,40,"), 9);
-	memcpy(buf+9, field, 3);
-	memcpy(buf+12, U(",0,0,0,0*"), 9);
-	buf[21] = 0;
-	write_with_checksum(buf);
-}
-
+// send UBX frame made by one of ubx_... functions
+#define UBX_SEND(fn, ...)  do{ \
+	uint8_t f_[UBX_MAX_PAYLOAD + UBX_OVERHEAD]; \
+	uint16_t i_, n_ = fn(f_, __VA_ARGS__); \
+	for(i_ = 0; i_ < n_; ++i_) fill_uart_buff(USART2, f_[i_]); \
+}while(0)
 
 /**
- * Send starting sequences (get only RMC messages)
+ * Send starting sequence: 1Hz solution & pulse aligned to UTC, NAV-PVT & TIM-TP
+ * on each solution; NMEA sentences are turned off except RMC, which is turned off
+ * when first NAV-PVT comes (old receivers without NAV-PVT will give time by RMC)
  */
 void GPS_send_start_seq(){
-	const uint8_t *GPmsgs[5] = {U("GSV"), U("GSA"), U("GGA"), U("GLL"), U("VTG")};
-	int i;
-	for(i = 0; i < 5; ++i)
-		block_field(GPmsgs[i]);
+	const uint16_t nmeaoff[] = {UBX_NMEA_GGA, UBX_NMEA_GLL, UBX_NMEA_GSA,
+		UBX_NMEA_GSV, UBX_NMEA_VTG, UBX_NMEA_ZDA};
+	uint8_t i;
+	for(i = 0; i < sizeof(nmeaoff)/sizeof(nmeaoff[0]); ++i)
+		UBX_SEND(ubx_cfg_msg, nmeaoff[i], 0);
+	UBX_SEND(ubx_cfg_msg, UBX_NMEA_RMC, 1);
+	UBX_SEND(ubx_cfg_rate, 1000);
+	UBX_SEND(ubx_cfg_tp5, 1000000, 100000);
+	UBX_SEND(ubx_cfg_msg, UBX_NAV_PVT, 1);
+	UBX_SEND(ubx_cfg_msg, UBX_TIM_TP, 1);
+	rmc_off = 0;
 }
+
 /*
 uint8_t *nextpos(uint8_t **buf, int pos){
 	int i;
@@ -142,52 +147,53 @@ uint8_t *nextpos(uint8_t **buf, int pos){
 #define NEXT()      do{if(!nextpos(&buf, 1)) goto ret;}while(0)
 #define SKIP(NPOS)  do{if(!nextpos(&buf, NPOS)) goto ret;}while(0)
 */
-/**
- * Parse answer from GPS module
- *
- * Recommended minimum specific GPS/Transit data
- * $GPRMC,hhmmss,status,latitude,N,longitude,E,spd,cog,ddmmyy,mv,mvE,mode*cs
- * 1    = UTC of position fix
- * 2    = Data status (V=navigation receiver warning)
- * 3    = Latitude of fix
- * 4    = N or S
- * 5    = Longitude of fix
- * 6    = E or W
- * 7    = Speed over ground in knots
- * 8    = Cource over ground in degrees
- * 9    = UT date
- * 10   = Magnetic variation degrees (Easterly var. subtracts from true course)
- * 11   = E or W
- * 12   = Mode: N(bad), E(approx), A(auto), D(diff)
- * 213457.00,A,4340.59415,N,04127.47560,E,2.494,,290615,,,A*7B
- */
-void GPS_parse_answer(uint8_t *buf){
-	uint8_t *ptr;
-	if(strncmp(buf+3, U("RMC"), 3)){ // not RMC message
-		GPS_send_start_seq();
-		return;
-	}
-	if(!checksum_true(buf)){
-		DBG("Wrong chs\n");
-		return; // wrong checksum
-	}
-	buf += 7; // skip header
-	if(*buf == ','){ // time unknown
+// set time by last fix
+static void fix_time(){
+	nmea_fix fix;
+	uint8_t tm[6];
+	nmea_get(&fix);
+	if(!fix.timeok){ // time unknown
 		GPS_status = GPS_WAIT;
 		return;
 	}
-	//P("time: ");
-	ptr = ustrchr(buf, ',');
-	*ptr++ = 0;
-	//P(buf);
-	if(*ptr == 'A'){
+	if(fix.valid){
 		GPS_status = GPS_VALID;
-		set_time(buf);
+		tm[0] = '0' + fix.H / 10; tm[1] = '0' + fix.H % 10;
+		tm[2] = '0' + fix.M / 10; tm[3] = '0' + fix.M % 10;
+		tm[4] = '0' + fix.S / 10; tm[5] = '0' + fix.S % 10;
+		set_time(tm);
 	}else
 		GPS_status = GPS_NOT_VALID;
-//	buf = ustrchr(ptr, ',');
-//	P(" ");
-	P("\n");
+}
+
+// byte of NMEA stream
+static uint8_t nmea_byte(uint8_t c){
+	if(GPS_echo) usb_send(c);
+	return nmea_putc(c);
+}
+
+/**
+ * Process all data received from GPS module: UBX frames start from 0xB5 0x62,
+ * all other goes to NMEA parser (and to USB if GPS_echo is set);
+ * time is set by each NAV-PVT or RMC
+ */
+void GPS_process(){
+	uint8_t c, types = 0;
+	while(read_UART2(&c)){
+		if(ubx_sync1() && c != UBX_SYNC2){ // lone 0xB5 isn't UBX frame: return it to NMEA
+			ubx_putc(c, msctr); // drop sync
+			types |= nmea_byte(UBX_SYNC1);
+		}
+		if(ubx_busy() || c == UBX_SYNC1){
+			if(ubx_putc(c, msctr) == UBX_NAV_PVT) types |= NMEA_PVT;
+		}else types |= nmea_byte(c);
+	}
+	if(types & NMEA_PVT && (types & NMEA_RMC || !rmc_off)){
+		// receiver knows UBX, so we don't need RMC any more
+		UBX_SEND(ubx_cfg_msg, UBX_NMEA_RMC, 0);
+		rmc_off = 1;
+	}
+	if(types & (NMEA_RMC | NMEA_PVT)) fix_time();
 }
 
 /*
@@ -30,8 +30,9 @@ typedef enum{
 } gps_status;
 
 extern gps_status GPS_status;
+extern uint8_t GPS_echo;
 
-void GPS_parse_answer(uint8_t *string);
+void GPS_process();
 void GPS_send_start_seq();
 
 #endif // __GPS_H__
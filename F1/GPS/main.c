@@ -24,6 +24,8 @@
 #include "cdcacm.h"
 #include "uart.h"
 #include "GPS.h"
+#include "nmea.h"
+#include "ubx.h"
 
 volatile uint32_t Timer = 0; // milliseconds
 volatile uint32_t msctr = 0; // global milliseconds for different purposes
@@ -59,7 +61,6 @@ void time_increment(){
 }
 
 int main(){
-	uint8_t *string;
 	// RCC clocking: 8MHz oscillator -> 72MHz system
 	rcc_clock_setup_in_hse_8mhz_out_72mhz();
 
@@ -80,6 +81,8 @@ int main(){
 
 	usb_connect(); // turn on USB
 
+	nmea_init();
+	ubx_init();
 	GPS_send_start_seq();
 
 	uint32_t trigrtm = 0;
@@ -88,10 +91,7 @@ int main(){
 		if(usbdatalen){ // there's something in USB buffer
 			usbdatalen = parse_incoming_buf(usbdatabuf, usbdatalen);
 		}
-		if((string = check_UART2())){
-			P(string);
-			GPS_parse_answer(string);
-		}
+		GPS_process();
 		if(systick_val){
 			P("Systick differs by ");
 			print_int(systick_val);
@@ -143,6 +143,7 @@ void exti4_isr(){
 		timer_val = Timer;
 		Timer = 0;
 		systick_val = STK_RVR + 1 - systick_val; // Systick counts down!
+		ubx_pps_event(msctr, systick_val); // tag pulse by last TIM-TP
 		if(timer_val < 10) timer_val += 1000; // our closks go faster than real
 		else if(timer_val < 990){ // something wrong
 			RVR0 = RVR1 = STK_RVR_DEFAULT_VAL;
@@ -60,6 +60,7 @@ typedef struct{
 
 extern curtime current_time;
 extern volatile uint32_t Timer; // global timer (milliseconds)
+extern volatile uint32_t msctr; // milliseconds from start
 extern volatile int clear_ST_on_connect; // flag for clearing Systick counter on next PPS
 
 extern volatile int need_sync;
@@ -0,0 +1,210 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "nmea.h"
+
+#define SAMPLE  "sample.nmea"
+#define STREAM  "stream.nmea"
+
+static int errors = 0;
+
+#define CHECK(name, val, exp) do{ \
+    long long v_ = (val), e_ = (exp); \
+    if(v_ != e_){ printf("line %d: %s = %lld, should be %lld\n", lineno, name, v_, e_); ++errors; } \
+    }while(0)
+
+static char *readfile(const char *name, size_t *len){
+    FILE *f = fopen(name, "r");
+    char *buf;
+    if(!f){
+        perror(name);
+        exit(1);
+    }
+    fseek(f, 0, SEEK_END);
+    *len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    buf = malloc(*len + 1);
+    if(fread(buf, 1, *len, f) != *len){
+        perror("fread");
+        exit(1);
+    }
+    buf[*len] = 0;
+    fclose(f);
+    return buf;
+}
+
+static void printfix(){
+    nmea_fix F;
+    nmea_stat st;
+    nmea_get(&F);
+    nmea_getstat(&st);
+    printf("%02d/%02d/%04d %02d:%02d:%02d.%03d (%s), lat=%.7f, lon=%.7f, alt=%.2fm\n",
+        F.day, F.month, F.year, F.H, F.M, F.S, F.ms, F.valid ? "valid" : "not valid",
+        F.lat / 1e7, F.lon / 1e7, F.alt / 100.);
+    printf("speed=%.3fm/s, course=%.2f, fix=%dD, quality=%d, sats=%d, PDOP=%.2f, HDOP=%.2f, VDOP=%.2f\n",
+        F.speed / 1e3, F.course / 100., F.fixtype, F.quality, F.sats, F.pdop / 100., F.hdop / 100., F.vdop / 100.);
+    printf("%u sentences good, %u with bad checksum, %u broken\n", st.good, st.badsum, st.broken);
+}
+
+// check values after given line of sample
+static void check_line(int lineno){
+    nmea_fix F;
+    nmea_get(&F);
+    switch(lineno){
+        case 4: // full epoch
+            CHECK("updated", F.updated, NMEA_RMC | NMEA_GGA | NMEA_GSA | NMEA_ZDA);
+            CHECK("lat", F.lat, 436765668);
+            CHECK("lon", F.lon, 414579240);
+            CHECK("alt", F.alt, 207940);
+            CHECK("speed", F.speed, 1224);
+            CHECK("fixtype", F.fixtype, 3);
+            CHECK("quality", F.quality, 1);
+            CHECK("sats", F.sats, 7);
+            CHECK("pdop", F.pdop, 231);
+            CHECK("hdop", F.hdop, 132);
+            CHECK("vdop", F.vdop, 189);
+            CHECK("day", F.day, 29);
+            CHECK("month", F.month, 6);
+            CHECK("year", F.year, 2015);
+            CHECK("S", F.S, 56);
+        break;
+        case 5: // new epoch
+            CHECK("updated", F.updated, NMEA_RMC);
+            CHECK("lat", F.lat, 436765692);
+            CHECK("valid", F.valid, 1);
+        break;
+        case 12: // bad checksum, broken & proprietary sentences
+            CHECK("lat", F.lat, 436765692);
+            CHECK("S", F.S, 57);
+        break;
+        case 13:
+            CHECK("valid", F.valid, 0);
+            CHECK("timeok", F.timeok, 1);
+        break;
+        case 16:
+            CHECK("timeok", F.timeok, 0);
+        break;
+        case 17:
+            CHECK("lat", F.lat, -338520575);
+            CHECK("lon", F.lon, -1512090535);
+            CHECK("course", F.course, 12345);
+            CHECK("speed", F.speed, 8);
+            CHECK("ms", F.ms, 250);
+            CHECK("year", F.year, 2020);
+        break;
+        case 18:
+            CHECK("alt", F.alt, -1230);
+            CHECK("quality", F.quality, 2);
+            CHECK("sats", F.sats, 12);
+            CHECK("hdop", F.hdop, 80);
+        break;
+    }
+}
+
+// check values after given line of stream (MTK receiver: cold start, no fix, first fixes)
+static void check_stream(int lineno){
+    nmea_fix F;
+    nmea_get(&F);
+    switch(lineno){
+        case 6: // RMC without time & position
+            CHECK("valid", F.valid, 0);
+            CHECK("timeok", F.timeok, 1);
+            CHECK("ms", F.ms, 800);
+            CHECK("quality", F.quality, 0);
+            CHECK("fixtype", F.fixtype, 1);
+            CHECK("lat", F.lat, 0);
+        break;
+        case 13: // time is known, no fix
+            CHECK("valid", F.valid, 0);
+            CHECK("S", F.S, 0);
+            CHECK("sats", F.sats, 3);
+            CHECK("lat", F.lat, 0);
+            CHECK("day", F.day, 15);
+            CHECK("year", F.year, 2019);
+        break;
+        case 20: // first fix
+            CHECK("updated", F.updated, NMEA_RMC | NMEA_GGA | NMEA_GSA);
+            CHECK("valid", F.valid, 1);
+            CHECK("lat", F.lat, 436822817);
+            CHECK("lon", F.lon, 414583900);
+            CHECK("alt", F.alt, 112530);
+            CHECK("quality", F.quality, 1);
+            CHECK("sats", F.sats, 5);
+            CHECK("fixtype", F.fixtype, 3);
+            CHECK("pdop", F.pdop, 205);
+            CHECK("hdop", F.hdop, 171);
+            CHECK("vdop", F.vdop, 113);
+            CHECK("course", F.course, 3326);
+            CHECK("speed", F.speed, 0);
+        break;
+        case 26: // GGA is broken, GSA goes before RMC of new second
+            CHECK("updated", F.updated, NMEA_RMC);
+            CHECK("S", F.S, 2);
+            CHECK("lat", F.lat, 436822833);
+            CHECK("lon", F.lon, 414583917);
+            CHECK("alt", F.alt, 112530);
+            CHECK("pdop", F.pdop, 206);
+            CHECK("speed", F.speed, 62);
+        break;
+    }
+}
+
+/**
+ * feed file byte by byte, check after each line
+ * @return amount of errors
+ */
+static int check(const char *name, void (*chk)(int), uint32_t good, uint32_t badsum, uint32_t broken){
+    size_t len;
+    char *buf = readfile(name, &len), *p = buf, *e = buf + len;
+    int lineno = 0, err0 = errors;
+    nmea_stat st;
+    printf("%s\n", name);
+    nmea_init();
+    while(p < e){
+        nmea_putc(*p);
+        if(*p++ == '\n') chk(++lineno);
+    }
+    nmea_getstat(&st);
+    CHECK("good", st.good, good);
+    CHECK("badsum", st.badsum, badsum);
+    CHECK("broken", st.broken, broken);
+    free(buf);
+    return errors - err0;
+}
+
+static void bench(int N){
+    size_t len;
+    char *buf = readfile(SAMPLE, &len);
+    struct timespec t0, t1;
+    nmea_stat st;
+    nmea_init();
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for(int i = 0; i < N; ++i) nmea_feed((uint8_t*)buf, len);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    nmea_getstat(&st);
+    double t = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    printf("%d passes, %.1f MB/s, %.0f sentences/s, %.1f ns per byte\n", N,
+        len * (double)N / t / 1e6, (st.good + st.badsum + st.broken) / t, t * 1e9 / len / N);
+}
+
+int main(int argc, char **argv){
+    if(argc > 1 && !strcmp(argv[1], "-b")){
+        bench(argc > 2 ? atoi(argv[2]) : 10000);
+        return 0;
+    }
+    if(argc > 1){
+        size_t len;
+        char *buf = readfile(argv[1], &len);
+        nmea_init();
+        nmea_feed((uint8_t*)buf, len);
+        printfix();
+        free(buf);
+        return 0;
+    }
+    check(SAMPLE, check_line, 16, 1, 1);
+    check(STREAM, check_stream, 26, 1, 1);
+    if(errors) printf("%d errors\n", errors);
+    else printf("All OK\n");
+    return errors ? 1 : 0;
+}
@@ -214,32 +214,22 @@ UART_buff *get_uart_buffer(uint32_t UART){
 
 
 /**
- * Check whether UART2 have a full text line
- * @return string with data if data ready or NULL
+ * Get next byte received by UART2
+ * @param byte - place for it
+ * @return 0 if buffer is empty
  */
-uint8_t *check_UART2(){
-	static int oldlen = 0;
-	static uint8_t buf[UART_BUF_DATA_SIZE+1];
+int read_UART2(uint8_t *byte){
 	UART_buff *curbuff = &RX_buffer[1];
-	uint8_t datalen = curbuff->end; // length of data in buffer - here we use param "end"
-	if(!datalen) return NULL; // buffer is empty
-	if(oldlen != datalen){
-		if(curbuff->buf[curbuff->end-1] != '\n'){ // string not full
-			oldlen = datalen;
-			return NULL;
-		}else{ // full string - copy it to buffer & clear indexes
-			memcpy(buf, curbuff->buf, datalen);
-			buf[datalen] = 0;
-			oldlen = curbuff->end = 0;
-			return buf;
-		}
-	}
-	return NULL;
+	uint8_t start = curbuff->start;
+	if(start == *(volatile uint8_t*)&curbuff->end) return 0; // `end` is changed by ISR
+	*byte = curbuff->buf[start];
+	if(++start == UART_BUF_DATA_SIZE) start = 0;
+	curbuff->start = start;
+	return 1;
 }
 
 /**
- * Fill data in RX buffer to prepare it for further work
- * we don't use "start" parameter here, it's 0 always
+ * Fill data in RX ring buffer: `end` is moved by interrupt, `start` - by reader
  * @param UART - device to fill buffer
  * @param byte - data byte
  */
@@ -257,9 +247,9 @@ void fill_uart_RXbuff(uint32_t UART, uint8_t byte){
 			return;
 	}
 	curbuff = &RX_buffer[bufidx];
-	if(curbuff->end == UART_BUF_DATA_SIZE){ // end of buffer - forget about data
-		curbuff->end = 0;
-		return;
-	}
-	curbuff->buf[curbuff->end++] = byte; // put byte into buffer
+	bufidx = curbuff->end + 1;
+	if(bufidx == UART_BUF_DATA_SIZE) bufidx = 0;
+	if(bufidx == curbuff->start) return; // overflow - forget about new data
+	curbuff->buf[curbuff->end] = byte; // put byte into buffer
+	curbuff->end = bufidx;
 }
@@ -39,7 +39,7 @@ void fill_uart_buff(uint32_t UART, uint8_t byte);
 void uart1_send(uint8_t byte);
 void uart2_send(uint8_t byte);
 
-uint8_t *check_UART2();
+int read_UART2(uint8_t *byte);
 
 UART_buff *get_uart_buffer(uint32_t UART);
 
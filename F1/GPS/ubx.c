@@ -0,0 +1,336 @@
+/*
+ * ubx.c - u-blox binary protocol
+ *
+ * Copyright 2015 Edward V. Emelianov <eddy@sao.ru, edward.emelianoff@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/*
+ * Frame: 0xB5 0x62 class id length(LE16) payload ck_a ck_b,
+ * 8-bit Fletcher checksum is calculated over class..payload.
+ * Frames are parsed byte by byte like NMEA sentences: NAV-PVT gives the same
+ * fixed point fix as NMEA parser, TIM-TP (sent before pulse it describes) is
+ * held until next PPS interrupt, which tags it with local time.
+ */
+
+#include <string.h>
+#include "ubx.h"
+#include "nmea.h"
+
+typedef enum{
+	ST_SYNC1,
+	ST_SYNC2,
+	ST_CLASS,
+	ST_ID,
+	ST_LEN1,
+	ST_LEN2,
+	ST_PAYLOAD,
+	ST_CKA,
+	ST_CKB
+} ubx_state;
+
+static ubx_state state = ST_SYNC1;
+static uint8_t cka, ckb;                   // Fletcher checksum
+static uint16_t rxmsg, rxlen, rxpos;       // current message, its length & position
+static uint8_t rxbuf[UBX_MAX_PAYLOAD];
+static ubx_stat stat;
+
+// TIM-TP waiting for its pulse
+static volatile uint8_t tp_ready = 0;
+static uint32_t tp_rxms;                   // local time of TIM-TP receiving
+static ubx_pps tp_next;
+// last tagged pulse
+static ubx_pps tp_last;
+static volatile uint32_t tpseq = 0;        // odd while `tp_last` is changing
+
+static uint16_t get_u2(const uint8_t *p){
+	return p[0] | (p[1] << 8);
+}
+
+static uint32_t get_u4(const uint8_t *p){
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void put_u2(uint8_t *p, uint16_t v){
+	p[0] = v; p[1] = v >> 8;
+}
+
+static void put_u4(uint8_t *p, uint32_t v){
+	p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+static void cksum(uint8_t c){
+	cka += c;
+	ckb += cka;
+}
+
+/*
+ * NAV-PVT: iTOW(0), year(4), month, day, hour, min, sec, valid(11), tAcc(12), nano(16),
+ * fixType(20), flags(21), numSV(23), lon(24), lat(28), height(32), hMSL(36), hAcc, vAcc,
+ * velN(48), velE, velD, gSpeed(60), headMot(64), sAcc, headAcc, pDOP(76)
+ */
+static void nav_pvt(){
+	nmea_fix fix;
+	uint8_t ftype, flags;
+	if(rxlen < 78) return;
+	ftype = rxbuf[20];
+	flags = rxbuf[21];
+	memset(&fix, 0, sizeof(fix));
+	fix.valid = flags & 1; // gnssFixOK
+	fix.quality = fix.valid ? ((flags & 2) ? 2 : 1) : 0; // diffSoln
+	if(ftype == 2) fix.fixtype = 2;
+	else if(ftype == 3 || ftype == 4) fix.fixtype = 3;
+	else fix.fixtype = 1;
+	fix.sats = rxbuf[23];
+	fix.timeok = (rxbuf[11] & 2) ? 1 : 0; // validTime
+	fix.H = rxbuf[8]; fix.M = rxbuf[9]; fix.S = rxbuf[10];
+	fix.ms = get_u4(rxbuf) % 1000; // leap seconds are integer, so UTC & GPS ms are the same
+	if(rxbuf[11] & 1){ // validDate
+		fix.year = get_u2(rxbuf + 4);
+		fix.month = rxbuf[6]; fix.day = rxbuf[7];
+	}
+	fix.lon = get_u4(rxbuf + 24);
+	fix.lat = get_u4(rxbuf + 28);
+	fix.alt = (int32_t)get_u4(rxbuf + 36) / 10;
+	fix.speed = get_u4(rxbuf + 60);
+	fix.course = (int32_t)get_u4(rxbuf + 64) / 1000;
+	fix.pdop = get_u2(rxbuf + 76);
+	fix.hdop = fix.vdop = 9999; // unknown
+	nmea_publish(&fix, NMEA_PVT);
+}
+
+/*
+ * TIM-TP: towMS(0), towSubMS(4), qErr(8), week(12), flags(14), refInfo(15)
+ */
+static void tim_tp(uint32_t ms){
+	if(rxlen < 16) return;
+	tp_ready = 0;
+	__sync_synchronize();
+	tp_next.towMS = get_u4(rxbuf);
+	tp_next.towSubMS = get_u4(rxbuf + 4);
+	tp_next.qErr = get_u4(rxbuf + 8);
+	tp_next.week = get_u2(rxbuf + 12);
+	tp_next.flags = rxbuf[14];
+	tp_rxms = ms;
+	__sync_synchronize();
+	tp_ready = 1;
+}
+
+// full message received
+static void process(uint32_t ms){
+	switch(rxmsg){
+		case UBX_NAV_PVT: nav_pvt(); break;
+		case UBX_TIM_TP: tim_tp(ms); break;
+		case UBX_ACK_ACK: ++stat.acks; break;
+		case UBX_ACK_NAK: ++stat.naks; break;
+	}
+}
+
+/**
+ * Clear parser state & statistics
+ */
+void ubx_init(){
+	state = ST_SYNC1;
+	tp_ready = 0;
+	memset(&stat, 0, sizeof(stat));
+}
+
+/**
+ * @return 1 if parser is inside of frame (so next byte is UBX data, not NMEA)
+ */
+uint8_t ubx_busy(){
+	return state != ST_SYNC1;
+}
+
+/**
+ * @return 1 if only first sync byte was received (it could be part of NMEA text)
+ */
+uint8_t ubx_sync1(){
+	return state == ST_SYNC2;
+}
+
+/**
+ * Process next byte of UBX stream
+ * @param c  - byte
+ * @param ms - local millisecond counter (for time pulse tagging)
+ * @return UBX_MSG(class, id) of received message or 0
+ */
+uint16_t ubx_putc(uint8_t c, uint32_t ms){
+	switch(state){
+		case ST_SYNC1:
+			if(c == UBX_SYNC1) state = ST_SYNC2;
+		break;
+		case ST_SYNC2:
+			state = (c == UBX_SYNC2) ? ST_CLASS : ST_SYNC1;
+			cka = ckb = 0;
+		break;
+		case ST_CLASS:
+			cksum(c);
+			rxmsg = c << 8;
+			state = ST_ID;
+		break;
+		case ST_ID:
+			cksum(c);
+			rxmsg |= c;
+			state = ST_LEN1;
+		break;
+		case ST_LEN1:
+			cksum(c);
+			rxlen = c;
+			state = ST_LEN2;
+		break;
+		case ST_LEN2:
+			cksum(c);
+			rxlen |= c << 8;
+			rxpos = 0;
+			state = rxlen ? ST_PAYLOAD : ST_CKA;
+		break;
+		case ST_PAYLOAD:
+			cksum(c);
+			if(rxpos < UBX_MAX_PAYLOAD) rxbuf[rxpos] = c;
+			if(++rxpos == rxlen) state = ST_CKA;
+		break;
+		case ST_CKA:
+			if(c != cka){
+				++stat.badsum;
+				state = ST_SYNC1;
+			}else state = ST_CKB;
+		break;
+		case ST_CKB:
+			state = ST_SYNC1;
+			if(c != ckb){
+				++stat.badsum;
+				break;
+			}
+			++stat.good;
+			if(rxlen > UBX_MAX_PAYLOAD) break; // we don't need such long messages
+			process(ms);
+			return rxmsg;
+		break;
+	}
+	return 0;
+}
+
+/**
+ * Make UBX frame
+ * @param frame   - buffer for frame (len + UBX_OVERHEAD bytes)
+ * @param msg     - UBX_MSG(class, id)
+ * @param payload - message payload (could be NULL if len == 0)
+ * @param len     - its length
+ * @return length of frame
+ */
+uint16_t ubx_pack(uint8_t *frame, uint16_t msg, const uint8_t *payload, uint16_t len){
+	uint8_t a = 0, b = 0;
+	uint16_t i, n = len + 4;
+	frame[0] = UBX_SYNC1;
+	frame[1] = UBX_SYNC2;
+	frame[2] = msg >> 8;
+	frame[3] = msg;
+	put_u2(frame + 4, len);
+	if(len) memcpy(frame + 6, payload, len);
+	for(i = 2; i < n + 2; ++i){
+		a += frame[i];
+		b += a;
+	}
+	frame[len + 6] = a;
+	frame[len + 7] = b;
+	return len + UBX_OVERHEAD;
+}
+
+/**
+ * CFG-MSG: set rate of message on current port
+ * @param frame - buffer for 11 bytes
+ * @param msg   - UBX_MSG(class, id)
+ * @param rate  - once per `rate` navigation solutions, 0 to disable
+ */
+uint16_t ubx_cfg_msg(uint8_t *frame, uint16_t msg, uint8_t rate){
+	uint8_t p[3] = {msg >> 8, msg, rate};
+	return ubx_pack(frame, UBX_CFG_MSG, p, 3);
+}
+
+/**
+ * CFG-RATE: navigation solution each `period` ms aligned to UTC
+ * @param frame - buffer for 14 bytes
+ */
+uint16_t ubx_cfg_rate(uint8_t *frame, uint16_t period){
+	uint8_t p[6];
+	put_u2(p, period); // measRate
+	put_u2(p + 2, 1);  // navRate: each measurement
+	put_u2(p + 4, 0);  // timeRef: UTC
+	return ubx_pack(frame, UBX_CFG_RATE, p, 6);
+}
+
+/**
+ * CFG-TP5: TIMEPULSE rising edge aligned to UTC second; there's no pulses until
+ * receiver gets time
+ * @param frame  - buffer for 40 bytes
+ * @param period - pulse period, us
+ * @param len    - pulse length, us
+ */
+uint16_t ubx_cfg_tp5(uint8_t *frame, uint32_t period, uint32_t len){
+	uint8_t p[32];
+	memset(p, 0, sizeof(p)); // TIMEPULSE, version 0, no cable & user delays
+	put_u4(p + 8, period);   // freqPeriod
+	put_u4(p + 12, period);  // freqPeriodLock
+	put_u4(p + 16, 0);       // pulseLenRatio: no pulses while not locked
+	put_u4(p + 20, len);     // pulseLenRatioLock
+	// active, lockGpsFreq, lockedOtherSet, isLength, alignToTow, polarity (rising), UTC grid
+	put_u4(p + 28, 0x01 | 0x02 | 0x04 | 0x10 | 0x20 | 0x40);
+	return ubx_pack(frame, UBX_CFG_TP5, p, 32);
+}
+
+/**
+ * Tag time pulse with data of last TIM-TP, should be called from PPS interrupt
+ * @param ms    - local millisecond counter
+ * @param ticks - SysTick ticks passed from start of current millisecond
+ */
+void ubx_pps_event(uint32_t ms, uint32_t ticks){
+	uint8_t have = tp_ready && (ms - tp_rxms) < UBX_TP_MAXAGE;
+	uint32_t seq = tp_last.seq + 1;
+	++tpseq;
+	__sync_synchronize();
+	if(have) tp_last = tp_next;
+	tp_last.havetp = have;
+	tp_last.ms = ms;
+	tp_last.ticks = ticks;
+	tp_last.seq = seq;
+	__sync_synchronize();
+	++tpseq;
+	tp_ready = 0; // each TIM-TP describes only one pulse
+}
+
+/**
+ * Get copy of last tagged pulse
+ * @return its number
+ */
+uint32_t ubx_get_pps(ubx_pps *pps){
+	uint32_t s;
+	do{
+		s = tpseq;
+		__sync_synchronize();
+		*pps = tp_last;
+		__sync_synchronize();
+	}while((s & 1) || s != tpseq);
+	return pps->seq;
+}
+
+/**
+ * Get parser statistics
+ */
+void ubx_getstat(ubx_stat *st){
+	*st = stat;
+}
@@ -0,0 +1,96 @@
+/*
+ * ubx.h - u-blox binary protocol
+ *
+ * Copyright 2015 Edward V. Emelianov <eddy@sao.ru, edward.emelianoff@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#pragma once
+#ifndef __UBX_H__
+#define __UBX_H__
+
+#include <stdint.h>
+
+#define UBX_SYNC1        (0xB5)
+#define UBX_SYNC2        (0x62)
+// longest message we need (NAV-PVT); longer are checked but not stored
+#define UBX_MAX_PAYLOAD  (100)
+// sync, class, id, length & checksum
+#define UBX_OVERHEAD     (8)
+
+// classes
+#define UBX_NAV          (0x01)
+#define UBX_ACK          (0x05)
+#define UBX_CFG          (0x06)
+#define UBX_TIM          (0x0D)
+#define UBX_NMEA         (0xF0)
+// message = class << 8 | id
+#define UBX_MSG(c, i)    (((c) << 8) | (i))
+#define UBX_NAV_PVT      UBX_MSG(UBX_NAV, 0x07)
+#define UBX_ACK_NAK      UBX_MSG(UBX_ACK, 0x00)
+#define UBX_ACK_ACK      UBX_MSG(UBX_ACK, 0x01)
+#define UBX_CFG_MSG      UBX_MSG(UBX_CFG, 0x01)
+#define UBX_CFG_RATE     UBX_MSG(UBX_CFG, 0x08)
+#define UBX_CFG_TP5      UBX_MSG(UBX_CFG, 0x31)
+#define UBX_TIM_TP       UBX_MSG(UBX_TIM, 0x01)
+// NMEA sentences IDs for CFG-MSG
+#define UBX_NMEA_GGA     UBX_MSG(UBX_NMEA, 0x00)
+#define UBX_NMEA_GLL     UBX_MSG(UBX_NMEA, 0x01)
+#define UBX_NMEA_GSA     UBX_MSG(UBX_NMEA, 0x02)
+#define UBX_NMEA_GSV     UBX_MSG(UBX_NMEA, 0x03)
+#define UBX_NMEA_RMC     UBX_MSG(UBX_NMEA, 0x04)
+#define UBX_NMEA_VTG     UBX_MSG(UBX_NMEA, 0x05)
+#define UBX_NMEA_ZDA     UBX_MSG(UBX_NMEA, 0x08)
+
+// TIM-TP arrived earlier than this before PPS describes other pulse
+#define UBX_TP_MAXAGE    (1000)
+
+// time pulse tagged by PPS interrupt
+typedef struct{
+	uint8_t havetp;     // there was TIM-TP for this pulse
+	uint8_t flags;      // TIM-TP flags: bit0 - UTC time base, bit1 - UTC available
+	uint16_t week;      // GPS week
+	uint32_t towMS;     // time of week of pulse, ms
+	uint32_t towSubMS;  // its fraction, 2^-32 ms
+	int32_t qErr;       // quantization error of pulse (real pulse = tow + qErr), ps
+	uint32_t ms;        // local millisecond counter on pulse
+	uint32_t ticks;     // SysTick ticks passed from start of that millisecond
+	uint32_t seq;       // number of pulse
+} ubx_pps;
+
+typedef struct{
+	uint32_t good;      // messages with right checksum
+	uint32_t badsum;    // messages with wrong checksum
+	uint32_t acks;      // ACK-ACK
+	uint32_t naks;      // ACK-NAK
+} ubx_stat;
+
+void ubx_init();
+uint8_t ubx_busy();
+uint8_t ubx_sync1();
+uint16_t ubx_putc(uint8_t c, uint32_t ms);
+
+uint16_t ubx_pack(uint8_t *frame, uint16_t msg, const uint8_t *payload, uint16_t len);
+uint16_t ubx_cfg_msg(uint8_t *frame, uint16_t msg, uint8_t rate);
+uint16_t ubx_cfg_rate(uint8_t *frame, uint16_t period);
+uint16_t ubx_cfg_tp5(uint8_t *frame, uint32_t period, uint32_t len);
+
+void ubx_pps_event(uint32_t ms, uint32_t ticks);
+uint32_t ubx_get_pps(ubx_pps *pps);
+void ubx_getstat(ubx_stat *st);
+
+#endif // __UBX_H__
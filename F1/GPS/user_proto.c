@@ -23,6 +23,8 @@
 #include "main.h"
 #include "hardware_ini.h"
 #include "GPS.h"
+#include "nmea.h"
+#include "ubx.h"
 
 // integer value given by user
 static volatile int32_t User_value = 0;
@@ -41,12 +43,92 @@ intfun I = NULL; // function to process entered integer
 
 void help(){
 	P("C\tclear SysTick on PPS\n");
+	P("E\tturn on/off echo of NMEA sentences\n");
+	P("F\tshow last fix\n");
 	P("H\tshow this help\n");
 //	P("I\ttest entering integer value\n");
+	P("P\tshow last time pulse\n");
 	P("S\tSend GPS starting sequence\n");
 	P("T\tshow current approx. time\n");
 }
 
+// print fixed point value with ndec digits after point
+static void print_fixp(int32_t v, uint8_t ndec){
+	int32_t d = 1;
+	uint8_t i;
+	for(i = 0; i < ndec; ++i) d *= 10;
+	if(v < 0){
+		usb_send('-');
+		v = -v;
+	}
+	print_int(v / d);
+	usb_send('.');
+	v %= d;
+	for(d /= 10; d > v && d > 1; d /= 10) usb_send('0');
+	print_int(v);
+}
+
+/**
+ * show last fix of NMEA parser
+ */
+static void print_fix(){
+	nmea_fix fix;
+	nmea_stat st;
+	ubx_stat ust;
+	nmea_get(&fix);
+	nmea_getstat(&st);
+	ubx_getstat(&ust);
+	newline();
+	P("Lat: "); print_fixp(fix.lat, 7);
+	P(", lon: "); print_fixp(fix.lon, 7);
+	P(", alt: "); print_fixp(fix.alt, 2);
+	P("m\nSpeed: "); print_fixp(fix.speed, 3);
+	P("m/s, course: "); print_fixp(fix.course, 2);
+	P("\nFix: "); print_int(fix.fixtype);
+	P("D, quality: "); print_int(fix.quality);
+	P(", sats: "); print_int(fix.sats);
+	P(", PDOP: "); print_fixp(fix.pdop, 2);
+	P(", HDOP: "); print_fixp(fix.hdop, 2);
+	P(", VDOP: "); print_fixp(fix.vdop, 2);
+	P("\nDate: "); print_int(fix.day); usb_send('/');
+	print_int(fix.month); usb_send('/'); print_int(fix.year);
+	if(!fix.valid) P(" (not valid)");
+	P("\nSentences: "); print_int(st.good);
+	P(" good, "); print_int(st.badsum);
+	P(" bad checksum, "); print_int(st.broken);
+	P(" broken\nUBX: "); print_int(ust.good);
+	P(" good, "); print_int(ust.badsum);
+	P(" bad checksum, "); print_int(ust.acks);
+	P(" ACK, "); print_int(ust.naks);
+	P(" NAK\n");
+}
+
+/**
+ * show last time pulse tagged by TIM-TP
+ */
+static void print_pps(){
+	ubx_pps pps;
+	if(!ubx_get_pps(&pps)){
+		P("\nNo pulses\n");
+		return;
+	}
+	P("\nPulse "); print_int(pps.seq);
+	P(" at "); print_int(pps.ms);
+	P("ms + "); print_int(pps.ticks);
+	P(" ticks");
+	if(!pps.havetp){
+		P(" (no TIM-TP)\n");
+		return;
+	}
+	P("\nWeek "); print_int(pps.week);
+	P(", TOW: "); print_fixp(pps.towMS, 3);
+	P("s + "); print_int((uint32_t)(((uint64_t)pps.towSubMS * 1000000) >> 32));
+	P("ns, qErr: "); print_int(pps.qErr);
+	P("ps");
+	if(pps.flags & 1) P(", UTC");
+	newline();
+}
+
 /**
  * show entered integer value
  */
@@ -81,6 +163,12 @@ int parse_incoming_buf(char *buf, int len){
 			case 'C':
 				clear_ST_on_connect = 1;
 			break;
+			case 'E':
+				GPS_echo = !GPS_echo;
+			break;
+			case 'F':
+				print_fix();
+			break;
 			case 'H': // show help
 				help();
 			break;
@@ -88,6 +176,9 @@ int parse_incoming_buf(char *buf, int len){
 				I = show_int;
 				READINT();
 			break;*/
+			case 'P':
+				print_pps();
+			break;
 			case 'S':
 				GPS_send_start_seq();
 			break;
@@ -43,9 +43,9 @@ void GPIO_init(){
     // LEDS: opendrain output
     gpio_set_mode(LEDS_PORT, GPIO_MODE_OUTPUT_2_MHZ, GPIO_CNF_OUTPUT_OPENDRAIN,
             LED_LOW_PIN | LED_UPPER_PIN);
-    // Tacting output (push-pull)
+    // Tacting outputs (push-pull)
     gpio_set_mode(OUTP_PORT, GPIO_MODE_OUTPUT_50_MHZ, GPIO_CNF_OUTPUT_PUSHPULL,
-            OUTP_PIN);
+            OUTP_PIN | OUTP_INV_PIN | CAM_PIN);
 /*
     // USB_DISC: push-pull
     gpio_set_mode(USB_DISC_PORT, GPIO_MODE_OUTPUT_2_MHZ,
@@ -26,6 +26,7 @@
 /*
  * Timers:
  * SysTick - system time
+ * TIM2 - waveform generator (DMA1 channels 2 & 5)
  */
 
 
@@ -42,10 +43,13 @@ void SysTick_init();
 #define BTN_MINUS_PIN      GPIO9
 
 /*
- * Tacting out - PA4
+ * Tacting outs - PA4 (crankshaft), PA5 (inverted crankshaft), PA6 (camshaft)
+ * all should be on the same port: they're changed at once by DMA
  */
 #define OUTP_PORT       GPIOA
 #define OUTP_PIN        GPIO4
+#define OUTP_INV_PIN    GPIO5
+#define CAM_PIN         GPIO6
 
 /*
  * LEDS: PA0 for bottom, PA1 for upper limits
@@ -34,7 +34,7 @@
 #include <libopencm3/cm3/systick.h>
 #include <libopencm3/stm32/rcc.h>
 #include <libopencm3/stm32/adc.h>
-//#include <libopencm3/stm32/dma.h>
+#include <libopencm3/stm32/dma.h>
 #include <libopencm3/stm32/timer.h>
 
 #define ADC_CHANNELS_NUMBER    (10)
@@ -22,96 +22,230 @@
 #include "timer.h"
 #include "user_proto.h" // for print_int
 
+/*
+ * Generator engine: waveform of all outputs for 720 degrees (crank & cam cycle)
+ * is precomputed as BSRR words, TIM2 update requests make DMA1 channel 2 write
+ * them to GPIOA_BSRR one per half of tooth period. So all outputs are always
+ * synchronized and no CPU time is needed at any speed.
+ * Speed changes: TIM2_CH1 compare event (CCR1 = 0, i.e. at each update) makes
+ * DMA1 channel 5 write next ARR value from circular ramp buffer; half/complete
+ * interrupts refill it while RPM changes, then the channel is turned off.
+ */
+
 // current speed
 uint16_t current_RPM = 0;
-void get_RPM();
-uint16_t get_ARR(uint32_t RPM);
 
 // pulses: 16 1/0, 4 1/1, 16 1/0, 4 0/0,
-const uint8_t pulses[] = {
+static const uint8_t pulses[] = {
     1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,
     1,1,1,1,1,1,1,1,
     1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,
     0,0,0,0,0,0,0,0};
-const int pulsesLen = sizeof(pulses) - 1;
+
+static const gen_pattern patterns[] = {
+    {"jeep", 40, 0, 0, 0, pulses},
+    // cam: one tooth long window at 90 degrees of second revolution
+    {"36-1", 36, 1, 45, 54, NULL},
+    {"60-2", 60, 2, 75, 90, NULL},
+};
+#define PATTERNS_AMOUNT  (sizeof(patterns) / sizeof(gen_pattern))
+
+static uint32_t wave[GEN_MAX_STEPS];      // BSRR words for 720 degrees
+static uint16_t wave_len;                 // its length
+static uint16_t ramp[GEN_RAMP_LEN];       // ARR values
+static uint8_t cur_pattern = 0;
+static uint32_t K;                        // ARR+1 = K / RPM
+static volatile uint32_t rpm_fp;          // current speed, 1/256 rpm
+static volatile uint32_t target_fp;       // target speed, 1/256 rpm
+static uint32_t ramp_acc;                 // remainder of speed increment
+static volatile uint8_t ramping = 0;      // DMA1 channel 5 is on
+static uint8_t const_halves;              // amount of halves with constant speed
+static uint8_t sweep = 0;                 // continuous sweep between MIN & MAX
+uint16_t ramp_rate = GEN_RAMP_RATE;       // rpm per second
+
+// fill wave buffer by pattern
+static void build_wave(const gen_pattern *p){
+    uint16_t steps = 2 * p->teeth, i;
+    for(i = 0; i < 2 * steps; ++i){ // two revolutions
+        uint16_t h = i % steps, tooth = h / 2;
+        uint8_t crank, cam;
+        if(p->levels) crank = p->levels[h];
+        else crank = !(h & 1) && tooth < p->teeth - p->missing;
+        cam = (i / 2 >= p->cam_on && i / 2 < p->cam_off);
+        wave[i] = (crank ? OUTP_PIN | (OUTP_INV_PIN << 16) : (OUTP_PIN << 16) | OUTP_INV_PIN)
+                | (cam ? CAM_PIN : CAM_PIN << 16);
+    }
+    wave_len = 2 * steps;
+    K = GEN_TICK * 60 / steps;
+}
+
+// next ARR value of ramp
+static uint16_t ramp_next(){
+    uint32_t arr = (K << 8) / rpm_fp, d; // ARR+1
+    if(rpm_fp != target_fp){
+        // speed increment for this step: rate * step time
+        ramp_acc += ramp_rate * arr;
+        d = ramp_acc / (GEN_TICK >> 8);
+        ramp_acc %= (GEN_TICK >> 8);
+        if(rpm_fp < target_fp){
+            rpm_fp += d;
+            if(rpm_fp > target_fp) rpm_fp = target_fp;
+        }else{
+            if(rpm_fp - target_fp < d) rpm_fp = target_fp;
+            else rpm_fp -= d;
+        }
+        if(rpm_fp == target_fp && sweep)
+            target_fp = (target_fp == MAX_RPM << 8) ? MIN_RPM << 8 : MAX_RPM << 8;
+    }
+    return (uint16_t)(arr - 1);
+}
+
+// fill n values of ramp buffer from idx; return 1 if speed is constant
+static uint8_t ramp_fill(uint16_t idx, uint16_t n){
+    uint8_t c = (rpm_fp == target_fp);
+    while(n--) ramp[idx++] = ramp_next();
+    return c;
+}
+
+// turn on ARR DMA ramp
+static void ramp_start(){
+    nvic_disable_irq(NVIC_DMA1_CHANNEL5_IRQ);
+    if(!ramping){
+        ramp_acc = 0;
+        const_halves = 0;
+        ramp_fill(0, GEN_RAMP_LEN);
+        DMA1_CCR5 &= ~DMA_CCR_EN;
+        DMA1_CNDTR5 = GEN_RAMP_LEN;
+        DMA1_IFCR = DMA_IFCR_CGIF5;
+        DMA1_CCR5 |= DMA_CCR_EN;
+        TIM2_DIER |= TIM_DIER_CC1DE;
+        ramping = 1;
+    }
+    nvic_enable_irq(NVIC_DMA1_CHANNEL5_IRQ);
+}
+
+// turn off ARR DMA ramp (IRQ first, so ISR can't re-arm it)
+static void ramp_stop(){
+    nvic_disable_irq(NVIC_DMA1_CHANNEL5_IRQ);
+    TIM2_DIER &= ~TIM_DIER_CC1DE;
+    DMA1_CCR5 &= ~DMA_CCR_EN;
+    DMA1_IFCR = DMA_IFCR_CGIF5;
+    nvic_clear_pending_irq(NVIC_DMA1_CHANNEL5_IRQ);
+    ramping = 0;
+}
+
+void dma1_channel5_isr(){
+    uint16_t idx;
+    if(DMA1_ISR & DMA_ISR_HTIF5){
+        DMA1_IFCR = DMA_IFCR_CHTIF5;
+        idx = 0;
+    }else if(DMA1_ISR & DMA_ISR_TCIF5){
+        DMA1_IFCR = DMA_IFCR_CTCIF5;
+        idx = GEN_RAMP_LEN / 2;
+    }else return;
+    current_RPM = rpm_fp >> 8;
+    // all values in buffer are the same: ramp is over
+    if(const_halves > 1){
+        ramp_stop();
+        return;
+    }
+    if(ramp_fill(idx, GEN_RAMP_LEN / 2)) ++const_halves;
+    else const_halves = 0;
+}
+
+// (re)start waveform output with current pattern & speed
+static void gen_start(){
+    uint8_t wasramping;
+    TIM2_CR1 &= ~TIM_CR1_CEN;
+    nvic_disable_irq(NVIC_DMA1_CHANNEL5_IRQ);
+    wasramping = ramping;
+    ramp_stop();
+    DMA1_CCR2 &= ~DMA_CCR_EN;
+    build_wave(&patterns[cur_pattern]);
+    DMA1_CNDTR2 = wave_len;
+    DMA1_CCR2 |= DMA_CCR_EN;
+    TIM2_ARR = (K << 8) / rpm_fp - 1;
+    TIM2_CNT = 0;
+    TIM2_EGR = TIM_EGR_UG;
+    if(wasramping) ramp_start();
+    TIM2_CR1 |= TIM_CR1_CEN;
+}
 
 void tim2_init(){
     // init TIM2
     rcc_periph_clock_enable(RCC_TIM2);
+    rcc_periph_clock_enable(RCC_DMA1);
     timer_reset(TIM2);
-    // timer have frequency of 1MHz
     timer_set_mode(TIM2, TIM_CR1_CKD_CK_INT, TIM_CR1_CMS_EDGE, TIM_CR1_DIR_UP);
-    // 72MHz div 36 = 2MHz
-    TIM2_PSC = 35;  // we need double freq to serve both halfs of signal
-    TIM2_ARR = get_ARR(MIN_RPM);
-    TIM2_DIER = TIM_DIER_UDE | TIM_DIER_UIE;
-    nvic_enable_irq(NVIC_TIM2_IRQ);
-    TIM2_CR1 |= TIM_CR1_CEN;
-    get_RPM();
+    // 72MHz div 9 = 8MHz
+    TIM2_PSC = 72000000 / GEN_TICK - 1;
+    TIM2_CR1 = TIM_CR1_ARPE; // new ARR from ramp works since next period
+    TIM2_CCR1 = 0; // CC1 event at each update
+    // TIM2_UP: DMA1 channel 2, wave -> BSRR
+    dma_channel_reset(DMA1, DMA_CHANNEL2);
+    DMA1_CPAR2 = (uint32_t) &GPIO_BSRR(OUTP_PORT);
+    DMA1_CMAR2 = (uint32_t) wave;
+    DMA1_CCR2 = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_PSIZE_32BIT | DMA_CCR_MSIZE_32BIT
+            | DMA_CCR_CIRC | DMA_CCR_PL_VERY_HIGH;
+    // TIM2_CH1: DMA1 channel 5, ramp -> ARR
+    dma_channel_reset(DMA1, DMA_CHANNEL5);
+    DMA1_CPAR5 = (uint32_t) &TIM2_ARR;
+    DMA1_CMAR5 = (uint32_t) ramp;
+    DMA1_CCR5 = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_PSIZE_16BIT | DMA_CCR_MSIZE_16BIT
+            | DMA_CCR_CIRC | DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_PL_HIGH;
+    TIM2_DIER = TIM_DIER_UDE;
+    rpm_fp = target_fp = MIN_RPM << 8;
+    current_RPM = MIN_RPM;
+    gen_start();
 }
 
-void tim2_isr(){
-    static uint16_t ctr = 0;
-    if(TIM2_SR & TIM_SR_UIF){ // update interrupt
-        if(ctr > pulsesLen) ctr = 0;
-        if(pulses[++ctr])
-            GPIO_BSRR(OUTP_PORT) = OUTP_PIN;
-        else
-            GPIO_BSRR(OUTP_PORT) = OUTP_PIN << 16;
-    }
-    TIM2_SR = 0;
+/**
+ * Start smooth change of speed
+ * @param RPM - target speed
+ */
+void set_speed(uint16_t RPM){
+    if(RPM > MAX_RPM) RPM = MAX_RPM;
+    if(RPM < MIN_RPM) RPM = MIN_RPM;
+    target_fp = RPM << 8;
+    if(RPM == MAX_RPM) gpio_clear(LEDS_PORT, LED_UPPER_PIN); // set LED "MAX"
+    else gpio_set(LEDS_PORT, LED_UPPER_PIN);
+    if(RPM == MIN_RPM) gpio_clear(LEDS_PORT, LED_LOW_PIN); // set LED "MIN"
+    else gpio_set(LEDS_PORT, LED_LOW_PIN);
+    ramp_start();
 }
 
 /**
- * Calculate motor speed in RPM
- * RPM = 1/tim2_arr / 40 * 60
+ * Change "rotation speed" by 100rpm
  */
-void get_RPM(){
-    uint32_t R = 3000000 / (uint32_t)TIM2_ARR;
-    current_RPM = R/2;
-    //current_RPM = R;
-    //current_RPM >>= 1; // x/2 != x>>1, WTF?
+void increase_speed(){
+    sweep = 0;
+    set_speed((target_fp >> 8) + 100);
+    print_int(target_fp >> 8);
 }
 
-// calculate TIM2_ARR by RPM
-uint16_t get_ARR(uint32_t RPM){
-    uint32_t R = 3000000 / RPM;
-    R /= 2;
-    //R >>= 1;
-    return (uint16_t)R;
+void decrease_speed(){
+    sweep = 0;
+    set_speed((target_fp >> 8) - 100);
+    print_int(target_fp >> 8);
 }
 
 /**
- * Change "rotation speed" by 100rpm
+ * Turn on/off continuous sweep between MIN_RPM and MAX_RPM
+ * @return 1 if sweep is on
  */
-void increase_speed(){
-    if(current_RPM == MAX_RPM) return;
-    current_RPM += 100;
-    if(current_RPM > MAX_RPM){ // set LED "MAX"
-        current_RPM = MAX_RPM;
-        TIM2_ARR = get_ARR(current_RPM);
-        gpio_clear(LEDS_PORT, LED_UPPER_PIN);
-    }else{
-        TIM2_ARR = get_ARR(current_RPM);
-        get_RPM(); // recalculate speed
-        gpio_set(LEDS_PORT, LED_UPPER_PIN);
-    }
-    gpio_set(LEDS_PORT, LED_LOW_PIN);
-    print_int(current_RPM);
+uint8_t toggle_sweep(){
+    sweep = !sweep;
+    if(sweep) set_speed(MAX_RPM);
+    else set_speed(rpm_fp >> 8);
+    return sweep;
 }
 
-void decrease_speed(){
-    if(current_RPM == MIN_RPM) return;
-    current_RPM -= 100;
-    if(current_RPM < MIN_RPM){ // set LED "MIN"
-        current_RPM = MIN_RPM;
-        TIM2_ARR = get_ARR(current_RPM);
-        gpio_clear(LEDS_PORT, LED_LOW_PIN);
-    }else{
-        TIM2_ARR = get_ARR(current_RPM);
-        get_RPM();
-        gpio_set(LEDS_PORT, LED_LOW_PIN);
-    }
-    gpio_set(LEDS_PORT, LED_UPPER_PIN);
-    print_int(current_RPM);
+/**
+ * Switch to next pattern
+ * @return its name
+ */
+const char *next_pattern(){
+    if(++cur_pattern == PATTERNS_AMOUNT) cur_pattern = 0;
+    gen_start();
+    return patterns[cur_pattern].name;
 }
@@ -30,14 +30,38 @@
 //~ // 6000rpm - 4kHz, T/2=250us
 //~ #define TM2_MAX_SPEED (250)
 // max & min rotation speed
-#define MAX_RPM  (6000)
+#define MAX_RPM  (12000)
 #define MIN_RPM  (200)
 
+// TIM2 frequency: 8MHz (ARR < 65536 for MIN_RPM with 40 teeth)
+#define GEN_TICK       (8000000)
+// max teeth of pattern
+#define GEN_MAX_TEETH  (60)
+// wave length: two halves of tooth for two revolutions
+#define GEN_MAX_STEPS  (4 * GEN_MAX_TEETH)
+// length of ARR ramp buffer
+#define GEN_RAMP_LEN   (64)
+// default speed of RPM changes (rpm per second)
+#define GEN_RAMP_RATE  (2000)
+
+// crankshaft & camshaft pattern
+typedef struct{
+    const char *name;
+    uint8_t teeth;          // teeth (including missing) per revolution
+    uint8_t missing;        // amount of last missing teeth
+    uint8_t cam_on;         // cam signal is active for teeth cam_on..cam_off-1
+    uint8_t cam_off;        //     of 720 degrees cycle
+    const uint8_t *levels;  // or levels of halves of teeth of revolution (NULL for teeth)
+} gen_pattern;
 
 void tim2_init();
 void increase_speed();
 void decrease_speed();
+void set_speed(uint16_t RPM);
+uint8_t toggle_sweep();
+const char *next_pattern();
 
 extern uint16_t current_RPM;
+extern uint16_t ramp_rate;
 
 #endif // __TIMER_H__
@@ -26,11 +26,13 @@
 
 
 void help(){
-    P("g\tShow this help\n");
+    P("h\tShow this help\n");
     P("t\tShow current approx. time\n");
     P("+\tIncrease speed by 100\n");
     P("-\tDecrease speed by 100\n");
     P("g\tGet current speed\n");
+    P("p\tSwitch to next pattern\n");
+    P("s\tStart/stop continuous speed sweep\n");
 }
 
 /**
@@ -63,6 +65,14 @@ int parse_incoming_buf(char *buf, int len){
             case '-':
                 decrease_speed();
             break;
+            case 'p':
+                P("Pattern: ");
+                P(next_pattern());
+                newline();
+            break;
+            case 's':
+                if(toggle_sweep()) P("Sweep on\n");
+                else P("Sweep off\n");
             break;
             case '\n': // show newline, space and tab as is
             case '\r':
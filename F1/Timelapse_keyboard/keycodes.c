@@ -56,19 +56,29 @@ uint8_t *set_key_buf(uint8_t MOD, uint8_t KEY){
 }
 
 /**
- * return buffer for sending symbol "ltr" with addition modificator mod
+ * get keycode of symbol "ltr"
+ * @param mod - modificator needed (MOD_SHIFT or 0)
+ * @return keycode or 0 if symbol can't be typed
  */
-uint8_t *press_key_mod(char ltr, uint8_t mod){
-	uint8_t MOD = 0;
+uint8_t get_keycode(char ltr, uint8_t *mod){
 	uint8_t KEY = 0;
-	if(ltr > 31){
+	*mod = 0;
+	if(ltr > 31 && ltr < 127){
 		KEY = keycodes[ltr - 32];
 		if(KEY & 0x80){
-			MOD = MOD_SHIFT;
+			*mod = MOD_SHIFT;
 			KEY &= 0x7f;
 		}
 	}else if (ltr == '\n') KEY = KEY_ENTER;
+	return KEY;
+}
+
+/**
+ * return buffer for sending symbol "ltr" with addition modificator mod
+ */
+uint8_t *press_key_mod(char ltr, uint8_t mod){
+	uint8_t MOD;
+	buf[2] = get_keycode(ltr, &MOD);
 	buf[0] = MOD | mod;
-	buf[2] = KEY;
 	return buf;
 }
@@ -51,6 +51,21 @@ uint32_t trigger_ms = DIDNT_TRIGGERED, adc_ms[ADC_CHANNEL_NUMBER] = {DIDNT_TRIGG
 #ifdef ULTRASONIC
 uint32_t ultrasonic_ms = DIDNT_TRIGGERED;
 #endif
+
+#ifdef HID_TIMESTAMP
+/**
+ * send time of event `evt` as binary report: Tm - time structure, T - milliseconds
+ */
+static void stamp_time(uint8_t evt, curtime *Tm, uint32_t T){
+	uint8_t flags = 0;
+	if(Tm->H > 23 || GPS_status == GPS_NOT_VALID) flags |= STAMP_NOTVALID;
+	if(need_sync) flags |= STAMP_NEEDSYNC;
+	send_timestamp(evt, (Tm->H*3600 + Tm->M*60 + Tm->S)*1000 + T, flags);
+}
+#else
+#define stamp_time(evt, Tm, T)
+#endif
+
 void time_increment(){
 	Timer = 0;
 	if(current_time.H == 25) return; // Time not initialized
@@ -150,6 +165,7 @@ if(msctr - trigrtm > 3000){
 			if(trigger_ms != DIDNT_TRIGGERED){ // Control Button pressed
 				trigrtm = msctr;
 				istriggered = 1;
+				stamp_time(STAMP_BUTTON, &trigger_time, trigger_ms);
 				P("Button time: ");
 				print_time(&trigger_time, trigger_ms);
 				if(*lastGPSans){
@@ -167,6 +183,7 @@ if(msctr - trigrtm > 3000){
 				if(timediff > ADC_NOICE_TIMEOUT && !istriggered){
 					trigrtm = msctr;
 					istriggered = 1;
+					stamp_time(i ? STAMP_LASER : STAMP_INFRARED, &adc_time[i], adcms);
 					if(i == 0) P("Infrared");
 					else P("Laser");
 				/*	P(" trig val: ");
@@ -180,6 +197,7 @@ if(msctr - trigrtm > 3000){
 			if(ultrasonic_ms != DIDNT_TRIGGERED && !istriggered){
 				trigrtm = msctr;
 				istriggered = 1;
+				stamp_time(STAMP_ULTRASONIC, &ultrasonic_time, ultrasonic_ms);
 				P("Ultrasonic time: ");
 				print_time(&ultrasonic_time, ultrasonic_ms);
 			}
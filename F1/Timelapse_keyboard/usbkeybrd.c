@@ -26,6 +26,8 @@
 static char sendbuf[BUFLEN];
 static char *msg_start = sendbuf, *msg_end = sendbuf;
 static const char *buf_end = sendbuf+BUFLEN;
+// last sent report: [0] - modificators, [2]..[7] - keys pressed
+static uint8_t lastrep[8] = {0,0,0,0,0,0,0,0};
 
 usbd_device *usbd_dev;
 
@@ -115,7 +117,7 @@ const struct usb_endpoint_descriptor hid_endpoint = {
 	.bEndpointAddress = 0x81,
 	.bmAttributes = USB_ENDPOINT_ATTR_INTERRUPT,
 	.wMaxPacketSize = 8,
-	.bInterval = 0x10,
+	.bInterval = KBD_INTERVAL,
 };
 
 const struct usb_interface_descriptor hid_iface = {
@@ -135,16 +137,86 @@ const struct usb_interface_descriptor hid_iface = {
 	.extralen = sizeof(hid_function),
 };
 
+#ifdef HID_TIMESTAMP
+// vendor-defined collection: one input report of STAMP_REPORT_SIZE bytes
+static const uint8_t stamp_report_descriptor[] = {
+    0x06, 0x00, 0xFF, /* Usage Page (Vendor Defined 0xFF00)    */
+    0x09, 0x01, /*		Usage (Vendor Usage 1)              */
+    0xA1, 0x01, /*		Collection (Application)            */
+    0x09, 0x01, /*      Usage (Vendor Usage 1)              */
+    0x15, 0x00, /*      Logical Minimum (0)                 */
+    0x26, 0xFF, 0x00, /* Logical Maximum (255)              */
+    0x75, 0x08, /*      Report Size (8)                     */
+    0x95, STAMP_REPORT_SIZE, /* Report Count (8)            */
+    0x81, 0x02, /*      Input (Data, Variable, Absolute)    */
+    0xC0        /* 		End Collection                      */
+};
+
+static const struct {
+	struct usb_hid_descriptor hid_descriptor;
+	struct {
+		uint8_t bReportDescriptorType;
+		uint16_t wDescriptorLength;
+	} __attribute__((packed)) hid_report;
+} __attribute__((packed)) stamp_function = {
+	.hid_descriptor = {
+		.bLength = sizeof(stamp_function),
+		.bDescriptorType = USB_DT_HID,
+		.bcdHID = 0x0100,
+		.bCountryCode = 0,
+		.bNumDescriptors = 1,
+	},
+	.hid_report = {
+		.bReportDescriptorType = USB_DT_REPORT,
+		.wDescriptorLength = sizeof(stamp_report_descriptor),
+	},
+};
+
+const struct usb_endpoint_descriptor stamp_endpoint = {
+	.bLength = USB_DT_ENDPOINT_SIZE,
+	.bDescriptorType = USB_DT_ENDPOINT,
+	.bEndpointAddress = 0x82,
+	.bmAttributes = USB_ENDPOINT_ATTR_INTERRUPT,
+	.wMaxPacketSize = STAMP_REPORT_SIZE,
+	.bInterval = 1, // host should get timestamp as fast as possible
+};
+
+const struct usb_interface_descriptor stamp_iface = {
+	.bLength = USB_DT_INTERFACE_SIZE,
+	.bDescriptorType = USB_DT_INTERFACE,
+	.bInterfaceNumber = 1,
+	.bAlternateSetting = 0,
+	.bNumEndpoints = 1,
+	.bInterfaceClass = USB_CLASS_HID,
+	.bInterfaceSubClass = 0, // no boot
+	.bInterfaceProtocol = 0,
+	.iInterface = 0,
+
+	.endpoint = &stamp_endpoint,
+
+	.extra = &stamp_function,
+	.extralen = sizeof(stamp_function),
+};
+#define NIFACES  (2)
+#else
+#define NIFACES  (1)
+#endif
+
 const struct usb_interface ifaces[] = {{
 	.num_altsetting = 1,
 	.altsetting = &hid_iface,
+#ifdef HID_TIMESTAMP
+}, {
+	.num_altsetting = 1,
+	.altsetting = &stamp_iface,
+#endif
 }};
 
 const struct usb_config_descriptor config = {
 	.bLength = USB_DT_CONFIGURATION_SIZE,
 	.bDescriptorType = USB_DT_CONFIGURATION,
 	.wTotalLength = 0,
-	.bNumInterfaces = 1,
+	.bNumInterfaces = NIFACES,
 	.bConfigurationValue = 1,
 	.iConfiguration = 0,
 	.bmAttributes = 0xC0,
@@ -171,7 +243,13 @@ static int hid_control_request(usbd_device *usbddev, struct usb_setup_data *req,
 	   (req->bRequest != USB_REQ_GET_DESCRIPTOR) ||
 	   (req->wValue != 0x2200))
 		return 0;
-
+#ifdef HID_TIMESTAMP
+	if(req->wIndex == 1){ // timestamp interface
+		*buf = (uint8_t *)stamp_report_descriptor;
+		*len = sizeof(stamp_report_descriptor);
+		return 1;
+	}
+#endif
 	*buf = (uint8_t *)hid_report_descriptor;
 	*len = sizeof(hid_report_descriptor);
 	got_config = 1;
@@ -181,7 +259,10 @@ static int hid_control_request(usbd_device *usbddev, struct usb_setup_data *req,
 void hid_set_config(usbd_device *usbddev, uint16_t wValue){
 	(void)wValue;
 	(void)usbddev;
-	usbd_ep_setup(usbd_dev, 0x81, USB_ENDPOINT_ATTR_INTERRUPT, 4, NULL);
+	usbd_ep_setup(usbd_dev, 0x81, USB_ENDPOINT_ATTR_INTERRUPT, 8, NULL);
+#ifdef HID_TIMESTAMP
+	usbd_ep_setup(usbd_dev, 0x82, USB_ENDPOINT_ATTR_INTERRUPT, STAMP_REPORT_SIZE, NULL);
+#endif
 	usbd_register_control_callback(
 				usbddev,
 				USB_REQ_TYPE_STANDARD | USB_REQ_TYPE_INTERFACE,
@@ -214,22 +295,94 @@ void newline(){
 	put_char_to_buf('\n');
 }*/
 
+// check whether key is pressed in report
+static int key_in(const uint8_t *rep, uint8_t key){
+	int i;
+	for(i = 2; i < 8; ++i)
+		if(rep[i] == key) return 1;
+	return 0;
+}
+
+#ifdef HID_TIMESTAMP
+#define STAMP_QLEN  (4)
+static uint8_t stamps[STAMP_QLEN][STAMP_REPORT_SIZE];
+static uint8_t stamp_first = 0, stamp_n = 0;
+
+static void process_stamps(){
+	while(stamp_n){
+		if(STAMP_REPORT_SIZE != usbd_ep_write_packet(usbd_dev, 0x82, stamps[stamp_first], STAMP_REPORT_SIZE))
+			return; // previous report still wasn't read by host
+		stamp_first = (stamp_first + 1) % STAMP_QLEN;
+		--stamp_n;
+	}
+}
+
+/**
+ * put binary timestamp into queue and try to send it at once
+ * @param evt   - event (STAMP_BUTTON etc)
+ * @param ms    - time of event: milliseconds from midnight
+ * @param flags - STAMP_NOTVALID | STAMP_NEEDSYNC
+ */
+void send_timestamp(uint8_t evt, uint32_t ms, uint8_t flags){
+	static uint16_t counter = 0;
+	uint8_t *r;
+	if(stamp_n == STAMP_QLEN){ // host doesn't read reports: drop oldest
+		stamp_first = (stamp_first + 1) % STAMP_QLEN;
+		--stamp_n;
+	}
+	r = stamps[(stamp_first + stamp_n++) % STAMP_QLEN];
+	r[0] = evt;
+	r[1] = flags;
+	r[2] = ms; r[3] = ms >> 8; r[4] = ms >> 16; r[5] = ms >> 24;
+	r[6] = counter; r[7] = counter >> 8;
+	++counter;
+	if(got_config) process_stamps();
+}
+#endif
+
 /**
  * send data from keyboard buffer
+ * Consecutive symbols with the same modificator and different keys are packed
+ * into one report (up to KBD_ROLLOVER keys): host gets them as keys pressed in
+ * order of report array. Key which is still held since previous report or
+ * changing of modificator needs intermediate report without keys.
  */
 void process_usbkbrd(){
 	if(!got_config) return; // don't allow sending messages until first connection - to prevent hangs
-	static uint8_t pressed = 0;
-	if(pressed){ // the keyboard was "pressed"
-		if(8 == usbd_ep_write_packet(usbd_dev, 0x81, release_key(), 8))
-			pressed = 0;
-	}else if(msg_start != msg_end){ // we need to send keypress event
-		if(8 == usbd_ep_write_packet(usbd_dev, 0x81, press_key(*msg_start), 8)){
-			if(++msg_start == buf_end)
-				msg_start = sendbuf;
-			pressed = 1;
+	uint8_t rep[8] = {0,0,0,0,0,0,0,0}, mod, m, key, n = 0;
+	char *p = msg_start;
+	int i;
+#ifdef HID_TIMESTAMP
+	process_stamps();
+#endif
+	while(p != msg_end){ // skip symbols that can't be typed
+		if(get_keycode(*p, &mod)) break;
+		if(++p == buf_end) p = sendbuf;
+	}
+	if(p == msg_end){ // buffer is empty
+		if(!lastrep[0] && !lastrep[2]){ // all keys are released already
+			msg_start = p;
+			return;
 		}
-	}else return;
+	}else{
+		key = get_keycode(*p, &mod);
+		m = mod;
+		rep[0] = mod;
+		if(mod == lastrep[0] && !key_in(lastrep, key)){
+			do{
+				if(key){
+					if(m != mod || key_in(rep, key) || key_in(lastrep, key)) break;
+					rep[2 + n++] = key;
+				}
+				if(++p == buf_end) p = sendbuf;
+				if(p == msg_end) break;
+				key = get_keycode(*p, &m);
+			}while(n < KBD_ROLLOVER);
+		} // else send report without keys to release them and change modificator
+	}
+	if(8 != usbd_ep_write_packet(usbd_dev, 0x81, rep, 8)) return;
+	msg_start = p;
+	for(i = 0; i < 8; ++i) lastrep[i] = rep[i];
 }
 
 /**
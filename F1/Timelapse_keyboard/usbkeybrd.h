@@ -25,6 +25,18 @@
 
 #include "main.h"
 
+// amount of keys pressed at once in one report (1..6); boot keyboard allows
+// 6 keys, set to 1 if host doesn't keep order of keys in report
+#ifndef KBD_ROLLOVER
+#define KBD_ROLLOVER  (6)
+#endif
+// keyboard polling interval (ms): 1 if compiled with -DKBD_FAST
+#ifdef KBD_FAST
+#define KBD_INTERVAL  (1)
+#else
+#define KBD_INTERVAL  (0x10)
+#endif
+
 extern usbd_device *usbd_dev;
 
 void process_usbkbrd();
@@ -41,4 +53,26 @@ void print_int(int32_t N);
 
 #define poll_usbkeybrd() usbd_poll(usbd_dev)
 
+#ifdef HID_TIMESTAMP
+/*
+ * Binary timestamp: input report of vendor-defined HID interface 1 (endpoint 0x82),
+ * all values are little-endian:
+ * [0]    - event (STAMP_BUTTON etc)
+ * [1]    - flags
+ * [2..5] - time of event (as typed): milliseconds from midnight
+ * [6..7] - number of report (to find lost reports)
+ */
+#define STAMP_REPORT_SIZE  (8)
+// events
+#define STAMP_BUTTON       (1)
+#define STAMP_INFRARED     (2)
+#define STAMP_LASER        (3)
+#define STAMP_ULTRASONIC   (4)
+// flags
+#define STAMP_NOTVALID     (1)
+#define STAMP_NEEDSYNC     (2)
+
+void send_timestamp(uint8_t evt, uint32_t ms, uint8_t flags);
+#endif
+
 #endif // __USBKEYBRD_H__
@@ -22,11 +22,11 @@
 #include "keycodes.h"
 /*
  * Keyboard buffer:
- * buf[1]: MOD
- * buf[2]: reserved
- * buf[3]..buf[8] - keycodes 1..6
+ * buf[0]: MOD
+ * buf[1]: reserved
+ * buf[2]..buf[7] - keycodes 1..6
  */
-static uint8_t buf[9] = {2,0,0,0,0,0,0,0,0};
+static uint8_t buf[8] = {0,0,0,0,0,0,0,0};
 
 #define _(x)  (x|0x80)
 // array for keycodes according to ASCII table; MSB is MOD_SHIFT flag
@@ -50,25 +50,35 @@ static const uint8_t keycodes[] = {
 };
 
 uint8_t *set_key_buf(uint8_t MOD, uint8_t KEY){
-	buf[1] = MOD;
-	buf[3] = KEY;
+	buf[0] = MOD;
+	buf[2] = KEY;
 	return buf;
 }
 
 /**
- * return buffer for sending symbol "ltr" with addition modificator mod
+ * get keycode of symbol "ltr"
+ * @param mod - modificator needed (MOD_SHIFT or 0)
+ * @return keycode or 0 if symbol can't be typed
  */
-uint8_t *press_key_mod(char ltr, uint8_t mod){
-	uint8_t MOD = 0;
+uint8_t get_keycode(char ltr, uint8_t *mod){
 	uint8_t KEY = 0;
-	if(ltr > 31){
+	*mod = 0;
+	if(ltr > 31 && ltr < 127){
 		KEY = keycodes[ltr - 32];
 		if(KEY & 0x80){
-			MOD = MOD_SHIFT;
+			*mod = MOD_SHIFT;
 			KEY &= 0x7f;
 		}
 	}else if (ltr == '\n') KEY = KEY_ENTER;
-	buf[1] = MOD | mod;
-	buf[3] = KEY;
+	return KEY;
+}
+
+/**
+ * return buffer for sending symbol "ltr" with addition modificator mod
+ */
+uint8_t *press_key_mod(char ltr, uint8_t mod){
+	uint8_t MOD;
+	buf[2] = get_keycode(ltr, &MOD);
+	buf[0] = MOD | mod;
 	return buf;
 }
@@ -25,6 +25,7 @@
 
 #include <stdint.h>
 
+uint8_t get_keycode(char ltr, uint8_t *mod);
 uint8_t *set_key_buf(uint8_t MOD, uint8_t KEY);
 #define release_key()  set_key_buf(0,0)
 uint8_t *press_key_mod(char key, uint8_t mod);
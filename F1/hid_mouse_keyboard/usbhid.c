@@ -24,6 +24,7 @@
 #include <libopencm3/usb/usbd.h>
 #include <libopencm3/usb/hid.h>
 #include <libopencm3/cm3/nvic.h>
+#include <libopencm3/cm3/cortex.h>
 
 #include "keycodes.h"
 
@@ -44,38 +45,19 @@ const struct usb_device_descriptor dev = {
 	.bNumConfigurations = 1,
 };
 
-static const uint8_t hid_report_descriptor[] =
+// polling interval of both endpoints, ms
+#define HID_INTERVAL    (1)
+// mouse report: buttons, X (int16), Y (int16), wheel
+#define MOUSE_REPORT    (6)
+#define KBD_REPORT      (8)
+// mouse deltas accumulated while host didn't read them are limited by this value
+#define MOUSE_MAXACC    (1 << 24)
+
+static const uint8_t kbd_report_descriptor[] =
 {
     0x05, 0x01, /* Usage Page (Generic Desktop)             */
-    0x09, 0x02, /* Usage (Mouse)                            */
-    0xA1, 0x01, /* Collection (Application)                 */
-    0x09, 0x01, /*  Usage (Pointer)                         */
-    0xA1, 0x00, /*  Collection (Physical)                   */
-    0x85, 0x01,  /*   Report ID  */
-    0x05, 0x09, /*      Usage Page (Buttons)                */
-    0x19, 0x01, /*      Usage Minimum (01)                  */
-    0x29, 0x03, /*      Usage Maximum (03)                  */
-    0x15, 0x00, /*      Logical Minimum (0)                 */
-    0x25, 0x01, /*      Logical Maximum (0)                 */
-    0x95, 0x03, /*      Report Count (3)                    */
-    0x75, 0x01, /*      Report Size (1)                     */
-    0x81, 0x02, /*      Input (Data, Variable, Absolute)    */
-    0x95, 0x01, /*      Report Count (1)                    */
-    0x75, 0x05, /*      Report Size (5)                     */
-    0x81, 0x01, /*      Input (Constant)    ;5 bit padding  */
-    0x05, 0x01, /*      Usage Page (Generic Desktop)        */
-    0x09, 0x30, /*      Usage (X)                           */
-    0x09, 0x31, /*      Usage (Y)                           */
-    0x15, 0x81, /*      Logical Minimum (-127)              */
-    0x25, 0x7F, /*      Logical Maximum (127)               */
-    0x75, 0x08, /*      Report Size (8)                     */
-    0x95, 0x02, /*      Report Count (2)                    */
-    0x81, 0x06, /*      Input (Data, Variable, Relative)    */
-    0xC0, 0xC0,/* End Collection,End Collection            */
-//
     0x09, 0x06, /*		Usage (Keyboard)                    */
     0xA1, 0x01, /*		Collection (Application)            */
-    0x85, 0x02,  /*   Report ID  */
     0x05, 0x07, /*  	Usage (Key codes)                   */
     0x19, 0xE0, /*      Usage Minimum (224)                 */
     0x29, 0xE7, /*      Usage Maximum (231)                 */
@@ -104,18 +86,55 @@ static const uint8_t hid_report_descriptor[] =
     0x19, 0x00, /*      Usage Minimum (00)                  */
     0x29, 0x65, /*      Usage Maximum (101)                 */
     0x81, 0x00, /*      Input (Data, Array)                 */
-    0xC0        /* 		End Collection,End Collection       */
+    0xC0        /* 		End Collection                      */
 };
 
-static const struct {
+static const uint8_t mouse_report_descriptor[] =
+{
+    0x05, 0x01, /* Usage Page (Generic Desktop)             */
+    0x09, 0x02, /* Usage (Mouse)                            */
+    0xA1, 0x01, /* Collection (Application)                 */
+    0x09, 0x01, /*  Usage (Pointer)                         */
+    0xA1, 0x00, /*  Collection (Physical)                   */
+    0x05, 0x09, /*      Usage Page (Buttons)                */
+    0x19, 0x01, /*      Usage Minimum (01)                  */
+    0x29, 0x03, /*      Usage Maximum (03)                  */
+    0x15, 0x00, /*      Logical Minimum (0)                 */
+    0x25, 0x01, /*      Logical Maximum (0)                 */
+    0x95, 0x03, /*      Report Count (3)                    */
+    0x75, 0x01, /*      Report Size (1)                     */
+    0x81, 0x02, /*      Input (Data, Variable, Absolute)    */
+    0x95, 0x01, /*      Report Count (1)                    */
+    0x75, 0x05, /*      Report Size (5)                     */
+    0x81, 0x01, /*      Input (Constant)    ;5 bit padding  */
+    0x05, 0x01, /*      Usage Page (Generic Desktop)        */
+    0x09, 0x30, /*      Usage (X)                           */
+    0x09, 0x31, /*      Usage (Y)                           */
+    0x16, 0x01, 0x80, /* Logical Minimum (-32767)           */
+    0x26, 0xFF, 0x7F, /* Logical Maximum (32767)            */
+    0x75, 0x10, /*      Report Size (16)                    */
+    0x95, 0x02, /*      Report Count (2)                    */
+    0x81, 0x06, /*      Input (Data, Variable, Relative)    */
+    0x09, 0x38, /*      Usage (Wheel)                       */
+    0x15, 0x81, /*      Logical Minimum (-127)              */
+    0x25, 0x7F, /*      Logical Maximum (127)               */
+    0x75, 0x08, /*      Report Size (8)                     */
+    0x95, 0x01, /*      Report Count (1)                    */
+    0x81, 0x06, /*      Input (Data, Variable, Relative)    */
+    0xC0, 0xC0,/* End Collection,End Collection            */
+};
+
+typedef struct {
 	struct usb_hid_descriptor hid_descriptor;
 	struct {
 		uint8_t bReportDescriptorType;
 		uint16_t wDescriptorLength;
 	} __attribute__((packed)) hid_report;
-} __attribute__((packed)) hid_function = {
+} __attribute__((packed)) hid_function_t;
+
+static const hid_function_t kbd_function = {
 	.hid_descriptor = {
-		.bLength = sizeof(hid_function),
+		.bLength = sizeof(hid_function_t),
 		.bDescriptorType = USB_DT_HID,
 		.bcdHID = 0x0100,
 		.bCountryCode = 0,
@@ -123,20 +142,43 @@ static const struct {
 	},
 	.hid_report = {
 		.bReportDescriptorType = USB_DT_REPORT,
-		.wDescriptorLength = sizeof(hid_report_descriptor),
+		.wDescriptorLength = sizeof(kbd_report_descriptor),
 	},
 };
 
-const struct usb_endpoint_descriptor hid_endpoint = {
+static const hid_function_t mouse_function = {
+	.hid_descriptor = {
+		.bLength = sizeof(hid_function_t),
+		.bDescriptorType = USB_DT_HID,
+		.bcdHID = 0x0100,
+		.bCountryCode = 0,
+		.bNumDescriptors = 1,
+	},
+	.hid_report = {
+		.bReportDescriptorType = USB_DT_REPORT,
+		.wDescriptorLength = sizeof(mouse_report_descriptor),
+	},
+};
+
+const struct usb_endpoint_descriptor kbd_endpoint = {
 	.bLength = USB_DT_ENDPOINT_SIZE,
 	.bDescriptorType = USB_DT_ENDPOINT,
 	.bEndpointAddress = 0x81,
 	.bmAttributes = USB_ENDPOINT_ATTR_INTERRUPT,
-	.wMaxPacketSize = 9,
-	.bInterval = 0x05,
+	.wMaxPacketSize = KBD_REPORT,
+	.bInterval = HID_INTERVAL,
+};
+
+const struct usb_endpoint_descriptor mouse_endpoint = {
+	.bLength = USB_DT_ENDPOINT_SIZE,
+	.bDescriptorType = USB_DT_ENDPOINT,
+	.bEndpointAddress = 0x82,
+	.bmAttributes = USB_ENDPOINT_ATTR_INTERRUPT,
+	.wMaxPacketSize = MOUSE_REPORT,
+	.bInterval = HID_INTERVAL,
 };
 
-const struct usb_interface_descriptor hid_iface = {
+const struct usb_interface_descriptor kbd_iface = {
 	.bLength = USB_DT_INTERFACE_SIZE,
 	.bDescriptorType = USB_DT_INTERFACE,
 	.bInterfaceNumber = 0,
@@ -147,22 +189,43 @@ const struct usb_interface_descriptor hid_iface = {
 	.bInterfaceProtocol = 1, // keyboard
 	.iInterface = 0,
 
-	.endpoint = &hid_endpoint,
+	.endpoint = &kbd_endpoint,
+
+	.extra = &kbd_function,
+	.extralen = sizeof(kbd_function),
+};
+
+// 16-bit deltas don't match boot mouse report, so this interface isn't boot one
+const struct usb_interface_descriptor mouse_iface = {
+	.bLength = USB_DT_INTERFACE_SIZE,
+	.bDescriptorType = USB_DT_INTERFACE,
+	.bInterfaceNumber = 1,
+	.bAlternateSetting = 0,
+	.bNumEndpoints = 1,
+	.bInterfaceClass = USB_CLASS_HID,
+	.bInterfaceSubClass = 0,
+	.bInterfaceProtocol = 0,
+	.iInterface = 0,
+
+	.endpoint = &mouse_endpoint,
 
-	.extra = &hid_function,
-	.extralen = sizeof(hid_function),
+	.extra = &mouse_function,
+	.extralen = sizeof(mouse_function),
 };
 
 const struct usb_interface ifaces[] = {{
 	.num_altsetting = 1,
-	.altsetting = &hid_iface,
+	.altsetting = &kbd_iface,
+}, {
+	.num_altsetting = 1,
+	.altsetting = &mouse_iface,
 }};
 
 const struct usb_config_descriptor config = {
 	.bLength = USB_DT_CONFIGURATION_SIZE,
 	.bDescriptorType = USB_DT_CONFIGURATION,
 	.wTotalLength = 0,
-	.bNumInterfaces = 1,
+	.bNumInterfaces = 2,
 	.bConfigurationValue = 1,
 	.iConfiguration = 0,
 	.bmAttributes = 0xC0,
@@ -179,6 +242,7 @@ static const char *usb_strings[] = {
 
 /* Buffer to be used for control requests. */
 uint8_t usbd_control_buffer[128];
+static uint8_t configured = 0;
 
 static int hid_control_request(usbd_device *usbd_dev, struct usb_setup_data *req, uint8_t **buf, uint16_t *len,
 			void (**complete)(usbd_device *usbd_dev, struct usb_setup_data *req))
@@ -191,9 +255,14 @@ static int hid_control_request(usbd_device *usbd_dev, struct usb_setup_data *req
 	   (req->wValue != 0x2200))
 		return 0;
 
-	/* Handle the HID report descriptor. */
-	*buf = (uint8_t *)hid_report_descriptor;
-	*len = sizeof(hid_report_descriptor);
+	/* Handle the HID report descriptor of interface wIndex. */
+	if(req->wIndex == 1){
+		*buf = (uint8_t *)mouse_report_descriptor;
+		*len = sizeof(mouse_report_descriptor);
+	}else{
+		*buf = (uint8_t *)kbd_report_descriptor;
+		*len = sizeof(kbd_report_descriptor);
+	}
 
 	return 1;
 }
@@ -203,7 +272,8 @@ static void hid_set_config(usbd_device *usbd_dev, uint16_t wValue)
 	(void)wValue;
 	(void)usbd_dev;
 
-	usbd_ep_setup(usbd_dev, 0x81, USB_ENDPOINT_ATTR_INTERRUPT, 4, NULL);
+	usbd_ep_setup(usbd_dev, 0x81, USB_ENDPOINT_ATTR_INTERRUPT, KBD_REPORT, NULL);
+	usbd_ep_setup(usbd_dev, 0x82, USB_ENDPOINT_ATTR_INTERRUPT, MOUSE_REPORT, NULL);
 
 	usbd_register_control_callback(
 				usbd_dev,
@@ -211,6 +281,7 @@ static void hid_set_config(usbd_device *usbd_dev, uint16_t wValue)
 				USB_REQ_TYPE_TYPE | USB_REQ_TYPE_RECIPIENT,
 				hid_control_request);
 
+	configured = 1;
 	systick_set_clocksource(STK_CSR_CLKSOURCE_AHB_DIV8);
 	/* SysTick interrupt every N clock pulses: set reload to N-1 */
 	systick_set_reload(99999);
@@ -220,6 +291,93 @@ static void hid_set_config(usbd_device *usbd_dev, uint16_t wValue)
 
 usbd_device *usbd_dev;
 
+/*
+ * Output queue: reports are sent from main loop as soon as endpoint is free,
+ * so move_mouse() and send_word() never block and could be called from interrupts.
+ * Mouse motion is accumulated and sent by one report per poll, buttons changes
+ * are queued (so short click won't be lost), keyboard symbols are stored in
+ * ring buffer and typed by press/release reports.
+ */
+static volatile int32_t mouse_dx = 0, mouse_dy = 0, mouse_wheel = 0; // pending motion
+#define BTN_QLEN    (8)
+static volatile uint8_t btn_queue[BTN_QLEN], btn_first = 0, btn_last = 0;
+static uint8_t btn_state = 0;           // last queued buttons state
+static uint8_t mouse_sent = 0;          // buttons state in last report
+static uint8_t mouse_btnwait = 0;       // motion before buttons change was sent
+
+#define KBD_BUFLEN  (256)
+static char kbd_buf[KBD_BUFLEN];
+static volatile uint16_t kbd_first = 0, kbd_last = 0;
+
+static int32_t satadd(int32_t acc, int32_t d){
+	acc += d;
+	if(acc > MOUSE_MAXACC) return MOUSE_MAXACC;
+	if(acc < -MOUSE_MAXACC) return -MOUSE_MAXACC;
+	return acc;
+}
+
+static int32_t clamp(int32_t v, int32_t lim){
+	if(v > lim) return lim;
+	if(v < -lim) return -lim;
+	return v;
+}
+
+/**
+ * send one mouse report with all pending motion (up to 16-bit on X/Y)
+ */
+static void mouse_flush(){
+	uint8_t buf[MOUSE_REPORT], btns = mouse_sent, newbtn = 0, rest;
+	int32_t x, y, w;
+	cm_disable_interrupts();
+	x = clamp(mouse_dx, 32767);
+	y = clamp(mouse_dy, 32767);
+	w = clamp(mouse_wheel, 127);
+	cm_enable_interrupts();
+	// motion made before buttons change should be applied with old buttons state
+	if(btn_first != btn_last && (mouse_btnwait || (!x && !y && !w))){
+		btns = btn_queue[btn_first];
+		newbtn = 1;
+	}
+	if(!newbtn && !x && !y && !w) return;
+	/*
+	 * buf[0]: bit2 - middle button, bit1 - right, bit0 - left
+	 * buf[1..2]: move X
+	 * buf[3..4]: move Y
+	 * buf[5]: wheel
+	 */
+	buf[0] = btns;
+	buf[1] = x; buf[2] = x >> 8;
+	buf[3] = y; buf[4] = y >> 8;
+	buf[5] = w;
+	if(MOUSE_REPORT != usbd_ep_write_packet(usbd_dev, 0x82, buf, MOUSE_REPORT)) return;
+	if(newbtn) btn_first = (btn_first + 1) % BTN_QLEN;
+	mouse_sent = btns;
+	cm_disable_interrupts();
+	mouse_dx -= x;
+	mouse_dy -= y;
+	mouse_wheel -= w;
+	rest = (mouse_dx || mouse_dy || mouse_wheel);
+	cm_enable_interrupts();
+	// next buttons change waits until motion over report limits is sent too
+	mouse_btnwait = (btn_first != btn_last && !rest);
+}
+
+/**
+ * send next keyboard report: press of next symbol or release
+ */
+static void kbd_flush(){
+	static uint8_t pressed = 0;
+	if(pressed){
+		if(KBD_REPORT == usbd_ep_write_packet(usbd_dev, 0x81, release_key(), KBD_REPORT))
+			pressed = 0;
+	}else if(kbd_first != kbd_last){
+		if(KBD_REPORT == usbd_ep_write_packet(usbd_dev, 0x81, press_key(kbd_buf[kbd_first]), KBD_REPORT)){
+			kbd_first = (kbd_first + 1) % KBD_BUFLEN;
+			pressed = 1;
+		}
+	}
+}
+
 int main(void)
 {
 	int i;
@@ -240,34 +398,53 @@ int main(void)
 
 	gpio_clear(GPIOC, GPIO11);
 
-	while (1)
+	while (1){
 		usbd_poll(usbd_dev);
+		if(configured){
+			mouse_flush();
+			kbd_flush();
+		}
+	}
 }
 
-void move_mouse(int8_t x, int8_t y){
-	/*
-	 * buf[0]: 1 - report ID
-	 * buf[1]: bit2 - middle button, bit1 - right, bit0 - left
-	 * buf[2]: move X
-	 * buf[3]: move Y
-	 * buf[4]: wheel
-	 */
-	int8_t buf[5] = {1,0,0,0,0};
-	buf[2] = x; buf[3] = y;
-	while(5 != usbd_ep_write_packet(usbd_dev, 0x81, buf, 5));
+/**
+ * add relative motion to mouse queue
+ */
+void move_mouse(int16_t x, int16_t y){
+	mouse_dx = satadd(mouse_dx, x);
+	mouse_dy = satadd(mouse_dy, y);
 }
 
-/*
- * Keyboard buffer:
- * buf[1]: MOD
- * buf[2]: reserved
- * buf[3]..buf[8] - keycodes 1..6
+void mouse_scroll(int8_t w){
+	mouse_wheel = satadd(mouse_wheel, w);
+}
+
+/**
+ * set mouse buttons state: bit0 - left, bit1 - right, bit2 - middle
  */
-void send_word(char *wrd){
-	do{
-		while(9 != usbd_ep_write_packet(usbd_dev, 0x81, press_key(*wrd), 9));
-		while(9 != usbd_ep_write_packet(usbd_dev, 0x81, release_key(), 9));
-	}while(*(++wrd));
+void mouse_buttons(uint8_t btns){
+	uint8_t next = (btn_last + 1) % BTN_QLEN;
+	btns &= 7;
+	if(btns == btn_state || next == btn_first) return;
+	btn_queue[btn_last] = btns;
+	btn_last = next;
+	btn_state = btns;
+}
+
+/**
+ * put word into keyboard queue
+ * @return amount of symbols queued (less than length of wrd if buffer is full)
+ */
+int send_word(const char *wrd){
+	int n = 0;
+	while(*wrd){
+		uint16_t next = (kbd_last + 1) % KBD_BUFLEN;
+		if(next == kbd_first) break; // buffer is full
+		kbd_buf[kbd_last] = *wrd++;
+		kbd_last = next;
+		++n;
+	}
+	return n;
 }
 
 void sys_tick_handler(void){
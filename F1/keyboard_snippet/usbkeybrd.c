@@ -26,6 +26,8 @@
 static char sendbuf[BUFLEN];
 static char *msg_start = sendbuf, *msg_end = sendbuf;
 static const char *buf_end = sendbuf+BUFLEN;
+// last sent report: [0] - modificators, [2]..[7] - keys pressed
+static uint8_t lastrep[8] = {0,0,0,0,0,0,0,0};
 
 usbd_device *usbd_dev;
 
@@ -115,7 +117,7 @@ const struct usb_endpoint_descriptor hid_endpoint = {
 	.bEndpointAddress = 0x81,
 	.bmAttributes = USB_ENDPOINT_ATTR_INTERRUPT,
 	.wMaxPacketSize = 8,
-	.bInterval = 0x10,
+	.bInterval = KBD_INTERVAL,
 };
 
 const struct usb_interface_descriptor hid_iface = {
@@ -181,7 +183,7 @@ static int hid_control_request(usbd_device *usbddev, struct usb_setup_data *req,
 void hid_set_config(usbd_device *usbddev, uint16_t wValue){
 	(void)wValue;
 	(void)usbddev;
-	usbd_ep_setup(usbd_dev, 0x81, USB_ENDPOINT_ATTR_INTERRUPT, 4, NULL);
+	usbd_ep_setup(usbd_dev, 0x81, USB_ENDPOINT_ATTR_INTERRUPT, 8, NULL);
 	usbd_register_control_callback(
 				usbddev,
 				USB_REQ_TYPE_STANDARD | USB_REQ_TYPE_INTERFACE,
@@ -209,21 +211,53 @@ void newline(){
 	put_char_to_buf('\n');
 }
 
+// check whether key is pressed in report
+static int key_in(const uint8_t *rep, uint8_t key){
+	int i;
+	for(i = 2; i < 8; ++i)
+		if(rep[i] == key) return 1;
+	return 0;
+}
+
 /**
  * send data from keyboard buffer
+ * Consecutive symbols with the same modificator and different keys are packed
+ * into one report (up to KBD_ROLLOVER keys): host gets them as keys pressed in
+ * order of report array. Key which is still held since previous report or
+ * changing of modificator needs intermediate report without keys.
  */
 void process_usbkbrd(){
-	static uint8_t pressed = 0;
-	if(pressed){ // the keyboard was "pressed"
-		if(8 == usbd_ep_write_packet(usbd_dev, 0x81, release_key(), 8))
-			pressed = 0;
-	}else if(msg_start != msg_end){ // we need to send keypress event
-		if(8 == usbd_ep_write_packet(usbd_dev, 0x81, press_key(*msg_start), 8)){
-			if(++msg_start == buf_end)
-				msg_start = sendbuf;
-			pressed = 1;
+	uint8_t rep[8] = {0,0,0,0,0,0,0,0}, mod, m, key, n = 0;
+	char *p = msg_start;
+	int i;
+	while(p != msg_end){ // skip symbols that can't be typed
+		if(get_keycode(*p, &mod)) break;
+		if(++p == buf_end) p = sendbuf;
+	}
+	if(p == msg_end){ // buffer is empty
+		if(!lastrep[0] && !lastrep[2]){ // all keys are released already
+			msg_start = p;
+			return;
 		}
-	}else return;
+	}else{
+		key = get_keycode(*p, &mod);
+		m = mod;
+		rep[0] = mod;
+		if(mod == lastrep[0] && !key_in(lastrep, key)){
+			do{
+				if(key){
+					if(m != mod || key_in(rep, key) || key_in(lastrep, key)) break;
+					rep[2 + n++] = key;
+				}
+				if(++p == buf_end) p = sendbuf;
+				if(p == msg_end) break;
+				key = get_keycode(*p, &m);
+			}while(n < KBD_ROLLOVER);
+		} // else send report without keys to release them and change modificator
+	}
+	if(8 != usbd_ep_write_packet(usbd_dev, 0x81, rep, 8)) return;
+	msg_start = p;
+	for(i = 0; i < 8; ++i) lastrep[i] = rep[i];
 }
 
 /**
@@ -25,6 +25,18 @@
 
 #include "ocm.h"
 
+// amount of keys pressed at once in one report (1..6); boot keyboard allows
+// 6 keys, set to 1 if host doesn't keep order of keys in report
+#ifndef KBD_ROLLOVER
+#define KBD_ROLLOVER  (6)
+#endif
+// keyboard polling interval (ms): 1 if compiled with -DKBD_FAST
+#ifdef KBD_FAST
+#define KBD_INTERVAL  (1)
+#else
+#define KBD_INTERVAL  (0x10)
+#endif
+
 extern usbd_device *usbd_dev;
 
 void process_usbkbrd();
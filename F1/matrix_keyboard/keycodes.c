@@ -50,25 +50,53 @@ static const uint8_t keycodes[] = {
 };
 
 uint8_t *set_key_buf(uint8_t MOD, uint8_t KEY){
+	uint8_t i;
 	buf[0] = MOD;
 	buf[2] = KEY;
+	for(i = 3; i < 8; ++i) buf[i] = 0;
 	return buf;
 }
 
-/**
- * return buffer for sending symbol "ltr" with addition modificator mod
- */
-uint8_t *press_key_mod(char ltr, uint8_t mod){
-	uint8_t MOD = 0;
+// get keycode of symbol "ltr" & its modificator
+static uint8_t keycode(char ltr, uint8_t *MOD){
 	uint8_t KEY = 0;
-	if(ltr > 31){
+	*MOD = 0;
+	if(ltr > 31 && ltr < 127){
 		KEY = keycodes[ltr - 32];
 		if(KEY & 0x80){
-			MOD = MOD_SHIFT;
+			*MOD = MOD_SHIFT;
 			KEY &= 0x7f;
 		}
 	}else if (ltr == '\n') KEY = KEY_ENTER;
-	buf[0] = MOD | mod;
-	buf[2] = KEY;
+	return KEY;
+}
+
+/**
+ * return buffer for sending symbol "ltr" with addition modificator mod
+ */
+uint8_t *press_key_mod(char ltr, uint8_t mod){
+	uint8_t MOD;
+	uint8_t KEY = keycode(ltr, &MOD);
+	return set_key_buf(MOD | mod, KEY);
+}
+
+/**
+ * return buffer for sending all symbols of "ltrs" (n symbols) pressed simultaneously
+ * host types only just pressed key, so modificator is taken only from symbol ltrs[typed]
+ * (SHIFT of '*' shouldn't turn '1' into '!'), typed >= n - without modificator;
+ * more than 6 keys gives "rollover" error
+ */
+uint8_t *press_keys(const char *ltrs, uint8_t n, uint8_t typed){
+	uint8_t i, MOD;
+	if(n > 6){
+		buf[0] = 0;
+		for(i = 2; i < 8; ++i) buf[i] = KEY_ROLLOVER;
+		return buf;
+	}
+	set_key_buf(0, 0);
+	for(i = 0; i < n; ++i){
+		buf[i + 2] = keycode(ltrs[i], &MOD);
+		if(i == typed) buf[0] = MOD;
+	}
 	return buf;
 }
@@ -29,6 +29,7 @@ uint8_t *set_key_buf(uint8_t MOD, uint8_t KEY);
 #define release_key()  set_key_buf(0,0)
 uint8_t *press_key_mod(char key, uint8_t mod);
 #define press_key(k)   press_key_mod(k, 0)
+uint8_t *press_keys(const char *ltrs, uint8_t n, uint8_t typed);
 
 #define MOD_CTRL	0x01
 #define MOD_SHIFT	0x02
@@ -38,6 +39,8 @@ uint8_t *press_key_mod(char key, uint8_t mod);
 #define LEFT(mod)   (mod)
 #define RIGHT(mod)  ((mod << 4))
 
+// too many keys pressed
+#define KEY_ROLLOVER	1
 #define KEY_A		4
 #define KEY_B		5
 #define KEY_C		6
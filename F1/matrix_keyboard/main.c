@@ -257,14 +257,31 @@ int main(void){
 	gpio_clear(GPIOC, GPIO11);
 */
 
+	// keys state applied by events (can lag from current keyboard state)
+	uint16_t state = 0;
+	uint8_t last = 16; // last pressed key (its modificator is used), 16 - none
 	while (1){
-		char prsd, rlsd;
+		kbd_event ev;
 		usbd_poll(usbd_dev);
-		get_matrixkbd(&prsd, &rlsd);
-		if(rlsd)
-			while(8 != usbd_ep_write_packet(usbd_dev, 0x81, release_key(), 8));
-		if(prsd)
-			while(8 != usbd_ep_write_packet(usbd_dev, 0x81, press_key(prsd), 8));
+		// each event gives its own report, so order of chords is kept
+		while(matrixkbd_getevent(&ev)){
+			char syms[16];
+			uint8_t i, n = 0, typed = 16;
+			if(ev.pressed){
+				state |= 1 << ev.key;
+				last = ev.key;
+			}else{
+				state &= ~(1 << ev.key);
+				if(last == ev.key) last = 16;
+			}
+			for(i = 0; i < 16; ++i){
+				if(!(state & (1 << i))) continue;
+				if(i == last) typed = n;
+				syms[n++] = matrixkbd_symbol(i);
+			}
+			while(8 != usbd_ep_write_packet(usbd_dev, 0x81, press_keys(syms, n, typed), 8))
+				usbd_poll(usbd_dev);
+		}
 	}
 }
 
@@ -57,14 +57,24 @@ char kbd[ROWS][COLS] = {
 	{'*', '0', '#', 'D'}
 };
 #endif
-uint8_t oldstate[ROWS][COLS];
+
+// debounce integrators: increment while key pressed, decrement while released
+static uint8_t integrator[ROWS*COLS];
+// bitmap of debounced keys states (bit r*COLS+c set when key pressed)
+static volatile uint16_t kbdstate = 0;
+// events queue
+static kbd_event events[KBD_QUEUE_LEN];
+static volatile uint8_t evfirst = 0, evlast = 0;
+static uint8_t curcol = 0; // column driven now
 
 /**
  * init keyboard pins: all columns are opendrain outputs
  * all rows are pullup inputs
+ * TIM2 interrupts drive columns one by one: each KBD_SCAN_PERIOD microseconds
+ * rows of current column are read & next column is driven
  */
 void matrixkbd_init(){
-	int i, j;
+	int i;
 	rcc_peripheral_enable_clock(&RCC_APB2ENR, KBD_RCC_PORT_CLOCK);
 	for(i = 0; i < COLS; ++i){
 		gpio_set(col_ports[i], col_pins[i]);
@@ -76,44 +86,81 @@ void matrixkbd_init(){
 		gpio_set_mode(row_ports[i], GPIO_MODE_INPUT, GPIO_CNF_INPUT_PULL_UPDOWN,
 			row_pins[i]);
 	}
-	for(j = 0; j < ROWS; ++j)
-		for(i = 0; i < COLS; ++i)
-			oldstate[j][i] = 1;
+	for(i = 0; i < ROWS*COLS; ++i) integrator[i] = 0;
+	curcol = 0;
+	gpio_clear(col_ports[0], col_pins[0]);
+	// TIM2: 1MHz ticks, interrupt each KBD_SCAN_PERIOD us
+	rcc_periph_clock_enable(RCC_TIM2);
+	timer_reset(TIM2);
+	timer_set_mode(TIM2, TIM_CR1_CKD_CK_INT, TIM_CR1_CMS_EDGE, TIM_CR1_DIR_UP);
+	timer_set_prescaler(TIM2, KBD_TIMCLK / 1000000 - 1);
+	timer_set_period(TIM2, KBD_SCAN_PERIOD - 1);
+	timer_enable_irq(TIM2, TIM_DIER_UIE);
+	nvic_enable_irq(NVIC_TIM2_IRQ);
+	timer_enable_counter(TIM2);
+}
+
+// put event into queue, return 0 if queue is full
+static int put_event(uint8_t key, uint8_t pressed){
+	uint8_t nxt = (evlast + 1) % KBD_QUEUE_LEN;
+	if(nxt == evfirst) return 0;
+	events[evlast].time = Timer;
+	events[evlast].key = key;
+	events[evlast].pressed = pressed;
+	evlast = nxt;
+	return 1;
+}
+
+/**
+ * Get next event from queue
+ * @param ev (o) - event
+ * @return 0 if queue is empty
+ */
+int matrixkbd_getevent(kbd_event *ev){
+	if(evfirst == evlast) return 0;
+	nvic_disable_irq(NVIC_TIM2_IRQ);
+	*ev = events[evfirst];
+	evfirst = (evfirst + 1) % KBD_QUEUE_LEN;
+	nvic_enable_irq(NVIC_TIM2_IRQ);
+	return 1;
 }
 
+/**
+ * @return bitmap of pressed keys (bit number is row*KBD_COLS + column)
+ */
+uint16_t matrixkbd_state(){
+	return kbdstate;
+}
 
 /**
- * Check keyboard
- * if some key pressed, set prsd to its value (symbol)
- * if released - set rlsd to 1
- * works onse per 60ms
- * DON't work with multiple key pressing!
- * In case of simultaneous pressing it will return at first call code of
- *     first key met, at second - second and so on
+ * @return symbol of key with given number
  */
-void get_matrixkbd(char *prsd, char *rlsd){
-	*prsd = 0;
-	*rlsd = 0;
-	static uint32_t oldTimer = 0;
-	if(Timer > oldTimer && Timer - oldTimer < KBD_TIMEOUT) return;
-	int r, c;
-	for(c = 0; c < COLS; ++c){
-		gpio_clear(col_ports[c], col_pins[c]);
-		oldTimer = Timer;
-		while(oldTimer == Timer); // wait at least one second
-		for(r = 0; r < ROWS; ++r){
-			uint8_t st = (gpio_get(row_ports[r], row_pins[r])) ? 1 : 0;
-			if(oldstate[r][c] != st){ // button state changed
-				oldstate[r][c] = st;
-				gpio_set(col_ports[c], col_pins[c]);
-				if(st == 1){ // released
-					*rlsd = 1;
-				}else{
-					*prsd = kbd[r][c];
-				}
-				return;
-			}
+char matrixkbd_symbol(uint8_t key){
+	if(key >= ROWS*COLS) return 0;
+	return kbd[key / COLS][key % COLS];
+}
+
+void tim2_isr(){
+	int r;
+	if(!timer_get_flag(TIM2, TIM_SR_UIF)) return;
+	timer_clear_flag(TIM2, TIM_SR_UIF);
+	// rows of current column had the whole period to settle
+	for(r = 0; r < ROWS; ++r){
+		uint8_t key = r*COLS + curcol;
+		uint16_t mask = 1 << key;
+		// state changes only when its event is queued: if queue is full, event
+		// is repeated on next scans, so pressings & releasings are always paired
+		if(!gpio_get(row_ports[r], row_pins[r])){ // pressed
+			if(integrator[key] < KBD_DEBOUNCE) ++integrator[key];
+			if(integrator[key] == KBD_DEBOUNCE && !(kbdstate & mask) && put_event(key, 1))
+				kbdstate |= mask;
+		}else{
+			if(integrator[key]) --integrator[key];
+			if(!integrator[key] && (kbdstate & mask) && put_event(key, 0))
+				kbdstate &= ~mask;
 		}
-		gpio_set(col_ports[c], col_pins[c]);
 	}
+	gpio_set(col_ports[curcol], col_pins[curcol]);
+	if(++curcol == COLS) curcol = 0;
+	gpio_clear(col_ports[curcol], col_pins[curcol]);
 }
@@ -23,12 +23,30 @@
 #include <stdlib.h>
 #include <libopencm3/stm32/rcc.h>
 #include <libopencm3/stm32/gpio.h>
+#include <libopencm3/stm32/timer.h>
+#include <libopencm3/cm3/nvic.h>
+
+// key press/release event
+typedef struct{
+	uint32_t time;		// Timer value (ms)
+	uint8_t key;		// row*COLS + column
+	uint8_t pressed;	// 1 - pressed, 0 - released
+} kbd_event;
 
 void matrixkbd_init();
-void get_matrixkbd(char *prsd, char *rlsd);
+int matrixkbd_getevent(kbd_event *ev);
+uint16_t matrixkbd_state();
+char matrixkbd_symbol(uint8_t key);
 
-// timeout for keyboard checkout
-#define KBD_TIMEOUT 50
+// period of columns switching (us)
+#define KBD_SCAN_PERIOD 1000
+// key state changes after this amount of equal readings in row
+#define KBD_DEBOUNCE    5
+// length of events queue
+#define KBD_QUEUE_LEN   16
+// TIM2 clock (rcc_clock_setup_in_hsi_out_48mhz: APB1 is 24MHz, its prescaler isn't 1,
+// so timer clock is doubled)
+#define KBD_TIMCLK      48000000
 
 // kbd ports for clock_enable
 #define KBD_RCC_PORT_CLOCK    (RCC_APB2ENR_IOPAEN | RCC_APB2ENR_IOPBEN)
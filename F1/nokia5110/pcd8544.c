@@ -20,8 +20,8 @@
  */
 
 /*
- * we have two modes: direct write into LCD (with local buffer update) - for text
- * and refresh whole buffer - for graphics
+ * all drawing goes into local buffer, its changed parts are sent by refresh
+ * (text output calls it itself, graphics - should call after drawing)
  * all writings are in horizontal addressing mode
  */
 
@@ -49,11 +49,19 @@ const U8 const pixels_reset[] = {0xfe,0xfd,0xfb,0xf7,0xef,0xdf,0xbf,0x7f};
  * I use horizontal addressing of PCD8544, so data in buffer
  * stored line by line, each byte is 8 vertical pixels (LSB upper)
  *
- * As refresh speed is fast enough, I don't use partial update for graphics
- * (but use for letters)
+ * Each bank (8-pixel line) has its range of changed columns, so refresh
+ * sends only them. Refresh is made by SPI DMA: next dirty bank is addressed
+ * & sent from DMA transfer complete interrupt.
  */
 #define DISPLAYBUFSIZE   (XSIZE*YCHARSZ)
-static U8 displaybuf[DISPLAYBUFSIZE];
+// aligned for 32-bit DMA memmove
+static U8 displaybuf[DISPLAYBUFSIZE] __attribute__((aligned(4)));
+// dirty columns range of each bank: (max << 8) | min, written at once
+static volatile U16 dirty[YCHARSZ];
+#define DIRTY_NONE   (0x00ff)
+static volatile U8 refreshing = 0; // DMA refresh is in progress
+static U8 curbank = 0; // next bank to check
+volatile U8 pcd8544_refreshed = 0; // set when refresh is over
 
 // current letter coordinates - for "printf"
 static scrnsz_t cur_x = 0, cur_y = 0;
@@ -81,6 +89,7 @@ void pcd8544_settemp(U8 val){
  * Init SPI & display
  */
 void pcd8544_init(){
+	scrnsz_t i;
 	CHIP_DIS();
 	SET_DC();
 	LCD_RST();
@@ -97,6 +106,7 @@ void pcd8544_init(){
 	CMD(PCD8544_DEFAULTMODE);
 	CMD(PCD8544_DISPLAYNORMAL);
 
+	for(i = 0; i < YCHARSZ; ++i) dirty[i] = DIRTY_NONE;
 	pcd8544_cls();
 }
 
@@ -104,6 +114,7 @@ void pcd8544_init(){
  * Send command (cmd != 0) or data (cmd == 0) byte
  */
 void pcd8544_send_byte(U8 byte, U8 cmd){
+	pcd8544_wait();
 	CHIP_EN();
 	if(cmd)
 		CLEAR_DC();
@@ -116,6 +127,7 @@ void pcd8544_send_byte(U8 byte, U8 cmd){
  * Send data sequence
  */
 void pcd8544_send_data(U8 *data, bufsz_t size, U8 cmd){
+	pcd8544_wait();
 	CHIP_EN();
 	if(cmd)
 		CLEAR_DC();
@@ -125,6 +137,17 @@ void pcd8544_send_data(U8 *data, bufsz_t size, U8 cmd){
 	CHIP_DIS();
 }
 
+/**
+ * Mark columns xmin..xmax of bank as changed
+ */
+void mark_dirty(scrnsz_t bank, scrnsz_t xmin, scrnsz_t xmax){
+	U16 d = dirty[bank];
+	scrnsz_t min = d & 0xff, max = d >> 8;
+	if(xmin < min) min = xmin;
+	if(xmax > max) max = xmax;
+	dirty[bank] = ((U16)max << 8) | min;
+}
+
 void draw_pixel(scrnsz_t x, scrnsz_t y, U8 set){
 	bufsz_t idx;
 	if(bad_coords(x,y)) return;
@@ -134,21 +157,75 @@ void draw_pixel(scrnsz_t x, scrnsz_t y, U8 set){
 		displaybuf[idx] |= pixels_set[y];
 	else
 		displaybuf[idx] &= pixels_reset[y];
+	mark_dirty(idx / XSIZE, x, x);
 }
 
 void pcd8544_cls(){
+	pcd8544_wait();
 	memset(displaybuf, 0, DISPLAYBUFSIZE);
 	cur_x = cur_y = 0;
-	pcd8544_refresh();
+	pcd8544_refresh_all();
+}
+
+// send command while refreshing (DMA isn't active)
+static void refresh_cmd(U8 cmd){
+	CHIP_EN();
+	CLEAR_DC();
+	spi_write_byte(cmd);
+}
+
+/*
+ * Send next dirty bank (called from DMA interrupt after previous bank);
+ * banks changed while refreshing are sent on next pass
+ */
+static void next_bank(){
+	for(;;){
+		for(; curbank < YCHARSZ; ++curbank){
+			U16 d = dirty[curbank];
+			if(d == DIRTY_NONE) continue;
+			dirty[curbank] = DIRTY_NONE;
+			scrnsz_t min = d & 0xff, max = d >> 8;
+			refresh_cmd(PCD8544_SETXADDR | min);
+			refresh_cmd(PCD8544_SETYADDR | curbank);
+			SET_DC();
+			spiWriteDMA(&displaybuf[curbank*XSIZE + min], max - min + 1, next_bank);
+			++curbank;
+			return;
+		}
+		for(curbank = 0; curbank < YCHARSZ; ++curbank)
+			if(dirty[curbank] != DIRTY_NONE) break;
+		if(curbank == YCHARSZ) break;
+	}
+	CHIP_DIS();
+	refreshing = 0;
+	pcd8544_refreshed = 1;
 }
 
 /**
- * send full data buffer onto display
+ * send changed parts of data buffer onto display (non-blocking)
  */
 void pcd8544_refresh(){
-	SETXADDR(0);
-	SETYADDR(0);
-	DBUF(displaybuf, DISPLAYBUFSIZE);
+	if(refreshing) return; // changes will be sent by current refresh
+	refreshing = 1;
+	pcd8544_refreshed = 0;
+	curbank = 0;
+	next_bank();
+}
+
+/**
+ * send full data buffer onto display
+ */
+void pcd8544_refresh_all(){
+	scrnsz_t i;
+	for(i = 0; i < YCHARSZ; ++i) mark_dirty(i, 0, XSIZE - 1);
+	pcd8544_refresh();
+}
+
+/**
+ * wait while refresh is in progress
+ */
+void pcd8544_wait(){
+	while(refreshing);
 }
 
 /**
@@ -166,9 +243,8 @@ int pcd8544_put(U8 koi8, scrnsz_t x, scrnsz_t y){
 	// put letter into display buffer
 	memcpy(&displaybuf[idx], symbol, LTR_WIDTH);
 	// and show it on display
-	SETXADDR(x);
-	SETYADDR(y);
-	DBUF(symbol, LTR_WIDTH);
+	mark_dirty(y, x, x + LTR_WIDTH - 1);
+	pcd8544_refresh();
 	return 1;
 }
 
@@ -223,12 +299,46 @@ U8 *pcd8544_print(U8 *koi8){
 	return NULL;
 }
 
+// mark columns of bank which differ from `newdata`
+static void mark_changes(scrnsz_t bank, const U8 *newdata){
+	const U8 *old = &displaybuf[bank*XSIZE];
+	scrnsz_t min = 0, max = XSIZE - 1;
+	while(min < XSIZE && old[min] == newdata[min]) ++min;
+	if(min == XSIZE) return;
+	while(old[max] == newdata[max]) --max;
+	mark_dirty(bank, min, max);
+}
+
+/*
+ * memmove by DMA (mem2mem, 32-bit words): data moves to lower addresses, so
+ * forward copying is safe for overlapping buffers; in mem2mem mode data goes from CPAR to CMAR
+ */
+static void dma_memmove(U8 *dst, const U8 *src, bufsz_t len){
+	rcc_periph_clock_enable(RCC_DMA1);
+	DMA1_CCR(MEMMOVE_CHANNEL) = 0;
+	dma_clear_interrupt_flags(DMA1, MEMMOVE_CHANNEL, DMA_GIF | DMA_TCIF | DMA_HTIF | DMA_TEIF);
+	DMA1_CPAR(MEMMOVE_CHANNEL) = (uint32_t) src;
+	DMA1_CMAR(MEMMOVE_CHANNEL) = (uint32_t) dst;
+	DMA1_CNDTR(MEMMOVE_CHANNEL) = len / 4;
+	DMA1_CCR(MEMMOVE_CHANNEL) = DMA_CCR_MEM2MEM | DMA_CCR_MINC | DMA_CCR_PINC |
+		DMA_CCR_PSIZE_32BIT | DMA_CCR_MSIZE_32BIT | DMA_CCR_PL_LOW | DMA_CCR_EN;
+	while(!dma_get_interrupt_flag(DMA1, MEMMOVE_CHANNEL, DMA_TCIF | DMA_TEIF));
+	DMA1_CCR(MEMMOVE_CHANNEL) = 0;
+}
+
 /**
  * roll screen by 1 line up
+ * only columns, which content really changed, are sent
  */
 void pcd8544_roll_screen(){
+	static const U8 empty[XSIZE] = {0};
 	bufsz_t idx = DISPLAYBUFSIZE-XSIZE;
-	memmove(displaybuf, displaybuf + XSIZE, idx);
+	scrnsz_t i;
+	pcd8544_wait();
+	for(i = 0; i < YCHARSZ - 1; ++i)
+		mark_changes(i, &displaybuf[(i+1)*XSIZE]);
+	mark_changes(YCHARSZ - 1, empty);
+	dma_memmove(displaybuf, displaybuf + XSIZE, idx);
 	memset(displaybuf+idx, 0, XSIZE);
 	pcd8544_refresh();
 	if(cur_y) --cur_y;
@@ -38,6 +38,10 @@ typedef U16 bufsz_t;
 
 extern const scrnsz_t LTRS_IN_ROW;
 extern const scrnsz_t ROW_MAX;
+extern volatile U8 pcd8544_refreshed;
+
+// DMA1 channel for framebuffer memmove (SPI1 TX uses 3, SPI2 TX - 5)
+#define MEMMOVE_CHANNEL  (DMA_CHANNEL1)
 
 #define bad_coords(x, y)            (!(x < XSIZE && y < YSIZE))
 #define bad_text_coords(col, row)   (!(col < LTRS_IN_ROW && row < ROW_MAX))
@@ -56,8 +60,11 @@ void pcd8544_init();
 void pcd8544_send_byte(U8 byte, U8 cmd);
 void pcd8544_send_data(U8 *data, bufsz_t size, U8 cmd);
 void draw_pixel(scrnsz_t x, scrnsz_t y, U8 set);
+void mark_dirty(scrnsz_t bank, scrnsz_t xmin, scrnsz_t xmax);
 void pcd8544_cls();
 void pcd8544_refresh();
+void pcd8544_refresh_all();
+void pcd8544_wait();
 int  pcd8544_put(U8 koi8, scrnsz_t x, scrnsz_t y);
 U8 *pcd8544_print(U8 *koi8);
 U8 pcd8544_putch(U8 koi8);
@@ -24,6 +24,13 @@
 #include "hw_init.h"
 
 uint32_t Current_SPI = SPI1; // this is SPI interface which would b
+// function to call when DMA transfer is over
+static void (*dma_done)() = NULL;
+
+// DMA1 channel for TX of current SPI: SPI1 - channel 3, SPI2 - channel 5
+static uint8_t tx_channel(){
+	return (Current_SPI == SPI1) ? DMA_CHANNEL3 : DMA_CHANNEL5;
+}
 /**
  * Set current SPI to given value
  */
@@ -98,6 +105,19 @@ void SPI2_init(){
 	spi_enable(Current_SPI);
 }
 
+// setup TX DMA channel of current SPI
+static void SPI_DMA_init(){
+	uint8_t ch = tx_channel();
+	rcc_periph_clock_enable(RCC_DMA1);
+	dma_channel_reset(DMA1, ch);
+	// memory -> SPI_DR, 8 bits, memory increment, transfer complete interrupt
+	DMA_CCR(DMA1, ch) = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_PSIZE_8BIT | DMA_CCR_MSIZE_8BIT
+			| DMA_CCR_TCIE | DMA_CCR_PL_MEDIUM;
+	DMA_CPAR(DMA1, ch) = (uint32_t) &SPI_DR(Current_SPI);
+	SPI_CR2(Current_SPI) |= SPI_CR2_TXDMAEN;
+	nvic_enable_irq((ch == DMA_CHANNEL3) ? NVIC_DMA1_CHANNEL3_IRQ : NVIC_DMA1_CHANNEL5_IRQ);
+}
+
 void SPI_init(){
 	switch(Current_SPI){
 		case SPI1:
@@ -109,6 +129,7 @@ void SPI_init(){
 		default:
 		return; // error
 	}
+	SPI_DMA_init();
 }
 
 /**
@@ -146,6 +167,51 @@ uint8_t spiWrite(uint8_t *data, uint16_t len){
 	return 1;
 }
 
+/**
+ * Write data to current SPI through DMA (non-blocking)
+ * @param data   - buffer with data (shouldn't be changed until transfer ends)
+ * @param len    - buffer length
+ * @param ondone - function to call (from interrupt) when all data is sent or NULL
+ * @return 0 if previous transfer isn't over yet
+ */
+uint8_t spiWriteDMA(uint8_t *data, uint16_t len, void (*ondone)()){
+	uint8_t ch = tx_channel();
+	if(!len || spi_dma_busy()) return 0;
+	dma_done = ondone;
+	dma_clear_interrupt_flags(DMA1, ch, DMA_GIF | DMA_TCIF | DMA_HTIF | DMA_TEIF);
+	DMA_CMAR(DMA1, ch) = (uint32_t) data;
+	DMA_CNDTR(DMA1, ch) = len;
+	DMA_CCR(DMA1, ch) |= DMA_CCR_EN;
+	return 1;
+}
+
+/**
+ * @return 1 if DMA transfer is in progress
+ */
+uint8_t spi_dma_busy(){
+	return (DMA_CCR(DMA1, tx_channel()) & DMA_CCR_EN) ? 1 : 0;
+}
+
+// DMA TX is over: wait for last byte & clear RX (we don't read it)
+static void dma_tx_isr(uint8_t ch){
+	if(!dma_get_interrupt_flag(DMA1, ch, DMA_TCIF)) return;
+	dma_clear_interrupt_flags(DMA1, ch, DMA_GIF | DMA_TCIF);
+	while(!(SPI_SR(Current_SPI) & SPI_SR_TXE));
+	while(SPI_SR(Current_SPI) & SPI_SR_BSY);
+	(void)SPI_DR(Current_SPI);
+	(void)SPI_SR(Current_SPI); // clear OVR
+	DMA_CCR(DMA1, ch) &= ~DMA_CCR_EN;
+	if(dma_done) dma_done();
+}
+
+void dma1_channel3_isr(){
+	dma_tx_isr(DMA_CHANNEL3);
+}
+
+void dma1_channel5_isr(){
+	dma_tx_isr(DMA_CHANNEL5);
+}
+
 /*
 // SPI interrupt
 void spi_isr(uint32_t spi){
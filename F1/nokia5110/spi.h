@@ -27,6 +27,8 @@ void SPI_init();
 uint8_t spiWrite(uint8_t *data, uint16_t len);
 extern uint32_t Current_SPI;
 uint8_t spi_write_byte(uint8_t data);
+uint8_t spiWriteDMA(uint8_t *data, uint16_t len, void (*ondone)());
+uint8_t spi_dma_busy();
 
 void switch_SPI(uint32_t SPI);
 
@@ -51,9 +51,12 @@ int main(){
 
 	usb_connect(); // turn on USB
 
-	uint32_t oldL = 0;
+	start_ultrasonic();
+
+	uint32_t oldL[US_NSENSORS] = {0};
 	while(1){
 		uint32_t L;
+		uint8_t N;
 		usbd_poll(usbd_dev);
 		if(usbdatalen){ // there's something in USB buffer
 			usbdatalen = parse_incoming_buf(usbdatabuf, usbdatalen);
@@ -64,27 +67,32 @@ int main(){
 			P(" ADU\n");
 			AWD_flag = 0;
 		}
-		if(ultrasonic_get(&L)){
-			if(!cont){
-				P("Measured length: ");
+		for(N = 0; N < US_NSENSORS; ++N){
+			if(!ultrasonic_get(N, &L)) continue;
+			if(show_dist & (1 << N)){
+				show_dist &= ~(1 << N);
+				P("Sensor ");
+				print_int(N);
+				P(", measured length: ");
 				print_int(L);
 				P("mm\n");
-				oldL = 0;
+			}
+			if(!cont){
+				oldL[N] = 0;
+			}else if(!oldL[N]){
+				oldL[N] = L;
 			}else{
-				if(!oldL){
-					oldL = L;
-				}else{
-					uint32_t diff = (oldL > L) ? oldL - L : L - oldL;
-					if(diff > MAX_LEN_DIFF){
-						P("Pass! Was: ");
-						print_int(oldL);
-						P(", become: ");
-						print_int(L);
-						P("!!!\n");
-						oldL = L;
-					}
+				uint32_t diff = (oldL[N] > L) ? oldL[N] - L : L - oldL[N];
+				if(diff > MAX_LEN_DIFF){
+					P("Pass (sensor ");
+					print_int(N);
+					P(")! Was: ");
+					print_int(oldL[N]);
+					P(", become: ");
+					print_int(L);
+					P("!!!\n");
+					oldL[N] = L;
 				}
-				start_ultrasonic();
 			}
 		}
 		if(Timer - Old_timer > 999){ // one-second cycle
@@ -25,27 +25,85 @@
 int AWD_flag = 0;
 uint16_t AWD_value = 0;
 
+/*
+ * ADC1 converts PA0 continuously (47.6ksps), DMA1 channel 1 stores samples into
+ * circular buffer. On each half/complete interrupt SHARP_OVERSAMPLE samples are
+ * summed and decimated into one 16-bit value (~186 values per second: 47.6k/256).
+ * When there's nothing in front of sensor, DMA interrupts are turned off and only
+ * analog watchdog waits for something to appear.
+ */
+static uint16_t adc_buf[SHARP_BUFLEN];
+static volatile uint16_t sharp_raw = 0;   // last oversampled value
+static volatile uint8_t sharp_fresh = 0;  // new value arrived
+static volatile uint8_t active = 0;       // DMA processing is on
+static uint16_t idle_cnt = 0;
+
+/*
+ * Distance (mm) for values 0, 1024, 2048, ..., 65536 (16-bit ADC value)
+ * GP2Y0A02: L = 603.74 * V^(-1.16), V = value * 3.3 / 65536, limited by sensor range
+ */
+static const uint16_t sharp_lut[65] = {
+	1500, 1500, 1500, 1500, 1500, 1500, 1500, 1500, 1500, 1471, 1302, 1166, 1054,
+	 960,  881,  813,  755,  703,  658,  618,  583,  551,  522,  495,  472,  450,
+	 430,  411,  394,  379,  364,  350,  338,  326,  315,  304,  295,  285,  277,
+	 268,  261,  253,  246,  240,  233,  227,  222,  216,  211,  206,  201,  200,
+	 200,  200,  200,  200,  200,  200,  200,  200,  200,  200,  200,  200,  200
+};
+
+// convert oversampled value into distance: linear interpolation in LUT
+static uint32_t raw2mm(uint16_t v){
+	uint16_t i = v >> 10;
+	int32_t a = sharp_lut[i], b = sharp_lut[i + 1];
+	return a + ((b - a) * (int32_t)(v & 0x3ff)) / 1024;
+}
+
+// analog watchdog waits for value higher than ADC_WDG_LOW
+static void go_sleep(){
+	nvic_disable_irq(NVIC_DMA1_CHANNEL1_IRQ);
+	active = 0;
+	ADC1_HTR = ADC_WDG_LOW;
+	ADC1_LTR = 0;
+	ADC1_SR = 0;
+	ADC1_CR1 |= ADC_CR1_AWDIE;
+}
+
+// turn on processing of DMA data
+static void wake_up(){
+	ADC1_CR1 &= ~ADC_CR1_AWDIE;
+	idle_cnt = 0;
+	active = 1;
+	DMA1_IFCR = DMA_IFCR_CGIF1;
+	nvic_enable_irq(NVIC_DMA1_CHANNEL1_IRQ);
+}
+
 void init_sharp_sensor(){
 	// Make sure the ADC doesn't run during config
 	adc_off(ADC1);
-	// enable ADC & PA0 clocking
+	// enable ADC, DMA & PA0 clocking
 	rcc_peripheral_enable_clock(&RCC_APB2ENR, RCC_APB2ENR_ADC1EN | RCC_APB2ENR_IOPAEN);
-	rcc_set_adcpre(RCC_CFGR_ADCPRE_PCLK2_DIV4);
+	rcc_periph_clock_enable(RCC_DMA1);
+	// 72/6 = 12MHz (ADC clock shouldn't be greater than 14MHz)
+	rcc_set_adcpre(RCC_CFGR_ADCPRE_PCLK2_DIV6);
 	gpio_set_mode(GPIOA, GPIO_MODE_INPUT, GPIO_CNF_INPUT_ANALOG, GPIO0);
 	// set sample time: 239.5 cycles for better results
 	ADC1_SMPR2 = 7;
-	// continuous conv, enable
-	ADC1_CR2 = ADC_CR2_CONT | ADC_CR2_ADON;
+	// DMA1 channel 1: ADC1_DR -> adc_buf, circular with half/complete interrupts
+	dma_channel_reset(DMA1, DMA_CHANNEL1);
+	DMA1_CPAR1 = (uint32_t) &ADC1_DR;
+	DMA1_CMAR1 = (uint32_t) adc_buf;
+	DMA1_CNDTR1 = SHARP_BUFLEN;
+	DMA1_CCR1 = DMA_CCR_MINC | DMA_CCR_PSIZE_16BIT | DMA_CCR_MSIZE_16BIT
+		| DMA_CCR_CIRC | DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_EN;
+	// continuous conv with DMA, enable
+	ADC1_CR2 = ADC_CR2_CONT | ADC_CR2_DMA | ADC_CR2_ADON;
 	// reset calibration registers & start calibration
 	ADC1_CR2 |= ADC_CR2_RSTCAL;
 	while(ADC1_CR2 & ADC_CR2_RSTCAL); // wait for registers reset
 	ADC1_CR2 |= ADC_CR2_CAL;
 	while(ADC1_CR2 & ADC_CR2_CAL); // wait for calibration ends
-	// set threshold limits
-	ADC1_HTR = ADC_WDG_HIGH;
-	ADC1_LTR = ADC_WDG_LOW;
-	// enable analog watchdog on single regular channel 0 & enable interrupt
-	ADC1_CR1 = ADC_CR1_AWDEN | ADC_CR1_AWDSGL | ADC_CR1_AWDIE;
+	// enable analog watchdog on single regular channel 0
+	ADC1_CR1 = ADC_CR1_AWDEN | ADC_CR1_AWDSGL;
+	go_sleep();
 	nvic_enable_irq(NVIC_ADC1_2_IRQ);
 	ADC1_CR2 |= ADC_CR2_SWSTART;
 	// start - to do it we need set ADC_CR2_ADON again!
@@ -53,20 +111,60 @@ void init_sharp_sensor(){
 	DBG("ADC started\n");
 }
 
+// analog watchdog: something appeared in front of sensor
 void adc1_2_isr(){
-	AWD_value = ADC1_DR;
-	if(ADC1_SR & ADC_SR_AWD){ // analog watchdog event
+	if(ADC1_SR & ADC_SR_AWD){
+		AWD_value = ADC1_DR;
 		AWD_flag = 1;
-	//	ADC1_CR1 &= ~(ADC_CR1_AWDIE | ADC_CR1_AWDEN);
-	//	nvic_disable_irq(NVIC_ADC1_2_IRQ);
-		if(AWD_value >= ADC_WDG_HIGH){ // high threshold
-			ADC1_HTR = 0x0fff; // remove high threshold, only wait for LOW
-			ADC1_LTR = ADC_WDG_LOW;
-		}else{
-			ADC1_HTR = ADC_WDG_HIGH;
-			ADC1_LTR = 0;
-		}
-		//ADC1_CR1 |= ADC_CR1_AWDIE;
+		wake_up();
 	}
 	ADC1_SR = 0;
 }
+
+// half of buffer is full: oversample it
+void dma1_channel1_isr(){
+	uint16_t *p;
+	uint32_t sum = 0;
+	int i;
+	if(DMA1_ISR & DMA_ISR_HTIF1){
+		DMA1_IFCR = DMA_IFCR_CHTIF1;
+		p = adc_buf;
+	}else if(DMA1_ISR & DMA_ISR_TCIF1){
+		DMA1_IFCR = DMA_IFCR_CTCIF1;
+		p = &adc_buf[SHARP_OVERSAMPLE];
+	}else return;
+	for(i = 0; i < SHARP_OVERSAMPLE; ++i) sum += p[i];
+	// sum of 4^n samples has 2n extra bits, n of them are noise
+	sharp_raw = sum >> SHARP_EXTRA_BITS;
+	sharp_fresh = 1;
+	if(sharp_raw < (ADC_WDG_LOW << SHARP_EXTRA_BITS)){
+		if(++idle_cnt == SHARP_IDLE_CNT){ // object is gone
+			AWD_value = sharp_raw >> SHARP_EXTRA_BITS;
+			AWD_flag = 1;
+			go_sleep();
+		}
+	}else idle_cnt = 0;
+}
+
+/**
+ * Get last distance measured by sharp sensor
+ * @param L   (o) - distance in mm (SHARP_MAX_MM if nothing in front of sensor)
+ * @param raw (o) - oversampled ADC value (16 bit) or NULL
+ * @return 1 if there's new value since last call
+ */
+int sharp_get(uint32_t *L, uint16_t *raw){
+	uint16_t v;
+	if(!sharp_fresh) return 0;
+	sharp_fresh = 0;
+	v = sharp_raw;
+	if(raw) *raw = v;
+	*L = raw2mm(v);
+	return 1;
+}
+
+/**
+ * @return 1 if sensor sees something & DMA data is processed
+ */
+uint8_t sharp_active(){
+	return active;
+}
@@ -33,6 +33,19 @@ extern uint16_t AWD_value;
 // < 0.6V - nothing in front of sensor
 #define ADC_WDG_LOW    ((uint16_t)750)
 
+// DMA buffer length: two halves of SHARP_OVERSAMPLE samples each
+#define SHARP_BUFLEN       (512)
+// samples summed for one output: 256 = 4^4 gives 4 extra bits (16-bit result)
+#define SHARP_OVERSAMPLE   (SHARP_BUFLEN/2)
+#define SHARP_EXTRA_BITS   (4)
+// go to sleep after this amount of outputs with nothing in front of sensor
+#define SHARP_IDLE_CNT     (50)
+// distance range of GP2Y0A02 (mm)
+#define SHARP_MIN_MM       (200)
+#define SHARP_MAX_MM       (1500)
+
 void init_sharp_sensor();
+int sharp_get(uint32_t *L, uint16_t *raw);
+uint8_t sharp_active();
 
 #endif // __SHARP_H__
@@ -19,147 +19,218 @@
  * MA 02110-1301, USA.
  */
 
+#include <string.h>
 #include <libopencm3/stm32/timer.h>
 #include <libopencm3/stm32/gpio.h>
 #include <libopencm3/stm32/rcc.h>
+#include <libopencm3/stm32/dma.h>
 #include <libopencm3/cm3/nvic.h>
 
 #include "ultrasonic.h"
 #include "user_proto.h"
 
-static usmode US_mode = US_MODE_OFF;
-static int overcapture = 0;
+/*
+ * Ranging engine works without CPU intervention except one interrupt per slot.
+ * TIM3 runs with period US_SLOT, on each slot trigger pulse (TIM3_CH1..3, PA6,
+ * PA7, PB0) is generated for one sensor in turn: its CCR is preloaded in update
+ * interrupt of previous slot.
+ * Echo outputs of sensors are connected to TIM2_CH1..3 (full remap: PA15, PB3,
+ * PB10, five tolerant) and XOR-ed into TI1 (echoes never overlap as slot is longer
+ * than max echo). TIM2 runs free with 1us tick, TIM2_CH1 captures rising edges of
+ * TI1 & TIM2_CH2 - falling, DMA1 channels 5 & 7 store timestamps into circular
+ * rings. At the end of slot its echo is taken from rings.
+ */
+
+static ussensor sensors[US_NSENSORS];
+static uint16_t rise_ring[US_RING_LEN], fall_ring[US_RING_LEN]; // echo edges timestamps
+static uint8_t rise_pos, fall_pos;   // first unprocessed index in rings
+static uint8_t slot_sensor;         // sensor triggered in current slot
+static uint8_t running = 0;
+static uint32_t sound_speed;        // speed of sound, 0.1m/s
 
-#ifndef TIM_CCMR2_CC3S_IN_TI4
-#define TIM_CCMR2_CC3S_IN_TI4		(2)
-#endif
-#ifndef TIM_CCMR2_CC4S_IN_TI4
-#define TIM_CCMR2_CC4S_IN_TI4		(1 << 8)
-#endif
 /**
- * Init timer 2 (&remap channels 3&4 to five-tolerant ports)
+ * Init timers 2 & 3, DMA and pins
  */
 void tim2_init(){
-	// Turn off JTAG & SWD, remap TIM2_CH3/TIM2_CH4 to PB10/PB11 (five tolerant)
+	// Turn off JTAG & SWD, full remap of TIM2 channels to five-tolerant ports
 	// don't forget about AFIO clock & PB clock!
-	rcc_peripheral_enable_clock(&RCC_APB2ENR, RCC_APB2ENR_AFIOEN | RCC_APB2ENR_IOPBEN);
-	gpio_primary_remap(AFIO_MAPR_SWJ_CFG_JTAG_OFF_SW_OFF, AFIO_MAPR_TIM2_REMAP_PARTIAL_REMAP2);
-	// setup PB10 & PB11
-	// PB10 - Trig output - push/pull
-	gpio_set_mode(GPIO_BANK_TIM2_PR2_CH3, GPIO_MODE_OUTPUT_10_MHZ,
-		GPIO_CNF_OUTPUT_ALTFN_PUSHPULL, GPIO_TIM2_PR2_CH3);
-//	gpio_set_mode(GPIO_BANK_TIM2_CH3, GPIO_MODE_OUTPUT_10_MHZ,
-//		GPIO_CNF_OUTPUT_ALTFN_PUSHPULL, GPIO_TIM2_CH3);
-	// PB11 - Echo input - floating
-//	gpio_set_mode(GPIO_BANK_TIM2_PR2_CH4, GPIO_MODE_INPUT,
-//		GPIO_CNF_INPUT_FLOAT, GPIO_TIM2_PR2_CH4);
+	rcc_peripheral_enable_clock(&RCC_APB2ENR, RCC_APB2ENR_AFIOEN | RCC_APB2ENR_IOPAEN | RCC_APB2ENR_IOPBEN);
+	gpio_primary_remap(AFIO_MAPR_SWJ_CFG_JTAG_OFF_SW_OFF, AFIO_MAPR_TIM2_REMAP_FULL_REMAP);
+	// Echo inputs - pulled down (unconnected inputs shouldn't make noise in XOR)
+	gpio_set_mode(GPIO_BANK_TIM2_FR_CH1_ETR, GPIO_MODE_INPUT,
+		GPIO_CNF_INPUT_PULL_UPDOWN, GPIO_TIM2_FR_CH1_ETR);
+	gpio_clear(GPIO_BANK_TIM2_FR_CH1_ETR, GPIO_TIM2_FR_CH1_ETR);
+	gpio_set_mode(GPIO_BANK_TIM2_FR_CH2, GPIO_MODE_INPUT,
+		GPIO_CNF_INPUT_PULL_UPDOWN, GPIO_TIM2_FR_CH2 | GPIO_TIM2_FR_CH3);
+	gpio_clear(GPIO_BANK_TIM2_FR_CH2, GPIO_TIM2_FR_CH2 | GPIO_TIM2_FR_CH3);
+	// Trig outputs - push/pull
+	gpio_set_mode(GPIO_BANK_TIM3_CH1, GPIO_MODE_OUTPUT_10_MHZ,
+		GPIO_CNF_OUTPUT_ALTFN_PUSHPULL, GPIO_TIM3_CH1 | GPIO_TIM3_CH2);
+	gpio_set_mode(GPIO_BANK_TIM3_CH3, GPIO_MODE_OUTPUT_10_MHZ,
+		GPIO_CNF_OUTPUT_ALTFN_PUSHPULL, GPIO_TIM3_CH3);
 	rcc_periph_clock_enable(RCC_TIM2);
-	timer_reset(TIM2);
+	rcc_periph_clock_enable(RCC_TIM3);
+	rcc_periph_clock_enable(RCC_DMA1);
 	// timers have frequency of 1MHz -- 1us for one step
-	// 36MHz of APB1
-	timer_set_mode(TIM2, TIM_CR1_CKD_CK_INT, TIM_CR1_CMS_EDGE, TIM_CR1_DIR_UP);
 	// 72MHz div 72 = 1MHz
+	timer_reset(TIM2);
 	TIM2_PSC = 71;  // prescaler is (div - 1)
-	TIM2_ARR = TRIG_T;
-	TIM2_CCR3 = TRIG_L;
-//	DBG("Timer configured\n");
+	TIM2_ARR = 0xffff;
+	// TI1 is XOR of CH1..CH3 inputs
+	TIM2_CR2 = TIM_CR2_TI1S;
+	// CH1 - direct TI1, CH2 - indirect TI1, filter N=8
+	TIM2_CCMR1 = TIM_CCMR1_CC1S_IN_TI1 | TIM_CCMR1_IC1F_CK_INT_N_8 |
+		TIM_CCMR1_CC2S_IN_TI1 | TIM_CCMR1_IC2F_CK_INT_N_8;
+	// CH1 - rising, CH2 - falling edge
+	TIM2_CCER = TIM_CCER_CC1E | TIM_CCER_CC2P | TIM_CCER_CC2E;
+	TIM2_DIER = TIM_DIER_CC1DE | TIM_DIER_CC2DE;
+	timer_reset(TIM3);
+	TIM3_PSC = 71;
+	TIM3_ARR = US_SLOT - 1;
+	// PWM1 with preload: pulse of CCR length at the beginning of slot
+	TIM3_CCMR1 = TIM_CCMR1_OC1M_PWM1 | TIM_CCMR1_OC1PE | TIM_CCMR1_OC2M_PWM1 | TIM_CCMR1_OC2PE;
+	TIM3_CCMR2 = TIM_CCMR2_OC3M_PWM1 | TIM_CCMR2_OC3PE;
+	TIM3_CCER = TIM_CCER_CC1E | TIM_CCER_CC2E | TIM_CCER_CC3E;
+	TIM3_CR1 = TIM_CR1_ARPE;
+	ultrasonic_set_temp(US_DEFAULT_TEMP);
+}
+
+// preload trigger pulse of sensor N for next slot
+static void set_trig(uint8_t N){
+	TIM3_CCR1 = (N == 0) ? TRIG_L : 0;
+	TIM3_CCR2 = (N == 1) ? TRIG_L : 0;
+	TIM3_CCR3 = (N == 2) ? TRIG_L : 0;
+}
+
+// setup circular DMA channel from timer's CCR into ring
+static void ring_dma(uint8_t ch, volatile uint32_t *ccr, uint16_t *ring){
+	dma_channel_reset(DMA1, ch);
+	DMA1_CPAR(ch) = (uint32_t) ccr;
+	DMA1_CMAR(ch) = (uint32_t) ring;
+	DMA1_CNDTR(ch) = US_RING_LEN;
+	DMA1_CCR(ch) = DMA_CCR_MINC | DMA_CCR_PSIZE_16BIT | DMA_CCR_MSIZE_16BIT
+		| DMA_CCR_CIRC | DMA_CCR_PL_HIGH | DMA_CCR_EN;
 }
 
 /**
- * Send Trig signal
- * return 0 if another measurement still in process
+ * Start continuous ranging
+ * return 0 if it is already running
  */
 int start_ultrasonic(){
-	if(US_mode != US_MODE_OFF && US_mode != US_MODE_READY) return 0;
-	overcapture = 0;
-	TIM2_CR1 = 0;
-	//TIM2_CR1 = TIM_CR1_URS; // Turn off timer to reconfigure, dusable UEV by UG set
-	TIM2_CCER = 0;
-	TIM2_CCMR2 = 0;
-	TIM2_DIER = 0;
-	TIM2_SR = 0; // clear all flags
-	TIM2_ARR = TRIG_T;
-	TIM2_CCR3 = TRIG_L;
-	// PWM_OUT for TIM2_CH3
-	TIM2_CCMR2 = TIM_CCMR2_CC3S_OUT | TIM_CCMR2_OC3M_PWM1;
-	// start measurement, active is high
-	TIM2_CCER = TIM_CCER_CC3E;
-	// enable CC3 IRQ
-	TIM2_DIER = TIM_DIER_CC3IE;
-	nvic_enable_irq(NVIC_TIM2_IRQ);
-	US_mode = US_MODE_TRIG;
-	// start timer in one-pulse mode without update event
-	TIM2_CR1 = TIM_CR1_OPM | TIM_CR1_CEN | TIM_CR1_UDIS;
+	int i;
+	if(running) return 0;
+	for(i = 0; i < US_NSENSORS; ++i){
+		sensors[i].idx = 0;
+		sensors[i].fresh = 0;
+		sensors[i].errors = 0;
+		memset(sensors[i].echo, 0, sizeof(sensors[i].echo));
+	}
+	rise_pos = fall_pos = 0;
+	ring_dma(DMA_CHANNEL5, &TIM2_CCR1, rise_ring);
+	ring_dma(DMA_CHANNEL7, &TIM2_CCR2, fall_ring);
+	TIM2_SR = 0;
+	TIM2_CR1 = TIM_CR1_CEN;
+	slot_sensor = 0;
+	set_trig(0);
+	TIM3_CNT = 0;
+	TIM3_EGR = TIM_EGR_UG; // load CCR values of first slot
+	set_trig(US_NSENSORS > 1 ? 1 : 0);
+	TIM3_SR = 0;
+	TIM3_DIER = TIM_DIER_UIE;
+	nvic_enable_irq(NVIC_TIM3_IRQ);
+	running = 1;
+	TIM3_CR1 |= TIM_CR1_CEN;
 	return 1;
 }
 
 /**
- * Start measurement:
- * TIM2_CH3 will capture high level & TIM2_CH4 will capture low
- * The timer configured to 65536us to detect signal lost
+ * Stop ranging
  */
-inline void run_measrmnt(){
-	US_mode = US_MODE_WAIT;
-	TIM2_CR1 = 0; // Turn off timer to reconfigure
-	TIM2_DIER = 0;
-	TIM2_CCER = 0;
-	TIM2_CCMR2 = 0;
-	//DBG("triggered\n");
-	TIM2_SR = 0; // clear all flags
-	TIM2_ARR = MAX_MSRMNT_LEN;
-	// TIM2_CH3 & TIM2_CH4 configured as inputs, TIM2_CH3 connected to CH4
-	TIM2_CCMR2 = TIM_CCMR2_CC3S_IN_TI4 | TIM_CCMR2_CC4S_IN_TI4;
-	// start
-	TIM2_CCER = TIM_CCER_CC4P | TIM_CCER_CC4E | TIM_CCER_CC3E;
-	// enable interrupts CH3, CH4 & update
-	TIM2_DIER = TIM_DIER_CC3IE | TIM_DIER_CC4IE | TIM_DIER_UIE;
-	// start timer in one-pulse mode
-	TIM2_CR1 = TIM_CR1_OPM | TIM_CR1_CEN;
+void stop_ultrasonic(){
+	TIM3_CR1 &= ~TIM_CR1_CEN;
+	TIM3_DIER = 0;
+	nvic_disable_irq(NVIC_TIM3_IRQ);
+	TIM2_CR1 = 0;
+	DMA1_CCR5 &= ~DMA_CCR_EN;
+	DMA1_CCR7 &= ~DMA_CCR_EN;
+	running = 0;
 }
 
-void tim2_isr(){
-	// No signal
-	if(TIM2_SR & TIM_SR_UIF){ // update interrupt
-		TIM2_SR = 0;
-		overcapture = 1;
-		nvic_disable_irq(NVIC_TIM2_IRQ);
-		TIM2_DIER = 0;
-		US_mode = US_MODE_READY;
-		DBG("overcaptured\n");
-	}
-	// end of Trig pulse or start of measurements
-	if(TIM2_SR & TIM_SR_CC3IF){ // CCR ch3 interrupt
-		if(US_mode == US_MODE_TRIG){ // triggered - run measurement
-			run_measrmnt();
-		}else if(US_mode == US_MODE_WAIT){
-			US_mode = US_MODE_MEASUREMENT;
-		}
-		TIM2_SR &= ~TIM_SR_CC3IF;
-	}
-	if(TIM2_SR & TIM_SR_CC4IF){
-		if(US_mode == US_MODE_MEASUREMENT){
-			US_mode = US_MODE_READY;
-			nvic_disable_irq(NVIC_TIM2_IRQ);
-			TIM2_DIER = 0;
-			TIM2_CR1 = 0; // turn off timer - we don't need it more
-		}
-		TIM2_SR &= ~TIM_SR_CC3IF;
+// amount of new values in ring & new position
+static uint8_t ring_new(uint8_t ch, uint8_t *pos){
+	uint8_t cur = US_RING_LEN - DMA1_CNDTR(ch), n;
+	if(cur == US_RING_LEN) cur = 0;
+	n = (cur + US_RING_LEN - *pos) % US_RING_LEN;
+	*pos = cur;
+	return n;
+}
+
+// slot of sensor N ended: its echo (if any) is in rings
+static void slot_done(uint8_t N){
+	uint8_t r0 = rise_pos, f0 = fall_pos;
+	uint8_t nr = ring_new(DMA_CHANNEL5, &rise_pos);
+	uint8_t nf = ring_new(DMA_CHANNEL7, &fall_pos);
+	uint16_t len = 0;
+	ussensor *s = &sensors[N];
+	// one pulse should be captured, anything else is noise or missed edge
+	if(nr == 1 && nf == 1){
+		len = fall_ring[f0] - rise_ring[r0]; // 16-bit difference takes into account overflow
+		if(len > US_MAX_ECHO) len = 0;
+	}else ++s->errors;
+	s->echo[s->idx] = len;
+	if(++s->idx == US_MEDIAN_LEN) s->idx = 0;
+	s->fresh = 1;
+}
+
+void tim3_isr(){
+	if(TIM3_SR & TIM_SR_UIF){ // new slot started
+		TIM3_SR = ~TIM_SR_UIF;
+		slot_done(slot_sensor);
+		// trigger of this slot was preloaded before
+		if(++slot_sensor == US_NSENSORS) slot_sensor = 0;
+		set_trig((slot_sensor + 1) % US_NSENSORS);
 	}
 }
 
 /**
- * Measure distance
- * return 1 if measurements done
- * set L to distance (in mm) or 0 in case of overcapture (no signal)
+ * Set air temperature for speed of sound calculation
+ * @param T - temperature in 1/10 degC
  */
-int ultrasonic_get(uint32_t *L){
-	uint32_t D;
-	if(US_mode != US_MODE_READY)
-		return 0;
-	US_mode = US_MODE_OFF;
-	if(!overcapture){
-		D = ((uint32_t)(TIM2_CCR4 - TIM2_CCR3)) * 170;
-		*L = D / 1000;
-	}else *L = 0;
+void ultrasonic_set_temp(int32_t T){
+	// c = 331.3 + 0.606*T m/s
+	sound_speed = 3313 + (606 * T) / 1000;
+}
+
+/**
+ * Get distance measured by sensor N (median of last US_MEDIAN_LEN echoes)
+ * return 1 if there was new measurement since last call
+ * set L to distance (in mm) or 0 if there's no object in range
+ */
+int ultrasonic_get(uint8_t N, uint32_t *L){
+	uint16_t v[US_MEDIAN_LEN], t;
+	int i, j;
+	ussensor *s;
+	if(N >= US_NSENSORS) return 0;
+	s = &sensors[N];
+	if(!s->fresh) return 0;
+	s->fresh = 0;
+	// insertion sort, absent echo is the largest value
+	for(i = 0; i < US_MEDIAN_LEN; ++i){
+		t = s->echo[i] ? s->echo[i] : 0xffff;
+		for(j = i; j > 0 && v[j-1] > t; --j) v[j] = v[j-1];
+		v[j] = t;
+	}
+	t = v[US_MEDIAN_LEN / 2];
+	// L = t(us) * c(0.1m/s) / 2 / 10000
+	if(t == 0xffff) *L = 0;
+	else *L = ((uint32_t)t * sound_speed) / 20000;
 	return 1;
 }
+
+/**
+ * return amount of bad echoes of sensor N
+ */
+uint32_t ultrasonic_errors(uint8_t N){
+	if(N >= US_NSENSORS) return 0;
+	return sensors[N].errors;
+}
@@ -25,25 +25,36 @@
 
 #include <stdint.h>
 
-void tim2_init();
-int start_ultrasonic();
-int ultrasonic_get(uint32_t *L);
-
+// amount of HC-SR04 sensors (1..3)
+#define US_NSENSORS     (3)
+// length of trigger pulse - 10us
+#define TRIG_L          (10)
+// sensor triggering period (us): 60ms by datasheet, but not less than 40ms per
+// sensor as echo of one sensor shouldn't overlap with echo of another
+#define US_SLOT_MIN     (40000)
+#define US_SLOT         ((60000/US_NSENSORS > US_SLOT_MIN) ? 60000/US_NSENSORS : US_SLOT_MIN)
+// max echo length (us): longer pulses mean that there's no object in range
+#define US_MAX_ECHO     (30000)
+// length of DMA rings of echo edges timestamps
+#define US_RING_LEN     (8)
+// length of median filter (odd)
+#define US_MEDIAN_LEN   (5)
+// default air temperature, 1/10 degC
+#define US_DEFAULT_TEMP (200)
 
-// Sensor mode
-typedef enum{
-	 US_MODE_OFF         // sensor is off
-	,US_MODE_TRIG        // sensor triggered
-	,US_MODE_WAIT        // wait for pulse
-	,US_MODE_MEASUREMENT // measurement in process
-	,US_MODE_READY       // measurements done
-} usmode;
+// sensor data
+typedef struct{
+	uint16_t echo[US_MEDIAN_LEN]; // last echo lengths (us), 0 - no echo
+	uint8_t idx;                  // current index in `echo`
+	uint8_t fresh;                // new value arrived after last reading
+	uint32_t errors;              // amount of bad echoes
+} ussensor;
 
-// trigger time: after trigger event ends, timer will be configured for capture - 20us
-#define TRIG_T     (200)
-// trigger length - 10us
-#define TRIG_L     (10)
-// max length of measurement (to detect signal absence)
-#define MAX_MSRMNT_LEN  (65535)
+void tim2_init();
+int start_ultrasonic();
+void stop_ultrasonic();
+int ultrasonic_get(uint8_t N, uint32_t *L);
+void ultrasonic_set_temp(int32_t T);
+uint32_t ultrasonic_errors(uint8_t N);
 
 #endif // __ULTRASONIC_H__
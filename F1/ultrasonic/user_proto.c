@@ -32,6 +32,7 @@ enum{
 	UVAL_BAD		// entered bad value
 };
 uint8_t Uval_ready = UVAL_BAD, cont = 0;
+uint8_t show_dist = 0; // bit N set - show next distance of Nth sensor
 
 int read_int(char *buf, int cnt);
 
@@ -40,12 +41,59 @@ intfun I = NULL; // function to process entered integer
 #define READINT() do{i += read_int(&buf[i+1], len-i-1);}while(0)
 
 void help(){
-	P("A\tshow ADC value\n");
+	P("A\tshow sharp sensor value\n");
 	P("H\tshow this help\n");
-	P("D\tmeasure distance\n");
+	P("C\tset air temperature (1/10 degC)\n");
+	P("D\tshow distances\n");
+	P("E\tshow amount of bad echoes\n");
 	P("I\tinit sharp\n");
 	P("T\tshow timer value\n");
-	P("S\tstart/stop continuous measurement\n");
+	P("S\tstart/stop transits detection\n");
+}
+
+/**
+ * set air temperature for sound speed calculation
+ */
+static uint8_t set_temp(int32_t v){
+	ultrasonic_set_temp(v);
+	newline();
+	return 0;
+}
+
+/**
+ * show oversampled ADC value & distance by sharp sensor
+ */
+static void show_sharp(){
+	uint32_t L;
+	uint16_t raw;
+	newline();
+	if(!sharp_active()){
+		P("Nothing in front of sensor\n");
+		return;
+	}
+	if(!sharp_get(&L, &raw)){
+		P("No data\n");
+		return;
+	}
+	P("ADC: ");
+	print_int(raw);
+	P("/65536, L=");
+	print_int(L);
+	P("mm\n");
+}
+
+/**
+ * show amount of bad echoes of all sensors
+ */
+static void show_errors(){
+	uint8_t N;
+	newline();
+	for(N = 0; N < US_NSENSORS; ++N){
+		print_int(N);
+		P(": ");
+		print_int(ultrasonic_errors(N));
+		newline();
+	}
 }
 
 /**
@@ -80,13 +128,17 @@ int parse_incoming_buf(char *buf, int len){
 		if(!command) continue; // omit zero
 		switch (command){
 			case 'A':
-				P("ADC: ");
-				print_int(ADC1_DR);
-				P("ADU\n");
+				show_sharp();
+			break;
+			case 'C':
+				I = set_temp;
+				READINT();
 			break;
 			case 'D':
-				if(!start_ultrasonic())
-					P("Can't start: another measurement is in process!\n");
+				show_dist = (1 << US_NSENSORS) - 1;
+			break;
+			case 'E':
+				show_errors();
 			break;
 			case 'H': // show help
 				help();
@@ -96,7 +148,6 @@ int parse_incoming_buf(char *buf, int len){
 			break;
 			case 'S':
 				cont = !cont;
-				if(cont) start_ultrasonic();
 			break;
 			case 'T':
 				newline();
@@ -34,7 +34,7 @@
 	#define DBG(a)
 #endif
 
-extern uint8_t cont;
+extern uint8_t cont, show_dist;
 
 typedef uint8_t (*intfun)(int32_t);
 